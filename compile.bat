@@ -1,5 +1,7 @@
 @echo off
-g++ -std=c++17 -o rts-pathfinding src/main.cpp src/Map.cpp src/JsonParser.cpp src/Pathfinding.cpp src/MultiUnitCoordinator.cpp -I./src
+g++ -std=c++17 -o rts-pathfinding src/main.cpp src/Map.cpp src/ConnectivityIndex.cpp src/BinaryMap.cpp src/JsonParser.cpp src/JsonWriter.cpp src/MappedFile.cpp src/Pathfinding.cpp src/LandmarkTable.cpp src/DStarLite.cpp src/SearchContext.cpp src/Statistics.cpp src/Logger.cpp src/JumpPointSearch.cpp src/HierarchicalPathfinder.cpp src/ChunkedMap.cpp src/Pathfinder.cpp src/PathCache.cpp src/ThreadPool.cpp src/FlowField.cpp src/OccupancyGrid.cpp src/ReservationTable.cpp src/CooperativeAStar.cpp src/ConflictBasedSearch.cpp src/GoalAssignment.cpp src/ResumableSearch.cpp src/PathService.cpp src/PathSmoothing.cpp src/AgentStore.cpp src/MultiUnitCoordinator.cpp -I./src -pthread
+if %errorlevel% equ 0 g++ -std=c++17 -o map-convert src/MapConvert.cpp src/Map.cpp src/ConnectivityIndex.cpp src/BinaryMap.cpp src/JsonParser.cpp src/JsonWriter.cpp src/MappedFile.cpp src/LandmarkTable.cpp src/ChunkedMap.cpp src/Pathfinding.cpp src/SearchContext.cpp src/Statistics.cpp src/Logger.cpp src/ThreadPool.cpp -I./src -pthread
+if %errorlevel% equ 0 g++ -std=c++17 -o rts-bench src/Benchmark.cpp src/MapGenerator.cpp src/Map.cpp src/ConnectivityIndex.cpp src/BinaryMap.cpp src/JsonParser.cpp src/JsonWriter.cpp src/MappedFile.cpp src/Pathfinding.cpp src/LandmarkTable.cpp src/DStarLite.cpp src/SearchContext.cpp src/Statistics.cpp src/Logger.cpp src/JumpPointSearch.cpp src/HierarchicalPathfinder.cpp src/ChunkedMap.cpp src/Pathfinder.cpp src/PathCache.cpp src/ThreadPool.cpp src/FlowField.cpp src/OccupancyGrid.cpp src/ReservationTable.cpp src/CooperativeAStar.cpp src/ConflictBasedSearch.cpp src/GoalAssignment.cpp src/ResumableSearch.cpp src/PathService.cpp src/PathSmoothing.cpp src/AgentStore.cpp src/MultiUnitCoordinator.cpp -I./src -pthread
 if %errorlevel% equ 0 (
     echo Compiled successfully.
 ) else (
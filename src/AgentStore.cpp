@@ -0,0 +1,206 @@
+/******************************************************************************
+ * File:    AgentStore.cpp
+ *
+ * Overview:
+ *   Implementation of the AgentStore class: agent records and the pooled
+ *   path arena.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "AgentStore.h"
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @brief Removes every agent and sets the map width used to pack cells.
+ *
+ * @param mapWidth Number of map columns.
+ */
+void AgentStore::reset(int mapWidth)
+{
+    width = static_cast<uint32_t>(std::max(1, mapWidth));
+    startVals.clear();
+    rows.clear();
+    cols.clear();
+    goalRows.clear();
+    goalCols.clear();
+    pathIndices.clear();
+    pathLengths.clear();
+    pathOffsets.clear();
+    pathCapacities.clear();
+    pathDiagonal.clear();
+    arena.clear();
+    ownedCells = 0;
+}
+
+/**
+ * @brief Adds an agent with no goal and no path.
+ *
+ * @return The new agent's id.
+ */
+int AgentStore::add(double value, int r, int c)
+{
+    startVals.push_back(value);
+    rows.push_back(r);
+    cols.push_back(c);
+    goalRows.push_back(-1);
+    goalCols.push_back(-1);
+    pathIndices.push_back(0);
+    pathLengths.push_back(0);
+    pathOffsets.push_back(0);
+    pathCapacities.push_back(0);
+    pathDiagonal.push_back(0);
+    return static_cast<int>(rows.size() - 1);
+}
+
+/**
+ * @brief Replaces an agent's path.
+ *
+ * The path is written over the agent's current range if it fits, else
+ * appended to the arena.
+ */
+void AgentStore::setPath(size_t id, const Path& path, bool diagonal)
+{
+    const uint32_t length = static_cast<uint32_t>(path.size());
+    if (length > pathCapacities[id]) {
+        ownedCells += length - pathCapacities[id];
+        pathOffsets[id] = static_cast<uint32_t>(arena.size());
+        pathCapacities[id] = length;
+        arena.resize(arena.size() + length);
+    }
+    uint32_t* cells = arena.data() + pathOffsets[id];
+    for (uint32_t k = 0; k < length; ++k) {
+        cells[k] = pack(path[k].first, path[k].second);
+    }
+    pathLengths[id] = length;
+    pathIndices[id] = 0;
+    pathDiagonal[id] = diagonal;
+
+    if (arena.size() > 2 * ownedCells + 1024) {
+        compact();
+    }
+}
+
+/**
+ * @brief Drops an agent's path; its range is kept for the next one.
+ */
+void AgentStore::clearPath(size_t id)
+{
+    pathLengths[id] = 0;
+    pathIndices[id] = 0;
+}
+
+/**
+ * @return The next cell toward the next waypoint.
+ */
+std::pair<int, int> AgentStore::nextCell(size_t id) const
+{
+    const std::pair<int, int> at = position(id);
+    const std::pair<int, int> to = pathCell(id, pathIndices[id] + 1);
+    int rows = std::abs(to.first - at.first);
+    int cols = std::abs(to.second - at.second);
+    if (rows + cols <= 1 || (pathDiagonal[id] && rows <= 1 && cols <= 1)) {
+        return to;
+    }
+    return PathSmoothing::nextOnSegment(pathCell(id, pathIndices[id]), to, at,
+                                        pathDiagonal[id] != 0);
+}
+
+/**
+ * @return Cells the agent's path passes through, waits included.
+ */
+size_t AgentStore::pathCellCount(size_t id) const
+{
+    if (pathLengths[id] == 0) {
+        return 0;
+    }
+    size_t cells = 1;
+    for (uint32_t k = 1; k < pathLengths[id]; ++k) {
+        cells += std::max<size_t>(1, PathSmoothing::segmentSteps(pathCell(id, k - 1),
+                                                                 pathCell(id, k),
+                                                                 pathDiagonal[id] != 0));
+    }
+    return cells;
+}
+
+/**
+ * @return The agent's path, cell by cell.
+ */
+AgentStore::Path AgentStore::path(size_t id) const
+{
+    Path waypoints;
+    waypoints.reserve(pathLengths[id]);
+    for (uint32_t k = 0; k < pathLengths[id]; ++k) {
+        waypoints.push_back(pathCell(id, k));
+    }
+    return PathSmoothing::expand(waypoints, pathDiagonal[id] != 0);
+}
+
+/**
+ * @return The cells the agent still has to walk, after its current one.
+ */
+AgentStore::Path AgentStore::remainingPath(size_t id) const
+{
+    Path waypoints{position(id)};
+    for (size_t k = pathIndices[id] + 1; k < pathLengths[id]; ++k) {
+        waypoints.push_back(pathCell(id, k));
+    }
+    if (pathLengths[id] == 0 || waypoints.size() == 1) {
+        return Path();
+    }
+    // The agent stands on the segment toward waypoint pathIndex + 1, so the
+    // rest of that segment is the walk from its cell
+    Path cells;
+    const bool diagonal = pathDiagonal[id] != 0;
+    const std::pair<int, int> from = pathCell(id, pathIndices[id]);
+    std::pair<int, int> cell = waypoints[0];
+    if (cell == waypoints[1]) {
+        cells.push_back(cell);  // A wait
+    }
+    while (cell != waypoints[1]) {
+        cell = PathSmoothing::nextOnSegment(from, waypoints[1], cell, diagonal);
+        cells.push_back(cell);
+    }
+    waypoints.erase(waypoints.begin());
+    Path rest = PathSmoothing::expand(waypoints, diagonal);
+    cells.insert(cells.end(), rest.begin() + 1, rest.end());
+    return cells;
+}
+
+/**
+ * @return True if no agent has path cells left to walk.
+ *
+ * Branch-free over the two progress arrays, so the compiler can vectorize it.
+ */
+bool AgentStore::allPathsFinished() const
+{
+    const uint32_t* indices = pathIndices.data();
+    const uint32_t* lengths = pathLengths.data();
+    uint32_t travelling = 0;
+    for (size_t i = 0; i < pathLengths.size(); ++i) {
+        travelling |= static_cast<uint32_t>(indices[i] + 1 < lengths[i]);
+    }
+    return travelling == 0;
+}
+
+/**
+ * @brief Rewrites the arena with the live paths only, in agent order.
+ *
+ * Ranges shrink to their path's length; agents without a path give up
+ * their range.
+ */
+void AgentStore::compact()
+{
+    std::vector<uint32_t> packed;
+    packed.reserve(arena.size() / 2);
+    for (size_t id = 0; id < pathLengths.size(); ++id) {
+        const uint32_t* cells = arena.data() + pathOffsets[id];
+        pathOffsets[id] = static_cast<uint32_t>(packed.size());
+        pathCapacities[id] = pathLengths[id];
+        packed.insert(packed.end(), cells, cells + pathLengths[id]);
+    }
+    arena.swap(packed);
+    ownedCells = arena.size();
+}
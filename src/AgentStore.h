@@ -0,0 +1,181 @@
+#pragma once
+
+/******************************************************************************
+ * File:    AgentStore.h
+ *
+ * Overview:
+ *   This header declares the AgentStore class, the agents of a
+ *   MultiUnitCoordinator in structure-of-arrays form.
+ *
+ *   Positions, goals and path progress live in separate contiguous arrays,
+ *   so the per-tick loops of step() and allArrived() stream through only
+ *   the fields they read. Paths do not own heap blocks: every agent's path
+ *   is a range of one shared arena of packed cell indices (r * width + c,
+ *   as uint32), 4 bytes per cell instead of 8 and no allocation per agent.
+ *
+ *   Replacing a path reuses its range when the new path fits; otherwise the
+ *   path is appended and the old range becomes garbage, which is reclaimed
+ *   by compacting the arena once it is more than half garbage.
+ *
+ *   A stored path is a list of waypoints. Per-cell paths are simply
+ *   waypoints one move apart; smoothed paths (see PathSmoothing) have
+ *   longer segments, which nextCell() walks one cell at a time.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "PathSmoothing.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class AgentStore
+ *
+ * @brief Structure-of-arrays agent container with a pooled path arena.
+ *
+ * Agent ids are indices in insertion order (the detection order of
+ * MultiUnitCoordinator::findStartsAndGoals()).
+ */
+class AgentStore {
+public:
+    using Path = std::vector<std::pair<int, int>>;
+
+    /**
+     * @brief Removes every agent and sets the map width used to pack cells.
+     */
+    void reset(int mapWidth);
+
+    /**
+     * @brief Adds an agent at (row, col) with no goal and no path.
+     *
+     * @return Its id.
+     */
+    int add(double startVal, int row, int col);
+
+    size_t size() const { return rows.size(); }
+    bool empty() const { return rows.empty(); }
+
+    double startVal(size_t id) const { return startVals[id]; }
+    int row(size_t id) const { return rows[id]; }
+    int col(size_t id) const { return cols[id]; }
+    std::pair<int, int> position(size_t id) const { return {rows[id], cols[id]}; }
+    void setPosition(size_t id, int r, int c) { rows[id] = r; cols[id] = c; }
+
+    int goalRow(size_t id) const { return goalRows[id]; }
+    int goalCol(size_t id) const { return goalCols[id]; }
+    bool hasGoal(size_t id) const { return goalRows[id] >= 0 && goalCols[id] >= 0; }
+
+    /**
+     * @brief Sets the goal; (-1, -1) for none.
+     */
+    void setGoal(size_t id, int r, int c) { goalRows[id] = r; goalCols[id] = c; }
+
+    /**
+     * @return Waypoints in the agent's path (0 if it has none).
+     */
+    size_t pathLength(size_t id) const { return pathLengths[id]; }
+    bool hasPath(size_t id) const { return pathLengths[id] != 0; }
+
+    /**
+     * @return Cells the agent's path passes through, waits included.
+     */
+    size_t pathCellCount(size_t id) const;
+
+    /**
+     * @return Index of the waypoint the agent reached last.
+     */
+    size_t pathIndex(size_t id) const { return pathIndices[id]; }
+
+    /**
+     * @return True if the agent has waypoints left to reach.
+     */
+    bool isTravelling(size_t id) const { return pathIndices[id] + 1 < pathLengths[id]; }
+
+    /**
+     * @return Waypoint k of the agent's path. No bounds checks.
+     */
+    std::pair<int, int> pathCell(size_t id, size_t k) const {
+        return unpack(arena[pathOffsets[id] + k]);
+    }
+
+    /**
+     * @return The agent's waypoints as packed cell indices (r * width + c),
+     *         pathLength() of them; e.g. for replication.
+     */
+    const uint32_t* packedPath(size_t id) const { return arena.data() + pathOffsets[id]; }
+
+    /**
+     * @return The next cell to walk to: the next waypoint if it is one move
+     *         away, else the next cell of the segment toward it. Only valid
+     *         while isTravelling().
+     */
+    std::pair<int, int> nextCell(size_t id) const;
+
+    /**
+     * @brief Records one tick of progress after the agent moved to (or
+     *        waited at) nextCell(): the next waypoint counts as reached
+     *        once the agent stands on it.
+     */
+    void advance(size_t id) {
+        if (position(id) == pathCell(id, pathIndices[id] + 1)) {
+            ++pathIndices[id];
+        }
+    }
+
+    /**
+     * @brief Replaces the agent's path and restarts it at index 0.
+     *
+     * @param waypoints Cells of the path, or waypoints of a smoothed one.
+     * @param diagonal  True if segments are walked 8-way.
+     */
+    void setPath(size_t id, const Path& waypoints, bool diagonal = false);
+
+    /**
+     * @brief Drops the agent's path.
+     */
+    void clearPath(size_t id);
+
+    /**
+     * @return The agent's path, cell by cell.
+     */
+    Path path(size_t id) const;
+
+    /**
+     * @return The cells the agent still has to walk, after its current one.
+     */
+    Path remainingPath(size_t id) const;
+
+    /**
+     * @return True if no agent has path cells left to walk.
+     */
+    bool allPathsFinished() const;
+
+    /**
+     * @return Arena cells in use, including garbage awaiting compaction.
+     */
+    size_t getArenaSize() const { return arena.size(); }
+
+private:
+    uint32_t pack(int r, int c) const { return static_cast<uint32_t>(r) * width + c; }
+    std::pair<int, int> unpack(uint32_t cell) const {
+        return {static_cast<int>(cell / width), static_cast<int>(cell % width)};
+    }
+
+    // Rewrites the arena with the live paths only, in agent order
+    void compact();
+
+    uint32_t width = 1;
+    std::vector<double> startVals;
+    std::vector<int32_t> rows, cols;          // Current cell
+    std::vector<int32_t> goalRows, goalCols;  // Assigned goal, or -1
+    std::vector<uint32_t> pathIndices;        // Waypoint reached last
+    std::vector<uint32_t> pathLengths;        // Waypoints in the path; 0 = none
+    std::vector<uint32_t> pathOffsets;        // First waypoint of the path in arena
+    std::vector<uint32_t> pathCapacities;     // Cells of arena owned by the agent
+    std::vector<uint8_t> pathDiagonal;        // Segments are walked 8-way
+    std::vector<uint32_t> arena;              // Packed cells of every path
+    size_t ownedCells = 0;                    // Sum of pathCapacities
+};
@@ -0,0 +1,372 @@
+/******************************************************************************
+ * File:    Benchmark.cpp
+ *
+ * Overview:
+ *   Command-line benchmark of the search engines and of the
+ *   MultiUnitCoordinator tick loop on reproducible synthetic maps (see
+ *   MapGenerator):
+ *
+ *     rts-bench [--layouts open,random,maze,rooms] [--sizes 64,256,1024]
+ *               [--density P] [--queries N] [--seed S]
+ *               [--engines astar,jps,hpa] [--agents N] [--max-ticks N]
+ *               [--save-dir DIR]
+ *     rts-bench --map FILE [--scenario FILE] [options above]
+ *
+ *   For every map, each engine answers the same scenario of start/goal
+ *   queries; the report lists the engine's build time, throughput, p50 and
+ *   p99 query latency, and the node expansions per second (A* always; JPS
+ *   when built with -DRTS_WITH_STATS, see Statistics). Then
+ *   --agents agents (default 1000, 0 to skip) walk to goals on the map
+ *   under tick(), which reports tick rate and p50/p99 tick time.
+ *
+ *   --save-dir writes each generated map (.rtsmap) and its scenario (.scen)
+ *   so other tools and runs can use exactly the same input; --map and
+ *   --scenario read them back.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Map.h"
+#include "BinaryMap.h"
+#include "Logger.h"
+#include "MapGenerator.h"
+#include "MultiUnitCoordinator.h"
+#include "Pathfinder.h"
+#include "Pathfinding.h"
+#include "SearchContext.h"
+#include "Statistics.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Queries run untimed first, so the buffers of a context are grown
+const size_t WARMUP_QUERIES = 100;
+
+struct Options {
+    std::vector<MapGenerator::Layout> layouts{ MapGenerator::Layout::Open,
+                                               MapGenerator::Layout::Random,
+                                               MapGenerator::Layout::Maze,
+                                               MapGenerator::Layout::Rooms };
+    std::vector<int> sizes{ 64, 256, 1024 };
+    std::vector<PathfinderType> engines{ PathfinderType::AStar, PathfinderType::JumpPoint,
+                                         PathfinderType::Hierarchical };
+    double density = 0.2;
+    size_t queries = 1000;
+    uint64_t seed = 1;
+    size_t agents = 1000;
+    int maxTicks = 2000;
+    std::string saveDir;
+    std::string mapFile;
+    std::string scenarioFile;
+};
+
+double microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Value at quantile q of sorted samples
+double percentile(const std::vector<double>& sorted, double q)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    return sorted[static_cast<size_t>(q * (sorted.size() - 1))];
+}
+
+std::vector<std::string> splitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for option: " << flag << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (flag == "--layouts") {
+            options.layouts.clear();
+            for (const std::string& name : splitList(value)) {
+                MapGenerator::Layout layout;
+                if (!MapGenerator::parseLayout(name, layout)) {
+                    std::cerr << "Unknown layout: " << name
+                              << " (expected open, random, maze or rooms)\n";
+                    return false;
+                }
+                options.layouts.push_back(layout);
+            }
+        } else if (flag == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& size : splitList(value)) {
+                int side = std::atoi(size.c_str());
+                if (side < 8 || side > 4096) {
+                    std::cerr << "Map size must be between 8 and 4096: " << size << "\n";
+                    return false;
+                }
+                options.sizes.push_back(side);
+            }
+        } else if (flag == "--engines") {
+            options.engines.clear();
+            for (const std::string& name : splitList(value)) {
+                PathfinderType type;
+                if (!parsePathfinderType(name, type)) {
+                    std::cerr << "Unknown search engine: " << name
+                              << " (expected astar, jps or hpa)\n";
+                    return false;
+                }
+                options.engines.push_back(type);
+            }
+        } else if (flag == "--density") {
+            options.density = std::atof(value.c_str());
+        } else if (flag == "--queries") {
+            options.queries = static_cast<size_t>(std::max(1, std::atoi(value.c_str())));
+        } else if (flag == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (flag == "--agents") {
+            options.agents = static_cast<size_t>(std::max(0, std::atoi(value.c_str())));
+        } else if (flag == "--max-ticks") {
+            options.maxTicks = std::max(1, std::atoi(value.c_str()));
+        } else if (flag == "--save-dir") {
+            options.saveDir = value;
+        } else if (flag == "--map") {
+            options.mapFile = value;
+        } else if (flag == "--scenario") {
+            options.scenarioFile = value;
+        } else {
+            std::cerr << "Unknown option: " << flag << "\n";
+            return false;
+        }
+    }
+    if (options.layouts.empty() || options.sizes.empty() || options.engines.empty()) {
+        std::cerr << "Empty --layouts, --sizes or --engines list\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Runs every query through one engine and prints a report line.
+ */
+void benchmarkEngine(const Map& map, PathfinderType type,
+                     const std::vector<MapGenerator::Query>& queries)
+{
+    Clock::time_point buildStart = Clock::now();
+    std::unique_ptr<Pathfinder> engine = createPathfinder(type, map);
+    double buildMs = microsecondsSince(buildStart) / 1000.0;
+
+    // A* answers through Pathfinding::aStar directly (as AStarPathfinder
+    // does with default options) to collect its expansion counts; other
+    // engines are counted by the Statistics counters if compiled in
+    const bool countExpansions = type == PathfinderType::AStar;
+    SearchContext context;
+    SearchStats stats;
+    size_t expansions = 0;
+    auto run = [&](const MapGenerator::Query& q) {
+        if (countExpansions) {
+            auto path = Pathfinding::aStar(map, context, q.startRow, q.startCol,
+                                           q.goalRow, q.goalCol, SearchOptions(), &stats);
+            expansions += stats.expansions;
+            return path;
+        }
+        return engine->findPath(map, context, q.startRow, q.startCol, q.goalRow, q.goalCol);
+    };
+
+    for (size_t i = 0; i < std::min(WARMUP_QUERIES, queries.size()); ++i) {
+        run(queries[i]);
+    }
+    expansions = 0;
+    const uint64_t countedBefore = Statistics::counters().expansions;
+
+    std::vector<double> latencies;
+    latencies.reserve(queries.size());
+    size_t found = 0;
+    for (const MapGenerator::Query& q : queries) {
+        Clock::time_point start = Clock::now();
+        std::vector<std::pair<int, int>> path = run(q);
+        latencies.push_back(microsecondsSince(start));
+        if (!path.empty() && path.back() == std::make_pair(q.goalRow, q.goalCol)) {
+            ++found;
+        }
+    }
+
+    double totalUs = 0.0;
+    for (double us : latencies) {
+        totalUs += us;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double seconds = std::max(totalUs, 1e-3) / 1e6;
+    if (!countExpansions) {
+        expansions = Statistics::counters().expansions - countedBefore;
+    }
+
+    std::cout << "  " << std::left << std::setw(8) << engine->name() << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << buildMs
+              << std::setw(12) << queries.size() / seconds
+              << std::setw(10) << percentile(latencies, 0.50)
+              << std::setw(10) << percentile(latencies, 0.99)
+              << std::setw(8) << found << "/" << std::left << std::setw(7) << queries.size()
+              << std::right;
+    if (expansions > 0) {
+        std::cout << std::setw(12) << std::setprecision(0) << expansions / seconds;
+    } else {
+        std::cout << std::setw(12) << "-";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * Places agents and goals on a copy of the map and times tick() until the
+ * agents stop moving or maxTicks is reached.
+ */
+void benchmarkCoordinator(const Map& map, size_t agentCount, int maxTicks, uint64_t seed)
+{
+    // Agents stand on the starts of a scenario and their goals on its goals
+    Map world = map;
+    std::vector<MapGenerator::Query> placements =
+        MapGenerator::generateScenario(world, agentCount, seed + 1);
+    std::vector<char> taken(static_cast<size_t>(world.getWidth()) * world.getHeight(), 0);
+    size_t agents = 0;
+    for (const MapGenerator::Query& q : placements) {
+        char& start = taken[static_cast<size_t>(q.startRow) * world.getWidth() + q.startCol];
+        if (!start) {
+            start = 1;
+            world.setCell(q.startRow, q.startCol, 0.5);
+            ++agents;
+        }
+        char& goal = taken[static_cast<size_t>(q.goalRow) * world.getWidth() + q.goalCol];
+        if (!goal) {
+            goal = 1;
+            world.setCell(q.goalRow, q.goalCol, 8.1);
+        }
+    }
+
+    // The coordinator reports every agent; keep only errors
+    MultiUnitCoordinator coordinator(world);
+    const LogLevel logLevel = Logger::getLevel();
+    Logger::setLevel(LogLevel::Error);
+    Clock::time_point setupStart = Clock::now();
+    coordinator.findStartsAndGoals();
+    coordinator.assignGoals();
+    coordinator.requestAllPaths();
+    double setupMs = microsecondsSince(setupStart) / 1000.0;
+
+    std::vector<double> tickTimes;
+    bool moving = true;
+    while (moving && static_cast<int>(tickTimes.size()) < maxTicks) {
+        Clock::time_point start = Clock::now();
+        moving = coordinator.tick();
+        tickTimes.push_back(microsecondsSince(start));
+    }
+    Logger::setLevel(logLevel);
+
+    const AgentStore& store = coordinator.getAgents();
+    size_t arrived = 0;
+    for (size_t i = 0; i < store.size(); ++i) {
+        arrived += store.hasGoal(i) && store.row(i) == store.goalRow(i) &&
+                   store.col(i) == store.goalCol(i);
+    }
+    double totalUs = 0.0;
+    for (double us : tickTimes) {
+        totalUs += us;
+    }
+    std::sort(tickTimes.begin(), tickTimes.end());
+
+    std::cout << "  ticks   " << std::fixed << std::setprecision(1)
+              << agents << " agents, setup " << setupMs << " ms, "
+              << tickTimes.size() << " ticks at "
+              << tickTimes.size() / (std::max(totalUs, 1e-3) / 1e6) << " ticks/s"
+              << ", p50 " << percentile(tickTimes, 0.50) << " us"
+              << ", p99 " << percentile(tickTimes, 0.99) << " us"
+              << ", " << arrived << " arrived\n";
+}
+
+void benchmarkMap(const Map& map, const std::string& label,
+                  const std::vector<MapGenerator::Query>& queries, const Options& options)
+{
+    std::cout << "\n" << label << " (" << map.getWidth() << "x" << map.getHeight() << "), "
+              << queries.size() << " queries\n"
+              << "  engine    build ms   queries/s    p50 us    p99 us     found"
+              << "        nodes/s\n";
+    for (PathfinderType type : options.engines) {
+        benchmarkEngine(map, type, queries);
+    }
+    if (options.agents > 0) {
+        benchmarkCoordinator(map, options.agents, options.maxTicks, options.seed);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: rts-bench [--layouts open,random,maze,rooms] [--sizes 64,256,1024] "
+                  << "[--density P] [--queries N] [--seed S] [--engines astar,jps,hpa] "
+                  << "[--agents N] [--max-ticks N] [--save-dir DIR] "
+                  << "[--map FILE [--scenario FILE]]\n";
+        return 1;
+    }
+
+    std::cout << "RTS Pathfinding benchmark, seed " << options.seed << "\n";
+
+    if (!options.mapFile.empty()) {
+        Map map;
+        if (!map.loadFromFile(options.mapFile)) {
+            std::cerr << "Failed to load map from file.\n";
+            return 1;
+        }
+        std::vector<MapGenerator::Query> queries;
+        if (options.scenarioFile.empty()) {
+            queries = MapGenerator::generateScenario(map, options.queries, options.seed);
+        } else if (!MapGenerator::readScenario(options.scenarioFile, map, queries)) {
+            return 1;
+        }
+        benchmarkMap(map, options.mapFile, queries, options);
+        return 0;
+    }
+
+    for (MapGenerator::Layout layout : options.layouts) {
+        for (int size : options.sizes) {
+            Map map;
+            if (!MapGenerator::generate(map, layout, size, size, options.seed, options.density)) {
+                return 1;
+            }
+            std::vector<MapGenerator::Query> queries =
+                MapGenerator::generateScenario(map, options.queries, options.seed);
+            std::string label = std::string(MapGenerator::layoutName(layout)) + "-" +
+                                std::to_string(size);
+            if (!options.saveDir.empty()) {
+                std::string base = options.saveDir + "/" + label;
+                if (!BinaryMap::save(map, base + ".rtsmap") ||
+                    !MapGenerator::writeScenario(base + ".scen", size, size, queries)) {
+                    return 1;
+                }
+            }
+            benchmarkMap(map, label, queries, options);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,433 @@
+/******************************************************************************
+ * File:    BinaryMap.cpp
+ *
+ * Overview:
+ *   Implementation of the BinaryMap class. Files are loaded through a
+ *   MappedFile: the header and arrays are validated against the file size,
+ *   then copied directly into the Map's storage. Only the per-cell tile
+ *   types and costs are recomputed; the passability bitset is taken from the
+ *   file unless terrain costs are set (Map::decodeTiles rebuilds it then).
+ *   Landmark tables sit after the payload, so a loader that does not want
+ *   them never reads those pages.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "BinaryMap.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#ifdef RTS_WITH_LZ4
+#include <lz4.h>
+#endif
+
+namespace {
+
+const char MAGIC[4] = {'R', 'T', 'S', 'M'};
+const size_t LZ4_CHUNK_SIZE = size_t(1) << 20;  // Raw bytes per compressed chunk
+
+static_assert(sizeof(BinaryMapHeader) == 32, "BinaryMapHeader must stay 32 bytes");
+
+// Terrain cost a Map gives a tile value unless told otherwise
+double defaultTerrainCost(double value)
+{
+    return Map::classifyTile(value) == TileType::Wall ? Map::IMPASSABLE : 1.0;
+}
+
+// Size of the tile array, padded so the bitset that follows is 8-byte aligned
+size_t tileBytes(size_t cellCount, bool byteTiles)
+{
+    size_t bytes = cellCount * (byteTiles ? 1 : 2);
+    return (bytes + 7) & ~size_t(7);
+}
+
+#ifdef RTS_WITH_LZ4
+// Compresses raw into a sequence of (rawSize, compressedSize, block) chunks
+bool compressChunks(const std::vector<char>& raw, std::vector<char>& out)
+{
+    out.clear();
+    std::vector<char> block(LZ4_compressBound(static_cast<int>(LZ4_CHUNK_SIZE)));
+    for (size_t offset = 0; offset < raw.size(); offset += LZ4_CHUNK_SIZE) {
+        uint32_t rawSize = static_cast<uint32_t>(std::min(LZ4_CHUNK_SIZE, raw.size() - offset));
+        int packed = LZ4_compress_default(raw.data() + offset, block.data(),
+                                          static_cast<int>(rawSize),
+                                          static_cast<int>(block.size()));
+        if (packed <= 0) {
+            return false;
+        }
+        uint32_t packedSize = static_cast<uint32_t>(packed);
+        out.insert(out.end(), reinterpret_cast<const char*>(&rawSize),
+                   reinterpret_cast<const char*>(&rawSize) + 4);
+        out.insert(out.end(), reinterpret_cast<const char*>(&packedSize),
+                   reinterpret_cast<const char*>(&packedSize) + 4);
+        out.insert(out.end(), block.data(), block.data() + packedSize);
+    }
+    return true;
+}
+
+// Inverse of compressChunks; fails unless exactly rawSize bytes come out
+bool decompressChunks(const char* data, size_t size, size_t rawSize, std::vector<char>& out)
+{
+    out.resize(rawSize);
+    size_t written = 0;
+    const char* end = data + size;
+    while (data < end) {
+        uint32_t chunkRaw, chunkPacked;
+        if (end - data < 8) {
+            return false;
+        }
+        std::memcpy(&chunkRaw, data, 4);
+        std::memcpy(&chunkPacked, data + 4, 4);
+        data += 8;
+        if (static_cast<size_t>(end - data) < chunkPacked || rawSize - written < chunkRaw) {
+            return false;
+        }
+        int decoded = LZ4_decompress_safe(data, out.data() + written,
+                                          static_cast<int>(chunkPacked),
+                                          static_cast<int>(chunkRaw));
+        if (decoded != static_cast<int>(chunkRaw)) {
+            return false;
+        }
+        data += chunkPacked;
+        written += chunkRaw;
+    }
+    return written == rawSize;
+}
+#endif
+
+} // namespace
+
+/**
+ * @return True if LZ4 support was compiled in.
+ */
+bool BinaryMap::hasCompression()
+{
+#ifdef RTS_WITH_LZ4
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @return True if the path has the binary map extension (".rtsmap").
+ */
+bool BinaryMap::isBinaryMapPath(const std::string& filePath)
+{
+    const std::string extension = ".rtsmap";
+    return filePath.size() >= extension.size() &&
+           filePath.compare(filePath.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Writes a map to a binary file.
+ *
+ * @param map      Map to save.
+ * @param filePath Destination path.
+ * @param compress Compress the payload with LZ4 (needs RTS_WITH_LZ4).
+ * @param landmarks Optional ALT tables to store after the payload.
+ * @return True on success; errors are reported on std::cerr.
+ */
+bool BinaryMap::save(const Map& map, const std::string& filePath, bool compress,
+                     const LandmarkTable* landmarks)
+{
+    if (compress && !hasCompression()) {
+        std::cerr << "LZ4 compression is not available in this build." << std::endl;
+        return false;
+    }
+    if (landmarks && !landmarks->isCurrent(map)) {
+        std::cerr << "Landmark tables do not match the map being saved." << std::endl;
+        return false;
+    }
+
+    size_t cellCount = static_cast<size_t>(map.width) * map.height;
+    bool byteTiles = map.tileDictionary.size() <= 256;
+
+    // Raw payload: tile ids, then the padded passability bitset
+    size_t tileSize = tileBytes(cellCount, byteTiles);
+    size_t bitSize = map.passableBits.size() * sizeof(uint64_t);
+    std::vector<char> payload(tileSize + bitSize, 0);
+    if (byteTiles) {
+        for (size_t i = 0; i < cellCount; ++i) {
+            payload[i] = static_cast<char>(map.tileIds[i]);
+        }
+    } else {
+        std::memcpy(payload.data(), map.tileIds.data(), cellCount * sizeof(uint16_t));
+    }
+    std::memcpy(payload.data() + tileSize, map.passableBits.data(), bitSize);
+
+    BinaryMapHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = FORMAT_VERSION;
+    header.flags = byteTiles ? FLAG_BYTE_TILES : 0;
+    header.width = static_cast<uint32_t>(map.width);
+    header.height = static_cast<uint32_t>(map.height);
+    header.dictionarySize = static_cast<uint32_t>(map.tileDictionary.size());
+
+#ifdef RTS_WITH_LZ4
+    if (compress) {
+        std::vector<char> packed;
+        if (!compressChunks(payload, packed)) {
+            std::cerr << "Error compressing map payload." << std::endl;
+            return false;
+        }
+        payload.swap(packed);
+        header.flags |= FLAG_LZ4;
+    }
+#endif
+    header.payloadSize = payload.size();
+    if (landmarks) {
+        header.flags |= FLAG_LANDMARKS;
+    }
+
+    std::ofstream fout(filePath, std::ios::binary);
+    if (!fout) {
+        std::cerr << "Error opening file for writing: " << filePath << std::endl;
+        return false;
+    }
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char*>(map.tileDictionary.data()),
+               map.tileDictionary.size() * sizeof(double));
+    std::vector<double> costs(map.tileDictionary.size());
+    for (size_t id = 0; id < costs.size(); ++id) {
+        costs[id] = map.getTerrainCost(map.tileDictionary[id]);
+    }
+    fout.write(reinterpret_cast<const char*>(costs.data()), costs.size() * sizeof(double));
+    fout.write(payload.data(), payload.size());
+    if (landmarks) {
+        uint32_t counts[2] = {static_cast<uint32_t>(landmarks->count), 0};
+        fout.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+        for (const auto& cell : landmarks->landmarks) {
+            uint32_t rowCol[2] = {static_cast<uint32_t>(cell.first),
+                                  static_cast<uint32_t>(cell.second)};
+            fout.write(reinterpret_cast<const char*>(rowCol), sizeof(rowCol));
+        }
+        fout.write(reinterpret_cast<const char*>(landmarks->distances.data()),
+                   landmarks->distances.size() * sizeof(uint16_t));
+    }
+    if (!fout) {
+        std::cerr << "Error writing file: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads a binary map file into a Map.
+ *
+ * Every size is validated against the file before anything is copied, and
+ * tile ids are checked against the dictionary, so a truncated or corrupt
+ * file is rejected instead of producing out-of-range reads later.
+ *
+ * @param map       Map to fill; unchanged on failure.
+ * @param filePath  Source path.
+ * @param landmarks Optional; receives the stored ALT tables.
+ * @return True on success; errors are reported on std::cerr.
+ */
+bool BinaryMap::load(Map& map, const std::string& filePath, LandmarkTable* landmarks)
+{
+    MappedFile file;
+    if (!file.open(filePath)) {
+        std::cerr << "Error opening file: " << filePath << std::endl;
+        return false;
+    }
+
+    BinaryMapHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "Invalid binary map: file too small" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Invalid binary map: bad magic" << std::endl;
+        return false;
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        std::cerr << "Invalid binary map: written with a different byte order" << std::endl;
+        return false;
+    }
+    if (header.version != FORMAT_VERSION) {
+        std::cerr << "Unsupported binary map version: " << header.version << std::endl;
+        return false;
+    }
+    if ((header.flags & ~(FLAG_BYTE_TILES | FLAG_LZ4 | FLAG_LANDMARKS)) != 0) {
+        std::cerr << "Invalid binary map: unknown flags" << std::endl;
+        return false;
+    }
+
+    // The padded cell count must fit the int indices used by Map
+    const uint64_t maxCells = static_cast<uint64_t>(std::numeric_limits<int>::max());
+    if (header.width == 0 || header.height == 0 ||
+        (uint64_t(header.width) + 2) * (uint64_t(header.height) + 2) > maxCells) {
+        std::cerr << "Invalid binary map size: " << header.width << "x" << header.height << std::endl;
+        return false;
+    }
+    if (header.dictionarySize == 0 ||
+        header.dictionarySize > uint32_t(std::numeric_limits<uint16_t>::max()) + 1) {
+        std::cerr << "Invalid binary map: bad dictionary size" << std::endl;
+        return false;
+    }
+
+    // The dictionary and the cost of each value
+    size_t dictionaryBytes = size_t(header.dictionarySize) * sizeof(double);
+    if (file.size() - sizeof(header) < 2 * dictionaryBytes ||
+        file.size() - sizeof(header) - 2 * dictionaryBytes < header.payloadSize) {
+        std::cerr << "Invalid binary map: truncated file" << std::endl;
+        return false;
+    }
+
+    // Optional landmark section: everything after the payload
+    size_t sectionOffset = sizeof(header) + 2 * dictionaryBytes + header.payloadSize;
+    size_t sectionSize = file.size() - sectionOffset;
+    uint32_t landmarkCount = 0;
+    size_t landmarkCells = (size_t(header.width) + 2) * (size_t(header.height) + 2);
+    if (header.flags & FLAG_LANDMARKS) {
+        uint32_t counts[2];
+        if (sectionSize < sizeof(counts)) {
+            std::cerr << "Invalid binary map: truncated landmark section" << std::endl;
+            return false;
+        }
+        std::memcpy(counts, file.data() + sectionOffset, sizeof(counts));
+        landmarkCount = counts[0];
+        if (landmarkCount == 0 || landmarkCount > uint32_t(LandmarkTable::MAX_LANDMARK_COUNT) ||
+            sectionSize != sizeof(counts) + size_t(landmarkCount) * 2 * sizeof(uint32_t) +
+                               landmarkCells * landmarkCount * sizeof(uint16_t)) {
+            std::cerr << "Invalid binary map: bad landmark section" << std::endl;
+            return false;
+        }
+    } else if (sectionSize != 0) {
+        std::cerr << "Invalid binary map: trailing data" << std::endl;
+        return false;
+    }
+
+    Map loaded;
+    loaded.terrainCosts = map.terrainCosts;
+    loaded.width = static_cast<int>(header.width);
+    loaded.height = static_cast<int>(header.height);
+    size_t cellCount = size_t(header.width) * header.height;
+    bool byteTiles = (header.flags & FLAG_BYTE_TILES) != 0;
+    size_t tileSize = tileBytes(cellCount, byteTiles);
+    size_t bitCount = (static_cast<size_t>(loaded.getPaddedCellCount()) + 63) / 64;
+    size_t rawSize = tileSize + bitCount * sizeof(uint64_t);
+
+    // Locate the raw payload, decompressing it if needed
+    const char* dictionary = file.data() + sizeof(header);
+    const char* costs = dictionary + dictionaryBytes;
+    const char* payload = costs + dictionaryBytes;
+    std::vector<char> unpacked;
+    if (header.flags & FLAG_LZ4) {
+#ifdef RTS_WITH_LZ4
+        if (!decompressChunks(payload, header.payloadSize, rawSize, unpacked)) {
+            std::cerr << "Invalid binary map: corrupt compressed payload" << std::endl;
+            return false;
+        }
+        payload = unpacked.data();
+#else
+        std::cerr << "Binary map is LZ4-compressed, but LZ4 support is not built in." << std::endl;
+        return false;
+#endif
+    } else if (header.payloadSize != rawSize) {
+        std::cerr << "Invalid binary map: payload size mismatch" << std::endl;
+        return false;
+    }
+
+    // Dictionary
+    loaded.tileDictionary.resize(header.dictionarySize);
+    std::memcpy(loaded.tileDictionary.data(), dictionary, dictionaryBytes);
+    for (size_t id = 0; id < loaded.tileDictionary.size(); ++id) {
+        loaded.tileLookup.emplace(loaded.tileDictionary[id], static_cast<uint16_t>(id));
+    }
+
+    // Costs the stored passability was computed with; decodeTiles() applies them
+    for (size_t id = 0; id < loaded.tileDictionary.size(); ++id) {
+        double cost;
+        std::memcpy(&cost, costs + id * sizeof(double), sizeof(double));
+        if (!(cost > 0.0)) {
+            std::cerr << "Invalid binary map: bad terrain cost" << std::endl;
+            return false;
+        }
+        if (cost != defaultTerrainCost(loaded.tileDictionary[id])) {
+            loaded.terrainCosts[loaded.tileDictionary[id]] = cost;
+        }
+    }
+
+    // Tile ids
+    loaded.tileIds.resize(cellCount);
+    if (byteTiles) {
+        const uint8_t* ids = reinterpret_cast<const uint8_t*>(payload);
+        for (size_t i = 0; i < cellCount; ++i) {
+            loaded.tileIds[i] = ids[i];
+        }
+    } else {
+        std::memcpy(loaded.tileIds.data(), payload, cellCount * sizeof(uint16_t));
+    }
+    uint16_t maxId = 0;
+    for (uint16_t id : loaded.tileIds) {
+        maxId = std::max(maxId, id);
+    }
+    if (maxId >= header.dictionarySize) {
+        std::cerr << "Invalid binary map: tile id outside the dictionary" << std::endl;
+        return false;
+    }
+
+    // Passability, with the border forced to blocked: searches rely on it
+    loaded.passableBits.resize(bitCount);
+    std::memcpy(loaded.passableBits.data(), payload + tileSize, bitCount * sizeof(uint64_t));
+    auto block = [&](int idx) {
+        loaded.passableBits[idx >> 6] &= ~(uint64_t(1) << (idx & 63));
+    };
+    for (int c = -1; c <= loaded.width; ++c) {
+        block(loaded.paddedIndex(-1, c));
+        block(loaded.paddedIndex(loaded.height, c));
+    }
+    for (int r = 0; r < loaded.height; ++r) {
+        block(loaded.paddedIndex(r, -1));
+        block(loaded.paddedIndex(r, loaded.width));
+    }
+    int paddedCells = loaded.getPaddedCellCount();
+    if (paddedCells & 63) {
+        loaded.passableBits.back() &= (uint64_t(1) << (paddedCells & 63)) - 1;
+    }
+
+    loaded.decodeTiles(false);
+    loaded.connectivity.build(loaded);
+    loaded.version = map.version + 1;
+    loaded.resetRegionVersions();
+
+    LandmarkTable table;
+    if (landmarkCount > 0 && landmarks) {
+        const char* section = file.data() + sectionOffset + 2 * sizeof(uint32_t);
+        table.count = static_cast<int>(landmarkCount);
+        table.width = loaded.width;
+        table.height = loaded.height;
+        for (uint32_t k = 0; k < landmarkCount; ++k) {
+            uint32_t rowCol[2];
+            std::memcpy(rowCol, section + k * sizeof(rowCol), sizeof(rowCol));
+            if (rowCol[0] >= header.height || rowCol[1] >= header.width) {
+                std::cerr << "Invalid binary map: landmark outside the map" << std::endl;
+                return false;
+            }
+            table.landmarks.push_back({int(rowCol[0]), int(rowCol[1])});
+        }
+        table.distances.resize(landmarkCells * landmarkCount);
+        std::memcpy(table.distances.data(), section + landmarkCount * 2 * sizeof(uint32_t),
+                    table.distances.size() * sizeof(uint16_t));
+    }
+
+    // ObserverList ignores assignment, so the observers stay registered
+    map = std::move(loaded);
+    if (landmarks) {
+        table.mapVersion = map.version;
+        *landmarks = std::move(table);
+    }
+    map.notifyReloaded();
+    return true;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+/******************************************************************************
+ * File:    BinaryMap.h
+ *
+ * Overview:
+ *   This header declares the BinaryMap class, which saves and loads a Map in
+ *   a compact, versioned binary format (".rtsmap"). Loading is one memory
+ *   mapping plus a straight copy of each array, with no text parsing.
+ *
+ *   Layout (host byte order; a byte-order mark rejects foreign files):
+ *
+ *     Header        32 bytes, see BinaryMapHeader
+ *     Dictionary    double[dictionarySize], the distinct tile values
+ *     Costs         double[dictionarySize], terrain cost of each value
+ *     Payload       payloadSize bytes, either raw or LZ4 chunks:
+ *       Tiles       uint8 ids (dictionary <= 256 entries) or uint16 ids,
+ *                   width*height entries, zero-padded to 8 bytes
+ *       Passability uint64[(paddedCells + 63) / 64], the Map's padded bitset
+ *     Landmarks     Optional (FLAG_LANDMARKS), never compressed:
+ *       Count       uint32 landmark count K, then uint32 zero
+ *       Cells       uint32[2 * K], (row, col) of each landmark
+ *       Distances   uint16[paddedCells * K], see LandmarkTable
+ *
+ *   A compressed payload is a sequence of chunks, each a uint32 raw size,
+ *   a uint32 compressed size and the LZ4 block. Compression needs the build
+ *   flag RTS_WITH_LZ4 (and liblz4); without it such files are rejected.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "LandmarkTable.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Fixed-size header at the start of every binary map file.
+ */
+struct BinaryMapHeader {
+    char     magic[4];        ///< "RTSM"
+    uint32_t byteOrder;       ///< BinaryMap::BYTE_ORDER_MARK as written by the host
+    uint16_t version;         ///< BinaryMap::FORMAT_VERSION
+    uint16_t flags;           ///< BinaryMap::FLAG_* bits
+    uint32_t width;           ///< Number of columns
+    uint32_t height;          ///< Number of rows
+    uint32_t dictionarySize;  ///< Number of distinct tile values
+    uint64_t payloadSize;     ///< Bytes stored after the dictionary
+};
+
+/**
+ * @class BinaryMap
+ *
+ * @brief Contains static methods to save and load the binary map format.
+ */
+class BinaryMap {
+public:
+    static constexpr uint16_t FORMAT_VERSION  = 2;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr uint16_t FLAG_BYTE_TILES = 1 << 0;  ///< Tile ids stored as uint8
+    static constexpr uint16_t FLAG_LZ4        = 1 << 1;  ///< Payload is LZ4-compressed
+    static constexpr uint16_t FLAG_LANDMARKS  = 1 << 2;  ///< ALT tables follow the payload
+
+    /**
+     * @brief Writes a map to a binary file.
+     *
+     * The terrain costs of the map's tile values are stored with it, so the
+     * stored passability matches the costs it was computed with.
+     *
+     * @param map      Map to save.
+     * @param filePath Destination path (conventionally ending in ".rtsmap").
+     * @param compress Compress the payload with LZ4 (needs RTS_WITH_LZ4).
+     * @param landmarks Optional ALT tables to store; must be current for the map.
+     * @return True on success; errors are reported on std::cerr.
+     */
+    static bool save(const Map& map, const std::string& filePath, bool compress = false,
+                     const LandmarkTable* landmarks = nullptr);
+
+    /**
+     * @brief Loads a binary map file into a Map.
+     *
+     * Costs stored in the file that differ from the defaults replace the
+     * map's own setting for those values; other settings are kept. On
+     * failure the map is left unchanged. Observers stay registered.
+     *
+     * @param map       Map to fill.
+     * @param filePath  Source path.
+     * @param landmarks If given, receives the stored ALT tables (bound to
+     *                  the loaded map), or is emptied if the file has none.
+     * @return True on success; errors are reported on std::cerr.
+     */
+    static bool load(Map& map, const std::string& filePath,
+                     LandmarkTable* landmarks = nullptr);
+
+    /**
+     * @return True if the path has the binary map extension (".rtsmap").
+     */
+    static bool isBinaryMapPath(const std::string& filePath);
+
+    /**
+     * @return True if LZ4 support was compiled in.
+     */
+    static bool hasCompression();
+};
@@ -0,0 +1,723 @@
+/******************************************************************************
+ * File:    ChunkedMap.cpp
+ *
+ * Overview:
+ *   Implementation of the ChunkedMap class. write() finds the entrances on
+ *   every chunk border, then builds each chunk's Map and its in-chunk
+ *   edges on a thread pool; open() validates the index against the file
+ *   size and keeps the tile pages mapped until a chunk is first used.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "ChunkedMap.h"
+#include "Pathfinding.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+const char MAGIC[4] = {'R', 'T', 'S', 'W'};
+
+// Runs of open border cells at least this wide get an entrance at each end,
+// and every ENTRANCE_SPACING cells in between, so open borders stay cheap
+// to cross anywhere
+const int MAX_ENTRANCE_WIDTH = 6;
+const int ENTRANCE_SPACING = 8;
+
+static_assert(sizeof(ChunkedMapHeader) == 40, "ChunkedMapHeader must stay 40 bytes");
+
+// Terrain cost a Map gives a tile value unless told otherwise
+double defaultTerrainCost(double value)
+{
+    return Map::classifyTile(value) == TileType::Wall ? Map::IMPASSABLE : 1.0;
+}
+
+// Appends the bytes of an array to a file
+template <class T>
+void writeArray(std::ofstream& out, const std::vector<T>& values)
+{
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+// Copies count values of type T from the file at offset; false if truncated
+template <class T>
+bool readArray(const MappedFile& file, size_t& offset, size_t count, std::vector<T>& values)
+{
+    if ((file.size() - offset) / sizeof(T) < count) {
+        return false;
+    }
+    values.resize(count);
+    std::memcpy(values.data(), file.data() + offset, count * sizeof(T));
+    offset += count * sizeof(T);
+    return true;
+}
+
+} // namespace
+
+/**
+ * @return True if the path has the chunked world extension (".rtsworld").
+ */
+bool ChunkedMap::isChunkedMapPath(const std::string& filePath)
+{
+    const std::string extension = ".rtsworld";
+    return filePath.size() >= extension.size() &&
+           filePath.compare(filePath.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Builds the Map of one chunk.
+ *
+ * Costs that differ from the Map defaults are applied before the tiles
+ * are decoded, so the chunk searches exactly like the world did.
+ */
+bool ChunkedMap::buildChunk(const std::vector<double>& values, int chunkWidth, int chunkHeight,
+                            const std::vector<double>& dictionary,
+                            const std::vector<double>& costs, Map& chunk)
+{
+    for (size_t id = 0; id < dictionary.size(); ++id) {
+        if (costs[id] != defaultTerrainCost(dictionary[id]) &&
+            !chunk.setTerrainCost(dictionary[id], costs[id])) {
+            return false;
+        }
+    }
+    return chunk.loadFromValues(chunkWidth, chunkHeight, values);
+}
+
+/**
+ * @brief Writes a map as a chunked world.
+ *
+ * @param map         Map to write.
+ * @param filePath    Destination path.
+ * @param size        Chunk side length, in cells.
+ * @param threadCount Threads building the chunks; 0 = hardware concurrency.
+ * @return True on success; errors are reported on std::cerr.
+ */
+bool ChunkedMap::write(const Map& map, const std::string& filePath, int size,
+                       unsigned threadCount)
+{
+    if (size < 4) {
+        std::cerr << "Invalid chunk size: " << size << std::endl;
+        return false;
+    }
+    const int w = map.getWidth();
+    const int h = map.getHeight();
+    if (w == 0 || h == 0) {
+        std::cerr << "Cannot write an empty map." << std::endl;
+        return false;
+    }
+
+    // Geometry shared with open()
+    ChunkedMap layout;
+    layout.width = w;
+    layout.height = h;
+    layout.chunkSize = size;
+    layout.chunksX = (w + size - 1) / size;
+    layout.chunksY = (h + size - 1) / size;
+    const int chunkCount = layout.getChunkCount();
+
+    std::vector<double> dictionary(map.getTileDictionarySize());
+    std::vector<double> costs(dictionary.size());
+    for (size_t id = 0; id < dictionary.size(); ++id) {
+        dictionary[id] = map.tileValue(static_cast<uint16_t>(id));
+        costs[id] = map.getTerrainCost(dictionary[id]);
+    }
+
+    // Entrances: cells of each chunk that face an open cell across a border
+    std::vector<std::vector<std::pair<int, int>>> chunkEntrances(chunkCount);
+    std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> crossings;
+    auto addEntrance = [&](int r1, int c1, int r2, int c2) {
+        chunkEntrances[layout.chunkOf(r1, c1)].push_back({r1, c1});
+        chunkEntrances[layout.chunkOf(r2, c2)].push_back({r2, c2});
+        crossings.push_back({{r1, c1}, {r2, c2}});
+    };
+    // Scans one border; (dr, dc) steps along it, (nr, nc) across it
+    auto scanBorder = [&](int r, int c, int length, int dr, int dc, int nr, int nc) {
+        int runStart = -1;
+        for (int i = 0; i <= length; ++i) {
+            bool open = i < length && map.isPassable(r + i * dr, c + i * dc) &&
+                        map.isPassable(r + i * dr + nr, c + i * dc + nc);
+            if (open && runStart < 0) {
+                runStart = i;
+            } else if (!open && runStart >= 0) {
+                int runEnd = i - 1;
+                if (runEnd - runStart + 1 < MAX_ENTRANCE_WIDTH) {
+                    int mid = (runStart + runEnd) / 2;
+                    addEntrance(r + mid * dr, c + mid * dc, r + mid * dr + nr, c + mid * dc + nc);
+                } else {
+                    for (int k = runStart; k < runEnd; k += ENTRANCE_SPACING) {
+                        addEntrance(r + k * dr, c + k * dc, r + k * dr + nr, c + k * dc + nc);
+                    }
+                    addEntrance(r + runEnd * dr, c + runEnd * dc,
+                                r + runEnd * dr + nr, c + runEnd * dc + nc);
+                }
+                runStart = -1;
+            }
+        }
+    };
+    for (int ky = 0; ky < layout.chunksY; ++ky) {
+        for (int kx = 0; kx < layout.chunksX; ++kx) {
+            int r0, c0, r1, c1;
+            layout.chunkBounds(ky * layout.chunksX + kx, r0, c0, r1, c1);
+            if (c1 < w) {
+                scanBorder(r0, c1 - 1, r1 - r0, 1, 0, 0, 1);  // Right border
+            }
+            if (r1 < h) {
+                scanBorder(r1 - 1, c0, c1 - c0, 0, 1, 1, 0);  // Bottom border
+            }
+        }
+    }
+
+    // Node ids, ordered by chunk
+    std::vector<std::pair<int, int>> nodeCells;
+    std::vector<uint32_t> chunkNodeStart(chunkCount + 1, 0);
+    std::unordered_map<int, uint32_t> nodeOfCell;  // r * w + c -> node id
+    for (int k = 0; k < chunkCount; ++k) {
+        auto& cells = chunkEntrances[k];
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        chunkNodeStart[k] = static_cast<uint32_t>(nodeCells.size());
+        for (const auto& cell : cells) {
+            nodeOfCell[cell.first * w + cell.second] = static_cast<uint32_t>(nodeCells.size());
+            nodeCells.push_back(cell);
+        }
+    }
+    chunkNodeStart[chunkCount] = static_cast<uint32_t>(nodeCells.size());
+
+    // Edges per node: one step across each crossing, both ways...
+    std::vector<std::vector<Edge>> nodeEdges(nodeCells.size());
+    for (const auto& crossing : crossings) {
+        uint32_t a = nodeOfCell[crossing.first.first * w + crossing.first.second];
+        uint32_t b = nodeOfCell[crossing.second.first * w + crossing.second.second];
+        auto cost = [&](const std::pair<int, int>& cell) {
+            return map.stepCost(map.paddedIndex(cell.first, cell.second));
+        };
+        nodeEdges[a].push_back(Edge{b, cost(crossing.second)});
+        nodeEdges[b].push_back(Edge{a, cost(crossing.first)});
+    }
+
+    // ...and the in-chunk costs between the entrances of each chunk
+    ThreadPool pool(threadCount);
+    std::vector<SearchContext> contexts(pool.size());
+    std::atomic<bool> built{true};
+    pool.parallelFor(chunkCount, [&](size_t k, unsigned worker) {
+        int r0, c0, r1, c1;
+        layout.chunkBounds(static_cast<int>(k), r0, c0, r1, c1);
+        std::vector<double> values;
+        values.reserve(static_cast<size_t>(r1 - r0) * (c1 - c0));
+        for (int r = r0; r < r1; ++r) {
+            for (int c = c0; c < c1; ++c) {
+                values.push_back(map.tileValue(map.tileRow(r)[c]));
+            }
+        }
+        Map chunk;
+        if (!buildChunk(values, c1 - c0, r1 - r0, dictionary, costs, chunk)) {
+            built = false;
+            return;
+        }
+        std::vector<std::pair<int, int>> local;
+        for (uint32_t id = chunkNodeStart[k]; id < chunkNodeStart[k + 1]; ++id) {
+            local.push_back({nodeCells[id].first - r0, nodeCells[id].second - c0});
+        }
+        std::vector<double> distances(local.size());
+        for (size_t i = 0; i < local.size(); ++i) {
+            Pathfinding::distancesFrom(chunk, contexts[worker], local[i].first, local[i].second,
+                                       local, distances.data());
+            for (size_t j = 0; j < local.size(); ++j) {
+                if (j != i && distances[j] != Pathfinding::UNREACHABLE_DISTANCE) {
+                    nodeEdges[chunkNodeStart[k] + i].push_back(
+                        Edge{static_cast<uint32_t>(chunkNodeStart[k] + j),
+                             static_cast<float>(distances[j])});
+                }
+            }
+        }
+    });
+    if (!built) {
+        std::cerr << "Error building chunks for " << filePath << std::endl;
+        return false;
+    }
+
+    // Flatten the graph
+    std::vector<int32_t> nodeData;
+    std::vector<uint32_t> edgeStart;
+    std::vector<Edge> edges;
+    for (size_t id = 0; id < nodeCells.size(); ++id) {
+        nodeData.push_back(nodeCells[id].first);
+        nodeData.push_back(nodeCells[id].second);
+        edgeStart.push_back(static_cast<uint32_t>(edges.size()));
+        edges.insert(edges.end(), nodeEdges[id].begin(), nodeEdges[id].end());
+    }
+    edgeStart.push_back(static_cast<uint32_t>(edges.size()));
+
+    ChunkedMapHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = FORMAT_VERSION;
+    header.width = static_cast<uint32_t>(w);
+    header.height = static_cast<uint32_t>(h);
+    header.chunkSize = static_cast<uint32_t>(size);
+    header.dictionarySize = static_cast<uint32_t>(dictionary.size());
+    header.nodeCount = static_cast<uint32_t>(nodeCells.size());
+    header.edgeCount = static_cast<uint32_t>(edges.size());
+
+    std::ofstream fout(filePath, std::ios::binary);
+    if (!fout) {
+        std::cerr << "Error opening file for writing: " << filePath << std::endl;
+        return false;
+    }
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeArray(fout, dictionary);
+    writeArray(fout, costs);
+    writeArray(fout, nodeData);
+    writeArray(fout, chunkNodeStart);
+    writeArray(fout, edgeStart);
+    writeArray(fout, edges);
+    std::vector<uint16_t> tiles;
+    for (int k = 0; k < chunkCount; ++k) {
+        int r0, c0, r1, c1;
+        layout.chunkBounds(k, r0, c0, r1, c1);
+        tiles.clear();
+        for (int r = r0; r < r1; ++r) {
+            tiles.insert(tiles.end(), map.tileRow(r) + c0, map.tileRow(r) + c1);
+        }
+        writeArray(fout, tiles);
+    }
+    if (!fout) {
+        std::cerr << "Error writing file: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a world file and reads its index.
+ *
+ * @param filePath Source path.
+ * @return True on success; errors are reported on std::cerr.
+ */
+bool ChunkedMap::open(const std::string& filePath)
+{
+    auto mapped = std::make_unique<MappedFile>();
+    if (!mapped->open(filePath)) {
+        std::cerr << "Error opening file: " << filePath << std::endl;
+        return false;
+    }
+
+    ChunkedMapHeader header;
+    if (mapped->size() < sizeof(header)) {
+        std::cerr << "Invalid chunked map: file too small" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, mapped->data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Invalid chunked map: bad magic" << std::endl;
+        return false;
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        std::cerr << "Invalid chunked map: written with a different byte order" << std::endl;
+        return false;
+    }
+    if (header.version != FORMAT_VERSION) {
+        std::cerr << "Unsupported chunked map version: " << header.version << std::endl;
+        return false;
+    }
+    if (header.width == 0 || header.height == 0 || header.chunkSize < 4 ||
+        header.chunkSize > uint32_t(std::numeric_limits<int>::max() / 2) ||
+        header.width > uint32_t(std::numeric_limits<int>::max() / 2) ||
+        header.height > uint32_t(std::numeric_limits<int>::max() / 2) ||
+        header.dictionarySize == 0 ||
+        header.dictionarySize > uint32_t(std::numeric_limits<uint16_t>::max()) + 1) {
+        std::cerr << "Invalid chunked map header" << std::endl;
+        return false;
+    }
+
+    ChunkedMap loaded;
+    loaded.width = static_cast<int>(header.width);
+    loaded.height = static_cast<int>(header.height);
+    loaded.chunkSize = static_cast<int>(header.chunkSize);
+    loaded.chunksX = static_cast<int>((uint64_t(header.width) + header.chunkSize - 1) / header.chunkSize);
+    loaded.chunksY = static_cast<int>((uint64_t(header.height) + header.chunkSize - 1) / header.chunkSize);
+    const size_t chunkCount = static_cast<size_t>(loaded.chunksX) * loaded.chunksY;
+
+    size_t offset = sizeof(header);
+    std::vector<int32_t> nodeData;
+    if (!readArray(*mapped, offset, header.dictionarySize, loaded.dictionary) ||
+        !readArray(*mapped, offset, header.dictionarySize, loaded.costs) ||
+        !readArray(*mapped, offset, size_t(header.nodeCount) * 2, nodeData) ||
+        !readArray(*mapped, offset, chunkCount + 1, loaded.chunkNodeStart) ||
+        !readArray(*mapped, offset, size_t(header.nodeCount) + 1, loaded.edgeStart) ||
+        !readArray(*mapped, offset, header.edgeCount, loaded.edges)) {
+        std::cerr << "Invalid chunked map: truncated index" << std::endl;
+        return false;
+    }
+
+    // Tiles follow the index, chunk after chunk
+    loaded.tileOffsets.resize(chunkCount);
+    for (size_t k = 0; k < chunkCount; ++k) {
+        int r0, c0, r1, c1;
+        loaded.chunkBounds(static_cast<int>(k), r0, c0, r1, c1);
+        loaded.tileOffsets[k] = offset;
+        offset += static_cast<size_t>(r1 - r0) * (c1 - c0) * sizeof(uint16_t);
+    }
+    if (offset != mapped->size()) {
+        std::cerr << "Invalid chunked map: tile data size mismatch" << std::endl;
+        return false;
+    }
+
+    // The graph must be consistent with the geometry
+    bool valid = loaded.chunkNodeStart.front() == 0 &&
+                 loaded.chunkNodeStart.back() == header.nodeCount &&
+                 loaded.edgeStart.front() == 0 && loaded.edgeStart.back() == header.edgeCount;
+    for (size_t k = 0; valid && k < chunkCount; ++k) {
+        valid = loaded.chunkNodeStart[k] <= loaded.chunkNodeStart[k + 1];
+        for (uint32_t id = loaded.chunkNodeStart[k]; valid && id < loaded.chunkNodeStart[k + 1]; ++id) {
+            int r = nodeData[2 * id], c = nodeData[2 * id + 1];
+            valid = r >= 0 && r < loaded.height && c >= 0 && c < loaded.width &&
+                    loaded.chunkOf(r, c) == static_cast<int>(k);
+            loaded.nodeCells.push_back({r, c});
+        }
+    }
+    for (size_t id = 0; valid && id < header.nodeCount; ++id) {
+        valid = loaded.edgeStart[id] <= loaded.edgeStart[id + 1];
+    }
+    for (size_t e = 0; valid && e < loaded.edges.size(); ++e) {
+        valid = loaded.edges[e].to < header.nodeCount && loaded.edges[e].cost > 0.0f;
+    }
+    if (!valid) {
+        std::cerr << "Invalid chunked map: corrupt abstract graph" << std::endl;
+        return false;
+    }
+
+    loaded.minStepCost = std::numeric_limits<double>::infinity();
+    for (double cost : loaded.costs) {
+        if (cost > 0.0 && cost < loaded.minStepCost) {
+            loaded.minStepCost = cost;
+        }
+    }
+    if (loaded.minStepCost == std::numeric_limits<double>::infinity()) {
+        loaded.minStepCost = 1.0;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    file = std::move(mapped);
+    width = loaded.width;
+    height = loaded.height;
+    chunkSize = loaded.chunkSize;
+    chunksX = loaded.chunksX;
+    chunksY = loaded.chunksY;
+    dictionary = std::move(loaded.dictionary);
+    costs = std::move(loaded.costs);
+    minStepCost = loaded.minStepCost;
+    nodeCells = std::move(loaded.nodeCells);
+    chunkNodeStart = std::move(loaded.chunkNodeStart);
+    edgeStart = std::move(loaded.edgeStart);
+    edges = std::move(loaded.edges);
+    tileOffsets = std::move(loaded.tileOffsets);
+    cache.clear();
+    lruOrder.clear();
+    stats = Stats();
+    return true;
+}
+
+/**
+ * @brief Cell bounds of a chunk: rows [r0, r1), columns [c0, c1).
+ */
+void ChunkedMap::chunkBounds(int chunk, int& r0, int& c0, int& r1, int& c1) const
+{
+    r0 = (chunk / chunksX) * chunkSize;
+    c0 = (chunk % chunksX) * chunkSize;
+    r1 = std::min(r0 + chunkSize, height);
+    c1 = std::min(c0 + chunkSize, width);
+}
+
+/**
+ * @brief Returns a chunk, decoding it from the file on a cache miss.
+ *
+ * Decoding happens outside the cache lock, so threads loading different
+ * chunks do not wait for each other; if two load the same chunk at once,
+ * the first one stored wins.
+ */
+std::shared_ptr<const Map> ChunkedMap::getChunk(int chunk) const
+{
+    if (!file || chunk < 0 || chunk >= getChunkCount()) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto found = cache.find(chunk);
+        if (found != cache.end()) {
+            lruOrder.splice(lruOrder.begin(), lruOrder, found->second.position);
+            return found->second.map;
+        }
+    }
+
+    int r0, c0, r1, c1;
+    chunkBounds(chunk, r0, c0, r1, c1);
+    size_t cellCount = static_cast<size_t>(r1 - r0) * (c1 - c0);
+    std::vector<uint16_t> ids(cellCount);
+    std::memcpy(ids.data(), file->data() + tileOffsets[chunk], cellCount * sizeof(uint16_t));
+    std::vector<double> values(cellCount);
+    for (size_t i = 0; i < cellCount; ++i) {
+        if (ids[i] >= dictionary.size()) {
+            std::cerr << "Invalid chunked map: bad tile id in chunk " << chunk << std::endl;
+            return nullptr;
+        }
+        values[i] = dictionary[ids[i]];
+    }
+    auto map = std::make_shared<Map>();
+    if (!buildChunk(values, c1 - c0, r1 - r0, dictionary, costs, *map)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto found = cache.find(chunk);
+    if (found != cache.end()) {
+        lruOrder.splice(lruOrder.begin(), lruOrder, found->second.position);
+        return found->second.map;
+    }
+    ++stats.loads;
+    insertChunk(chunk, map);
+    return map;
+}
+
+/**
+ * @brief Adds a chunk at the front of the LRU list (cache lock held).
+ */
+void ChunkedMap::insertChunk(int chunk, std::shared_ptr<const Map> map) const
+{
+    lruOrder.push_front(chunk);
+    cache[chunk] = CacheEntry{std::move(map), lruOrder.begin()};
+    evictToLimit();
+}
+
+/**
+ * @brief Evicts least recently used chunks beyond the limit (cache lock held).
+ */
+void ChunkedMap::evictToLimit() const
+{
+    while (cache.size() > residentLimit) {
+        cache.erase(lruOrder.back());
+        lruOrder.pop_back();
+        ++stats.evictions;
+    }
+}
+
+/**
+ * @brief Sets how many chunks may stay loaded.
+ */
+void ChunkedMap::setResidentLimit(size_t limit)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    residentLimit = std::max<size_t>(1, limit);
+    evictToLimit();
+}
+
+/**
+ * @return Chunks currently held by the cache.
+ */
+size_t ChunkedMap::getResidentCount() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cache.size();
+}
+
+/**
+ * @return Cache counters since open().
+ */
+ChunkedMap::Stats ChunkedMap::getStats() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return stats;
+}
+
+/**
+ * @return True if the cell is inside the world and passable.
+ */
+bool ChunkedMap::isPassable(int r, int c) const
+{
+    if (r < 0 || r >= height || c < 0 || c >= width) {
+        return false;
+    }
+    int chunk = chunkOf(r, c);
+    std::shared_ptr<const Map> map = getChunk(chunk);
+    int r0, c0, r1, c1;
+    chunkBounds(chunk, r0, c0, r1, c1);
+    return map && map->isPassable(r - r0, c - c0);
+}
+
+/**
+ * @brief Finds a path in world coordinates through the abstract graph.
+ *
+ * A start and goal in the same chunk are first joined by a search inside
+ * that chunk; only if that fails does the query leave the chunk.
+ *
+ * @param context Scratch buffers for the searches.
+ * @return        Cells from start to goal; empty if none was found.
+ */
+std::vector<std::pair<int, int>> ChunkedMap::findPath(SearchContext& context,
+                                                      int startRow, int startCol,
+                                                      int goalRow, int goalCol) const
+{
+    std::vector<std::pair<int, int>> path;
+    if (!isPassable(startRow, startCol) || !isPassable(goalRow, goalCol)) {
+        return path;
+    }
+    if (startRow == goalRow && startCol == goalCol) {
+        path.push_back({startRow, startCol});
+        return path;
+    }
+
+    const int startChunk = chunkOf(startRow, startCol);
+    const int goalChunk = chunkOf(goalRow, goalCol);
+    std::shared_ptr<const Map> startMap = getChunk(startChunk);
+    std::shared_ptr<const Map> goalMap = getChunk(goalChunk);
+    if (!startMap || !goalMap) {
+        return path;
+    }
+    int sr0, sc0, sr1, sc1, gr0, gc0, gr1, gc1;
+    chunkBounds(startChunk, sr0, sc0, sr1, sc1);
+    chunkBounds(goalChunk, gr0, gc0, gr1, gc1);
+
+    // Chunk-local search between two cells of one chunk, in world coordinates
+    auto localPath = [&](int chunk, const Map& chunkMap, std::pair<int, int> from,
+                         std::pair<int, int> to) {
+        int r0, c0, r1, c1;
+        chunkBounds(chunk, r0, c0, r1, c1);
+        std::vector<std::pair<int, int>> cells =
+            Pathfinding::aStar(chunkMap, context, from.first - r0, from.second - c0,
+                               to.first - r0, to.second - c0, SearchOptions());
+        for (auto& cell : cells) {
+            cell.first += r0;
+            cell.second += c0;
+        }
+        return cells;
+    };
+
+    if (startChunk == goalChunk) {
+        path = localPath(startChunk, *startMap, {startRow, startCol}, {goalRow, goalCol});
+        if (!path.empty()) {
+            return path;
+        }
+    }
+
+    // Link the start and goal to the entrances of their chunks
+    auto chunkNodes = [&](int chunk, int r0, int c0) {
+        std::vector<std::pair<int, int>> local;
+        for (uint32_t id = chunkNodeStart[chunk]; id < chunkNodeStart[chunk + 1]; ++id) {
+            local.push_back({nodeCells[id].first - r0, nodeCells[id].second - c0});
+        }
+        return local;
+    };
+    std::vector<std::pair<int, int>> startNodes = chunkNodes(startChunk, sr0, sc0);
+    std::vector<std::pair<int, int>> goalNodes = chunkNodes(goalChunk, gr0, gc0);
+    std::vector<double> startLinks(startNodes.size());
+    std::vector<double> goalLinks(goalNodes.size());  // Cost from each node to the goal
+    Pathfinding::distancesFrom(*startMap, context, startRow - sr0, startCol - sc0,
+                               startNodes, startLinks.data());
+    Pathfinding::distancesFrom(*goalMap, context, goalRow - gr0, goalCol - gc0,
+                               goalNodes, goalLinks.data(), true);
+
+    // Abstract A* over node ids (plus the two virtual nodes)
+    const int nodeCount = getAbstractNodeCount();
+    const int START = nodeCount;      // Virtual abstract node for the start
+    const int GOAL  = nodeCount + 1;  // Virtual abstract node for the goal
+    auto heuristic = [&](int id) {
+        if (id == GOAL) {
+            return 0.0;
+        }
+        int r = id == START ? startRow : nodeCells[id].first;
+        int c = id == START ? startCol : nodeCells[id].second;
+        return minStepCost * (std::abs(r - goalRow) + std::abs(c - goalCol));
+    };
+
+    context.reset(nodeCount + 2);
+    using Entry = std::pair<double, int>;  // (fCost, node id)
+    std::vector<Entry> open;
+    auto later = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+    auto relax = [&](int from, int to, double cost) {
+        double g = context.gCost(from) + cost;
+        if (g < context.gCost(to)) {
+            context.update(to, g, from);
+            open.push_back({g + heuristic(to), to});
+            std::push_heap(open.begin(), open.end(), later);
+        }
+    };
+
+    context.update(START, 0.0, -1);
+    open.push_back({heuristic(START), START});
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), later);
+        Entry top = open.back();
+        open.pop_back();
+        int id = top.second;
+        if (top.first > context.gCost(id) + heuristic(id)) {
+            continue;  // Stale entry
+        }
+        if (id == GOAL) {
+            found = true;
+            break;
+        }
+        if (id == START) {
+            for (size_t i = 0; i < startNodes.size(); ++i) {
+                if (startLinks[i] != Pathfinding::UNREACHABLE_DISTANCE) {
+                    relax(START, static_cast<int>(chunkNodeStart[startChunk] + i), startLinks[i]);
+                }
+            }
+            continue;
+        }
+        for (uint32_t e = edgeStart[id]; e < edgeStart[id + 1]; ++e) {
+            relax(id, static_cast<int>(edges[e].to), edges[e].cost);
+        }
+        if (chunkOf(nodeCells[id].first, nodeCells[id].second) == goalChunk) {
+            double link = goalLinks[id - chunkNodeStart[goalChunk]];
+            if (link != Pathfinding::UNREACHABLE_DISTANCE) {
+                relax(id, GOAL, link);
+            }
+        }
+    }
+    if (!found) {
+        return path;
+    }
+
+    // Abstract route, from the start
+    std::vector<std::pair<int, int>> waypoints;
+    for (int id = GOAL; id != -1; id = context.parent(id)) {
+        waypoints.push_back(id == GOAL    ? std::make_pair(goalRow, goalCol)
+                            : id == START ? std::make_pair(startRow, startCol)
+                                          : nodeCells[id]);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // Refine: border crossings are single steps, the rest stay in one chunk
+    path.push_back(waypoints.front());
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const auto& from = waypoints[i - 1];
+        const auto& to = waypoints[i];
+        int fromChunk = chunkOf(from.first, from.second);
+        if (from == to) {
+            continue;
+        }
+        if (fromChunk != chunkOf(to.first, to.second)) {
+            path.push_back(to);
+            continue;
+        }
+        std::shared_ptr<const Map> chunkMap = getChunk(fromChunk);
+        std::vector<std::pair<int, int>> leg =
+            chunkMap ? localPath(fromChunk, *chunkMap, from, to) : std::vector<std::pair<int, int>>();
+        if (leg.empty()) {
+            path.clear();  // Only possible with a corrupt index
+            return path;
+        }
+        path.insert(path.end(), leg.begin() + 1, leg.end());
+    }
+    return path;
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+/******************************************************************************
+ * File:    ChunkedMap.h
+ *
+ * Overview:
+ *   This header declares the ChunkedMap class, a world too large to hold
+ *   as one Map, split into fixed-size square chunks (the last row and
+ *   column of chunks may be smaller) that are loaded only when needed.
+ *
+ *   A ".rtsworld" file is written once from a Map by write(). Opening it
+ *   memory-maps the file and reads only its small index; the tiles of a
+ *   chunk are decoded into a Map of their own on first use and evicted
+ *   again, least recently used first, once more than the resident limit
+ *   are loaded. Pages of chunks that are never touched are never read.
+ *
+ *   Searches are hierarchical, like HierarchicalPathfinder with chunks as
+ *   clusters. The file stores the abstract graph: entrance nodes on each
+ *   chunk border (one per short run of cells open on both sides; at each
+ *   end of a long run and every few cells between), unit-step edges across
+ *   borders and the exact in-chunk costs between the entrances of a chunk.
+ *   A query links start and goal into that graph, searches it, and refines
+ *   each abstract edge with an A* confined to one chunk, so only the chunks
+ *   along the route are ever loaded.
+ *
+ *   Everything a chunk contributes to the index depends on that chunk
+ *   alone (plus the border cells of its neighbors), which is what lets
+ *   write() build chunks on separate cores, and what would let separate
+ *   servers own separate regions of the world.
+ *
+ *   File layout (host byte order, see ChunkedMapHeader):
+ *
+ *     Header        40 bytes
+ *     Dictionary    double[dictionarySize], distinct tile values
+ *     Costs         double[dictionarySize], terrain cost of each value
+ *     Nodes         int32[2 * nodeCount], (row, col), ordered by chunk
+ *     Chunk nodes   uint32[chunkCount + 1], first node of each chunk
+ *     Edge starts   uint32[nodeCount + 1], first edge of each node
+ *     Edges         (uint32 target, float cost)[edgeCount]
+ *     Tiles         uint16 tile ids, chunk by chunk, each row-major
+ *
+ *   The world is read-only; costs and passability are those of the Map
+ *   when it was written. Queries are 4-connected, cost the terrain cost
+ *   of each cell entered, and may be slightly longer than optimal.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "MappedFile.h"
+#include "SearchContext.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Fixed-size header at the start of every ".rtsworld" file.
+ */
+struct ChunkedMapHeader {
+    char     magic[4];        ///< "RTSW"
+    uint32_t byteOrder;       ///< ChunkedMap::BYTE_ORDER_MARK as written by the host
+    uint16_t version;         ///< ChunkedMap::FORMAT_VERSION
+    uint16_t flags;           ///< Reserved; 0
+    uint32_t width;           ///< Number of columns of the world
+    uint32_t height;          ///< Number of rows of the world
+    uint32_t chunkSize;       ///< Side length of a chunk, in cells
+    uint32_t dictionarySize;  ///< Number of distinct tile values
+    uint32_t nodeCount;       ///< Entrance nodes of the abstract graph
+    uint32_t edgeCount;       ///< Directed edges of the abstract graph
+    uint32_t reserved;        ///< 0
+};
+
+/**
+ * @class ChunkedMap
+ *
+ * @brief Lazily loaded, chunked world with hierarchical path queries.
+ *
+ * Queries are const and may run concurrently, each with its own
+ * SearchContext; the chunk cache is shared and guarded by a mutex.
+ */
+class ChunkedMap {
+public:
+    static constexpr int DEFAULT_CHUNK_SIZE = 64;
+    static constexpr size_t DEFAULT_RESIDENT_LIMIT = 64;
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /**
+     * @brief Counters of the chunk cache since open().
+     */
+    struct Stats {
+        size_t loads = 0;      ///< Chunks decoded from the file
+        size_t evictions = 0;  ///< Chunks dropped to respect the resident limit
+    };
+
+    /**
+     * @brief Splits a map into chunks and writes it with its abstract graph.
+     *
+     * @param map         Map to write; its terrain costs are stored too.
+     * @param filePath    Destination (conventionally ending in ".rtsworld").
+     * @param chunkSize   Side length of a chunk, in cells (at least 4).
+     * @param threadCount Threads building the chunks; 0 = hardware concurrency.
+     * @return True on success; errors are reported on std::cerr.
+     */
+    static bool write(const Map& map, const std::string& filePath,
+                      int chunkSize = DEFAULT_CHUNK_SIZE, unsigned threadCount = 0);
+
+    /**
+     * @return True if the path has the chunked world extension (".rtsworld").
+     */
+    static bool isChunkedMapPath(const std::string& filePath);
+
+    /**
+     * @brief Opens a world file; no chunk is loaded yet.
+     *
+     * On failure the previously open world (if any) stays open.
+     *
+     * @return True on success; errors are reported on std::cerr.
+     */
+    bool open(const std::string& filePath);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getChunkSize() const { return chunkSize; }
+    int getChunksX() const { return chunksX; }
+    int getChunksY() const { return chunksY; }
+    int getChunkCount() const { return chunksX * chunksY; }
+
+    /**
+     * @return Chunk id of an in-bounds cell (row-major over chunks).
+     */
+    int chunkOf(int r, int c) const { return (r / chunkSize) * chunksX + c / chunkSize; }
+
+    /**
+     * @brief Cell bounds of a chunk: rows [r0, r1), columns [c0, c1).
+     */
+    void chunkBounds(int chunk, int& r0, int& c0, int& r1, int& c1) const;
+
+    /**
+     * @brief Returns a chunk as a Map in chunk-local coordinates, loading it
+     *        if needed.
+     *
+     * The chunk stays valid while the pointer is held, even if the cache
+     * evicts it meanwhile.
+     *
+     * @return The chunk, or nullptr if the id is out of range or its data are
+     *         corrupt.
+     */
+    std::shared_ptr<const Map> getChunk(int chunk) const;
+
+    /**
+     * @return True if the cell is inside the world and passable. Loads its
+     *         chunk.
+     */
+    bool isPassable(int r, int c) const;
+
+    /**
+     * @brief Finds a path in world coordinates.
+     *
+     * Unlike Pathfinding::aStar, the start must be passable too.
+     *
+     * @param context Scratch buffers for the chunk-local searches.
+     * @return        Cells from start to goal; empty if none was found.
+     */
+    std::vector<std::pair<int, int>> findPath(SearchContext& context,
+                                              int startRow, int startCol,
+                                              int goalRow, int goalCol) const;
+
+    /**
+     * @brief Sets how many chunks may stay loaded (at least 1); extra ones
+     *        are evicted at once.
+     */
+    void setResidentLimit(size_t limit);
+
+    /**
+     * @return Chunks currently held by the cache.
+     */
+    size_t getResidentCount() const;
+
+    /**
+     * @return Cache counters since open().
+     */
+    Stats getStats() const;
+
+    /**
+     * @return Entrance nodes of the abstract graph.
+     */
+    int getAbstractNodeCount() const { return static_cast<int>(nodeCells.size()); }
+
+private:
+    /**
+     * @brief Directed abstract graph edge.
+     */
+    struct Edge {
+        uint32_t to;  // Target node id
+        float cost;   // Path cost, as Map::stepCost sums
+    };
+
+    // Builds the Map of one chunk from its tile values and the world's costs
+    static bool buildChunk(const std::vector<double>& values, int chunkWidth, int chunkHeight,
+                           const std::vector<double>& dictionary,
+                           const std::vector<double>& costs, Map& chunk);
+
+    // Inserts a loaded chunk, evicting the least recently used ones (lock held)
+    void insertChunk(int chunk, std::shared_ptr<const Map> map) const;
+
+    // Drops chunks from the back of the LRU list until the limit holds (lock held)
+    void evictToLimit() const;
+
+    std::unique_ptr<MappedFile> file;
+    int width = 0, height = 0;
+    int chunkSize = DEFAULT_CHUNK_SIZE;
+    int chunksX = 0, chunksY = 0;
+    std::vector<double> dictionary;             // Tile value per tile id
+    std::vector<double> costs;                  // Terrain cost per tile id
+    double minStepCost = 1.0;                   // Smallest finite cost, for the heuristic
+    std::vector<std::pair<int, int>> nodeCells; // World cell per node, ordered by chunk
+    std::vector<uint32_t> chunkNodeStart;       // [chunkCount + 1]
+    std::vector<uint32_t> edgeStart;            // [nodeCount + 1]
+    std::vector<Edge> edges;
+    std::vector<size_t> tileOffsets;            // File offset of each chunk's tiles
+
+    // Chunk cache: most recently used at the front of lruOrder
+    mutable std::mutex cacheMutex;
+    mutable std::list<int> lruOrder;
+    struct CacheEntry {
+        std::shared_ptr<const Map> map;
+        std::list<int>::iterator position;
+    };
+    mutable std::unordered_map<int, CacheEntry> cache;
+    size_t residentLimit = DEFAULT_RESIDENT_LIMIT;
+    mutable Stats stats;
+};
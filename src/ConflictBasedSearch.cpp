@@ -0,0 +1,391 @@
+/******************************************************************************
+ * File:    ConflictBasedSearch.cpp
+ *
+ * Overview:
+ *   Implementation of the ConflictBasedSearch class.
+ *
+ *   Highlights:
+ *   - A high-level node stores only the constraint it adds; the full set of
+ *     an agent's constraints is gathered by walking up to the root.
+ *   - Paths of expanded nodes are released, since only open nodes and the
+ *     best-effort fallback still need them.
+ *   - The low-level conflict count reads a per-search table of the other
+ *     agents' (cell, time) positions and moves, including agents parked on
+ *     their goal after arriving.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "ConflictBasedSearch.h"
+#include "Pathfinding.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+using Path = std::vector<std::pair<int, int>>;
+
+// Position of an agent at time t; agents wait on their goal after arriving
+const std::pair<int, int>& positionAt(const Path& path, int t)
+{
+    return path[std::min<size_t>(static_cast<size_t>(t), path.size() - 1)];
+}
+
+int pathCost(const Path& path)
+{
+    return static_cast<int>(path.size()) - 1;
+}
+
+struct Conflict {
+    int a = -1, b = -1;
+    int time = 0;                 // Vertex: time at the cell; edge: departure time
+    std::pair<int, int> cellA;    // Where a is (vertex) or leaves from (edge)
+    std::pair<int, int> cellB;    // Where b leaves from (edge)
+    bool edge = false;
+};
+
+// Finds the earliest conflict between any two paths; counts all of them
+int findConflicts(const std::vector<Path>& paths, Conflict* first)
+{
+    int count = 0;
+    int earliest = -1;
+    size_t horizon = 0;
+    for (const Path& p : paths) {
+        horizon = std::max(horizon, p.size());
+    }
+    for (size_t a = 0; a < paths.size(); ++a) {
+        for (size_t b = a + 1; b < paths.size(); ++b) {
+            for (int t = 0; t < static_cast<int>(horizon); ++t) {
+                const auto& pa = positionAt(paths[a], t);
+                const auto& pb = positionAt(paths[b], t);
+                bool vertex = pa == pb;
+                bool swap = false;
+                if (!vertex && t + 1 < static_cast<int>(horizon)) {
+                    swap = positionAt(paths[a], t + 1) == pb &&
+                           positionAt(paths[b], t + 1) == pa;
+                }
+                if (!vertex && !swap) {
+                    continue;
+                }
+                ++count;
+                if (first && (earliest < 0 || t < earliest)) {
+                    earliest = t;
+                    first->a = static_cast<int>(a);
+                    first->b = static_cast<int>(b);
+                    first->time = t;
+                    first->cellA = pa;
+                    first->cellB = pb;
+                    first->edge = swap;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// (cell, time) positions and moves of all agents but one
+class ConflictTable {
+public:
+    ConflictTable(const std::vector<Path>& paths, int skip, int width) : width(width)
+    {
+        for (size_t j = 0; j < paths.size(); ++j) {
+            const Path& path = paths[j];
+            if (static_cast<int>(j) == skip || path.empty()) {
+                continue;
+            }
+            for (size_t t = 0; t < path.size(); ++t) {
+                ++positions[key(cellOf(path[t]), static_cast<int>(t))];
+                if (t + 1 < path.size()) {
+                    ++moves[moveKey(cellOf(path[t]), cellOf(path[t + 1]), static_cast<int>(t))];
+                }
+            }
+            parked.push_back({cellOf(path.back()), pathCost(path) + 1});
+        }
+    }
+
+    // Conflicts of stepping from (pr, pc) onto (r, c), arriving at time
+    int count(int r, int c, int pr, int pc, int time) const
+    {
+        int cell = r * width + c;
+        int n = 0;
+        auto it = positions.find(key(cell, time));
+        if (it != positions.end()) {
+            n += it->second;
+        }
+        for (const auto& p : parked) {
+            n += p.first == cell && time >= p.second;
+        }
+        auto mt = moves.find(moveKey(cell, pr * width + pc, time - 1));
+        if (mt != moves.end()) {
+            n += mt->second;
+        }
+        return n;
+    }
+
+private:
+    static uint64_t key(int cell, int time)
+    {
+        return (uint64_t(uint32_t(time)) << 32) | uint32_t(cell);
+    }
+
+    static uint64_t moveKey(int from, int to, int time)
+    {
+        return key(from, time) ^ (uint64_t(uint32_t(to)) * 0x9E3779B97F4A7C15ull);
+    }
+
+    int cellOf(const std::pair<int, int>& p) const { return p.first * width + p.second; }
+
+    int width;
+    std::unordered_map<uint64_t, int> positions;
+    std::unordered_map<uint64_t, int> moves;
+    std::vector<std::pair<int, int>> parked;  // (cell, first parked time)
+};
+
+struct TreeNode {
+    int parent;
+    int agent;                 // Agent constrained by this node (-1 at the root)
+    TimeConstraint constraint;
+    std::vector<Path> paths;
+    std::vector<int> lowerBounds;
+    int cost = 0;
+    int lowerBound = 0;
+    int conflicts = 0;
+};
+
+} // namespace
+
+/**
+ * @brief Plans a squad jointly with ECBS.
+ *
+ * @param map     Reference to the Map object.
+ * @param squad   Start and goal of every agent.
+ * @param options Suboptimality and budgets.
+ * @return        Paths and status.
+ */
+ConflictBasedSearch::Result ConflictBasedSearch::solve(const Map& map, const Squad& squad,
+                                                       const Options& options)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point started = Clock::now();
+    const double w = std::max(1.0, options.suboptimality);
+    const size_t agentCount = std::min(squad.starts.size(), squad.goals.size());
+    const int width = map.getWidth();
+
+    Result result;
+    if (agentCount == 0) {
+        result.status = Status::Solved;
+        return result;
+    }
+
+    // Low-level search of one agent under the constraints of a node
+    std::vector<TreeNode> nodes;
+    auto plan = [&](const std::vector<TimeConstraint>& constraints,
+                    const std::vector<Path>& paths, size_t agent, int& lowerBound) {
+        SpaceTimeQuery query;
+        query.startRow = squad.starts[agent].first;
+        query.startCol = squad.starts[agent].second;
+        query.goalRow = squad.goals[agent].first;
+        query.goalCol = squad.goals[agent].second;
+        query.constraints = constraints;
+        query.focalWeight = w;
+        query.maxExpansions = options.maxLowLevelExpansions;
+        ConflictTable table(paths, static_cast<int>(agent), width);
+        query.conflictCount = [&table](int r, int c, int pr, int pc, int time) {
+            return table.count(r, c, pr, pc, time);
+        };
+        return Pathfinding::spaceTimeAStar(map, query, &lowerBound);
+    };
+    auto constraintsOf = [&](int node, size_t agent) {
+        std::vector<TimeConstraint> constraints;
+        for (int n = node; n >= 0; n = nodes[n].parent) {
+            if (nodes[n].agent == static_cast<int>(agent)) {
+                constraints.push_back(nodes[n].constraint);
+            }
+        }
+        return constraints;
+    };
+    auto finishNode = [&](TreeNode& node) {
+        node.cost = 0;
+        node.lowerBound = 0;
+        for (size_t i = 0; i < agentCount; ++i) {
+            node.cost += pathCost(node.paths[i]);
+            node.lowerBound += node.lowerBounds[i];
+        }
+        node.conflicts = findConflicts(node.paths, nullptr);
+    };
+
+    // Root: each agent avoids the ones planned before it where it can
+    TreeNode root;
+    root.parent = -1;
+    root.agent = -1;
+    root.constraint = TimeConstraint{0, 0, 0};
+    root.paths.resize(agentCount);
+    root.lowerBounds.resize(agentCount, 0);
+    for (size_t i = 0; i < agentCount; ++i) {
+        root.paths[i] = plan({}, root.paths, i, root.lowerBounds[i]);
+        if (root.paths[i].empty()) {
+            return result;  // NoSolution
+        }
+    }
+    finishNode(root);
+    nodes.push_back(std::move(root));
+
+    // OPEN by (lower bound, id); the same nodes by (cost, id) to refill
+    // FOCAL, which orders the nodes within w of the best bound by conflicts
+    std::set<std::pair<int, int>> open, openByCost;
+    std::set<std::tuple<int, int, int>> focal;
+    auto focalBound = [&](int lb) {
+        return static_cast<int>(std::floor(lb * w + 1e-9));
+    };
+    int bestBound = nodes[0].lowerBound;
+    auto push = [&](int id) {
+        const TreeNode& node = nodes[id];
+        open.insert({node.lowerBound, id});
+        openByCost.insert({node.cost, id});
+        if (node.cost <= focalBound(bestBound)) {
+            focal.insert({node.conflicts, node.cost, id});
+        }
+    };
+    push(0);
+
+    int bestEffort = 0;  // Fewest conflicts seen, for an early exit
+    Status exitStatus = Status::NoSolution;
+    int solved = -1;
+    while (!open.empty()) {
+        // Raise the bound to the best open node and admit what it allows
+        int lowest = open.begin()->first;
+        if (lowest > bestBound) {
+            int oldBound = focalBound(bestBound);
+            bestBound = lowest;
+            for (auto it = openByCost.upper_bound({oldBound, std::numeric_limits<int>::max()});
+                 it != openByCost.end() && it->first <= focalBound(bestBound); ++it) {
+                focal.insert({nodes[it->second].conflicts, it->first, it->second});
+            }
+        }
+
+        if (result.nodesExpanded >= options.maxNodes) {
+            exitStatus = Status::NodeBudgetExceeded;
+            break;
+        }
+        if (options.timeLimitMs > 0 &&
+            std::chrono::duration<double, std::milli>(Clock::now() - started).count() >=
+                options.timeLimitMs) {
+            exitStatus = Status::DeadlineExceeded;
+            break;
+        }
+
+        int id = focal.empty() ? open.begin()->second : std::get<2>(*focal.begin());
+        focal.erase({nodes[id].conflicts, nodes[id].cost, id});
+        open.erase({nodes[id].lowerBound, id});
+        openByCost.erase({nodes[id].cost, id});
+
+        Conflict conflict;
+        if (findConflicts(nodes[id].paths, &conflict) == 0) {
+            solved = id;
+            break;
+        }
+        ++result.nodesExpanded;
+
+        // One child per side of the conflict
+        for (int side = 0; side < 2; ++side) {
+            int agent = side == 0 ? conflict.a : conflict.b;
+            TimeConstraint constraint;
+            if (!conflict.edge) {
+                constraint = {conflict.cellA.first, conflict.cellA.second, conflict.time};
+            } else {
+                const auto& from = side == 0 ? conflict.cellA : conflict.cellB;
+                const auto& to   = side == 0 ? conflict.cellB : conflict.cellA;
+                constraint = {from.first, from.second, conflict.time, to.first, to.second};
+            }
+
+            TreeNode child;
+            child.parent = id;
+            child.agent = agent;
+            child.constraint = constraint;
+            child.paths = nodes[id].paths;
+            child.lowerBounds = nodes[id].lowerBounds;
+
+            std::vector<TimeConstraint> constraints = constraintsOf(id, agent);
+            constraints.push_back(constraint);
+            int lowerBound = 0;
+            child.paths[agent] = plan(constraints, child.paths, agent, lowerBound);
+            if (child.paths[agent].empty()) {
+                continue;
+            }
+            // More constraints never make the agent cheaper
+            child.lowerBounds[agent] = std::max(child.lowerBounds[agent], lowerBound);
+            finishNode(child);
+            nodes.push_back(std::move(child));
+            int childId = static_cast<int>(nodes.size()) - 1;
+            if (nodes[childId].conflicts < nodes[bestEffort].conflicts) {
+                bestEffort = childId;
+            }
+            push(childId);
+        }
+
+        if (id != bestEffort) {
+            // Expanded; children hold their own copies
+            nodes[id].paths.clear();
+            nodes[id].paths.shrink_to_fit();
+        }
+    }
+
+    result.lowerBound = bestBound;
+    int chosen = solved;
+    if (solved >= 0) {
+        result.status = Status::Solved;
+    } else if (exitStatus != Status::NoSolution) {
+        result.status = exitStatus;
+        chosen = bestEffort;
+    } else {
+        return result;  // Every branch failed
+    }
+    result.paths = std::move(nodes[chosen].paths);
+    result.cost = nodes[chosen].cost;
+    result.conflicts = nodes[chosen].conflicts;
+    return result;
+}
+
+/**
+ * @brief Plans a squad jointly with the default Options.
+ */
+ConflictBasedSearch::Result ConflictBasedSearch::solve(const Map& map, const Squad& squad)
+{
+    return solve(map, squad, Options());
+}
+
+/**
+ * @brief Solves independent squads in parallel.
+ *
+ * @return One Result per squad, in order.
+ */
+std::vector<ConflictBasedSearch::Result> ConflictBasedSearch::solveBatch(
+    const Map& map, const std::vector<Squad>& squads, const Options& options, ThreadPool& pool)
+{
+    std::vector<Result> results(squads.size());
+    pool.parallelFor(squads.size(), [&](size_t i, unsigned) {
+        results[i] = solve(map, squads[i], options);
+    });
+    return results;
+}
+
+/**
+ * @return Lower-case name of a status, for logging.
+ */
+const char* ConflictBasedSearch::statusName(Status status)
+{
+    switch (status) {
+        case Status::Solved:             return "solved";
+        case Status::NoSolution:         return "no solution";
+        case Status::NodeBudgetExceeded: return "node budget exceeded";
+        case Status::DeadlineExceeded:   return "deadline exceeded";
+    }
+    return "unknown";
+}
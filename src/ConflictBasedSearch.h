@@ -0,0 +1,113 @@
+#pragma once
+
+/******************************************************************************
+ * File:    ConflictBasedSearch.h
+ *
+ * Overview:
+ *   This header declares the ConflictBasedSearch class, a joint planner for
+ *   small squads that must not collide. It implements Enhanced CBS (ECBS):
+ *
+ *   - The low level plans one agent at a time with
+ *     Pathfinding::spaceTimeAStar, honoring the time constraints collected
+ *     on the way to the current high-level node and preferring paths with
+ *     few conflicts against the squad's other paths.
+ *   - The high level searches a tree of constraint sets. Each node holds one
+ *     path per agent; the first vertex or swap conflict between two paths
+ *     is split into two children, each forbidding one of the agents from
+ *     the conflicting cell or move.
+ *   - With a suboptimality w > 1, both levels use a focal list: any node
+ *     whose cost is within w of the best lower bound may be expanded, and
+ *     the one with the fewest conflicts goes first. The returned cost is
+ *     at most w times the optimal sum of costs; w = 1 is plain CBS.
+ *
+ *   A node budget and a wall-clock deadline bound every solve. When either
+ *   runs out, the least-conflicted joint plan seen so far is returned, so
+ *   callers under load still get usable (if not collision-free) paths.
+ *
+ *   Agents stay on their goal after arriving; paths list one cell per time
+ *   step, so a repeated cell is a wait.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ConflictBasedSearch
+ *
+ * @brief Contains the static ECBS solver and its batched variant.
+ */
+class ConflictBasedSearch {
+public:
+    /**
+     * @brief Limits and quality settings of a solve.
+     */
+    struct Options {
+        double suboptimality = 1.0;        ///< Bound w >= 1 on cost / optimal cost
+        size_t maxNodes = 10000;           ///< High-level nodes expanded at most
+        double timeLimitMs = 50.0;         ///< Wall-clock deadline; 0 = none
+        size_t maxLowLevelExpansions = 200000; ///< Per low-level search
+    };
+
+    /**
+     * @brief One independent group of agents; starts[i] heads to goals[i].
+     */
+    struct Squad {
+        std::vector<std::pair<int, int>> starts;
+        std::vector<std::pair<int, int>> goals;
+    };
+
+    enum class Status {
+        Solved,              ///< Conflict-free within the suboptimality bound
+        NoSolution,          ///< Some agent cannot reach its goal at all
+        NodeBudgetExceeded,  ///< Best-effort paths; may still conflict
+        DeadlineExceeded     ///< Best-effort paths; may still conflict
+    };
+
+    struct Result {
+        Status status = Status::NoSolution;
+        std::vector<std::vector<std::pair<int, int>>> paths;  ///< Per agent; empty if unsolved
+        int cost = 0;           ///< Sum over agents of the arrival time
+        int lowerBound = 0;     ///< Lower bound on the optimal sum of costs
+        int conflicts = 0;      ///< Conflicts left in paths (0 when Solved)
+        size_t nodesExpanded = 0;
+    };
+
+    /**
+     * @brief Plans a squad jointly.
+     *
+     * @param map     Reference to the Map object.
+     * @param squad   Start and goal of every agent (same sizes).
+     * @param options Suboptimality and budgets.
+     * @return        Paths and status; see Status.
+     */
+    static Result solve(const Map& map, const Squad& squad, const Options& options);
+
+    /**
+     * @brief Plans a squad jointly with the default Options.
+     */
+    static Result solve(const Map& map, const Squad& squad);
+
+    /**
+     * @brief Solves independent squads in parallel on the given pool.
+     *
+     * Squads are assumed not to interact; each is solved as by solve(),
+     * with its own deadline.
+     *
+     * @return One Result per squad, in order.
+     */
+    static std::vector<Result> solveBatch(const Map& map,
+                                          const std::vector<Squad>& squads,
+                                          const Options& options,
+                                          ThreadPool& pool);
+
+    /**
+     * @return Lower-case name of a status, for logging.
+     */
+    static const char* statusName(Status status);
+};
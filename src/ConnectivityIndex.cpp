@@ -0,0 +1,252 @@
+/******************************************************************************
+ * File:    ConnectivityIndex.cpp
+ *
+ * Overview:
+ *   Implementation of the ConnectivityIndex class. After the initial
+ *   labeling, labels are compacted so every cell points straight at its
+ *   root; later merges and splits only touch the cells they must.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "ConnectivityIndex.h"
+#include "Map.h"
+#include <algorithm>
+
+/**
+ * @brief Labels every component of the map from scratch.
+ *
+ * @param map Map to label.
+ */
+void ConnectivityIndex::build(const Map& map)
+{
+    const int stride = map.getStride();
+    labels.assign(static_cast<size_t>(map.getPaddedCellCount()), NONE);
+    parents.clear();
+    sizes.clear();
+
+    // First pass: provisional labels from the upper and left neighbors
+    for (int r = 0; r < map.getHeight(); ++r) {
+        int idx = map.paddedIndex(r, 0);
+        for (int c = 0; c < map.getWidth(); ++c, ++idx) {
+            if (!map.passable(idx)) {
+                continue;
+            }
+            uint32_t up = labels[idx - stride];
+            uint32_t left = labels[idx - 1];
+            uint32_t root;
+            if (up == NONE && left == NONE) {
+                root = newLabel(0);
+            } else if (up == NONE) {
+                root = find(left);
+            } else if (left == NONE) {
+                root = find(up);
+            } else {
+                root = unite(find(up), find(left));
+            }
+            labels[idx] = root;
+            ++sizes[root];
+        }
+    }
+
+    // Second pass: one dense label per component, pointing at itself
+    std::vector<uint32_t> dense(parents.size(), NONE);
+    std::vector<uint32_t> denseSizes;
+    for (uint32_t& label : labels) {
+        if (label == NONE) {
+            continue;
+        }
+        uint32_t root = find(label);
+        if (dense[root] == NONE) {
+            dense[root] = static_cast<uint32_t>(denseSizes.size());
+            denseSizes.push_back(sizes[root]);
+        }
+        label = dense[root];
+    }
+    sizes.swap(denseSizes);
+    parents.resize(sizes.size());
+    for (uint32_t i = 0; i < parents.size(); ++i) {
+        parents[i] = i;
+    }
+}
+
+/**
+ * @brief New single-label set.
+ */
+uint32_t ConnectivityIndex::newLabel(uint32_t count)
+{
+    uint32_t label = static_cast<uint32_t>(parents.size());
+    parents.push_back(label);
+    sizes.push_back(count);
+    return label;
+}
+
+/**
+ * @brief Merges the sets of two roots, the smaller under the larger.
+ */
+uint32_t ConnectivityIndex::unite(uint32_t a, uint32_t b)
+{
+    if (a == b) {
+        return a;
+    }
+    if (sizes[a] < sizes[b]) {
+        std::swap(a, b);
+    }
+    parents[b] = a;
+    sizes[a] += sizes[b];
+    return a;
+}
+
+/**
+ * @brief Joins a newly passable cell to (and merges) its neighbors' components.
+ */
+void ConnectivityIndex::onOpened(const Map& map, int idx)
+{
+    const int stride = map.getStride();
+    const int offsets[4] = {1, stride, -1, -stride};
+    if (labels[idx] != NONE) {
+        return;
+    }
+    uint32_t root = NONE;
+    for (int offset : offsets) {
+        uint32_t label = labels[idx + offset];
+        if (label != NONE) {
+            uint32_t other = find(label);
+            root = root == NONE ? other : unite(root, other);
+        }
+    }
+    if (root == NONE) {
+        root = newLabel(0);
+    }
+    labels[idx] = root;
+    ++sizes[root];
+}
+
+/**
+ * @brief Removes a newly blocked cell and relabels any part split off by it.
+ */
+void ConnectivityIndex::onBlocked(const Map& map, int idx)
+{
+    uint32_t label = labels[idx];
+    if (label == NONE) {
+        return;
+    }
+    uint32_t root = find(label);
+    labels[idx] = NONE;
+    --sizes[root];
+
+    // The 8 cells around idx in ring order: N, NE, E, SE, S, SW, W, NW.
+    // Open orthogonal neighbors in one arc of consecutive open ring cells
+    // are still linked around the removed cell; one seed per arc remains.
+    const int stride = map.getStride();
+    const int ring[8] = {-stride, -stride + 1, 1, stride + 1, stride, stride - 1, -1, -stride - 1};
+    bool open[8];
+    int closed = -1;
+    for (int k = 0; k < 8; ++k) {
+        open[k] = labels[idx + ring[k]] != NONE;
+        if (!open[k]) {
+            closed = k;
+        }
+    }
+    if (closed < 0) {
+        return;  // Fully surrounded: nothing can split
+    }
+    int seeds[4];
+    int seedCount = 0;
+    bool arcHasSeed = false;
+    for (int step = 1; step <= 8; ++step) {
+        int k = (closed + step) % 8;
+        if (!open[k]) {
+            arcHasSeed = false;
+        } else if (k % 2 == 0 && !arcHasSeed) {
+            seeds[seedCount++] = idx + ring[k];
+            arcHasSeed = true;
+        }
+    }
+    if (seedCount <= 1) {
+        return;
+    }
+
+    // One breadth-first search per seed, advanced in lockstep
+    if (visitStamps.size() < labels.size()) {
+        visitStamps.assign(labels.size(), 0);
+        visitOwners.assign(labels.size(), 0);
+    }
+    if (++visitGeneration == 0) {
+        std::fill(visitStamps.begin(), visitStamps.end(), 0);
+        visitGeneration = 1;
+    }
+
+    const int offsets[4] = {1, stride, -1, -stride};
+    std::vector<int> fronts[4];   // Cells visited by each search, also its queue
+    size_t heads[4] = {0, 0, 0, 0};
+    int groups[4] = {0, 1, 2, 3}; // Searches that met share a group
+    bool finished[4] = {false, false, false, false};
+    auto groupOf = [&](int s) {
+        while (groups[s] != s) {
+            s = groups[s];
+        }
+        return s;
+    };
+    for (int s = 0; s < seedCount; ++s) {
+        visitStamps[seeds[s]] = visitGeneration;
+        visitOwners[seeds[s]] = static_cast<uint8_t>(s);
+        fronts[s].push_back(seeds[s]);
+    }
+
+    int liveGroups = seedCount;
+    while (liveGroups > 1) {
+        for (int s = 0; s < seedCount && liveGroups > 1; ++s) {
+            if (finished[groupOf(s)] || heads[s] == fronts[s].size()) {
+                continue;
+            }
+            int cell = fronts[s][heads[s]++];
+            for (int offset : offsets) {
+                int next = cell + offset;
+                if (labels[next] == NONE) {
+                    continue;
+                }
+                if (visitStamps[next] == visitGeneration) {
+                    int a = groupOf(s);
+                    int b = groupOf(visitOwners[next]);
+                    if (a != b) {
+                        groups[b] = a;
+                        --liveGroups;
+                    }
+                    continue;
+                }
+                visitStamps[next] = visitGeneration;
+                visitOwners[next] = static_cast<uint8_t>(s);
+                fronts[s].push_back(next);
+            }
+        }
+
+        // A group whose searches all ran dry is a component of its own
+        for (int g = 0; g < seedCount && liveGroups > 1; ++g) {
+            if (groupOf(g) != g || finished[g]) {
+                continue;
+            }
+            bool dry = true;
+            for (int s = 0; s < seedCount && dry; ++s) {
+                dry = groupOf(s) != g || heads[s] == fronts[s].size();
+            }
+            if (!dry) {
+                continue;
+            }
+            uint32_t split = newLabel(0);
+            for (int s = 0; s < seedCount; ++s) {
+                if (groupOf(s) != g) {
+                    continue;
+                }
+                for (int cell : fronts[s]) {
+                    labels[cell] = split;
+                }
+                sizes[split] += static_cast<uint32_t>(fronts[s].size());
+            }
+            sizes[root] -= sizes[split];
+            finished[g] = true;
+            --liveGroups;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+/******************************************************************************
+ * File:    ConnectivityIndex.h
+ *
+ * Overview:
+ *   This header declares the ConnectivityIndex class, which labels the
+ *   4-connected components of a Map's passable cells so that "can A reach
+ *   B at all?" is answered without a search.
+ *
+ *   - The initial labeling is the classic two-pass scheme: each cell takes
+ *     the label of its upper or left neighbor, and equivalences between
+ *     labels are merged in a union-find (union by size).
+ *   - A cell that becomes passable joins (and merges) the components of its
+ *     neighbors: a handful of union operations.
+ *   - A cell that becomes blocked can split its component. If its open
+ *     neighbors are still linked through the ring of 8 cells around it,
+ *     nothing changes. Otherwise one breadth-first search per separated
+ *     neighbor runs in lockstep; searches that meet are merged, and a
+ *     search that runs dry has found a split-off part, which gets a fresh
+ *     label. The work is proportional to the smaller side(s) of the split.
+ *
+ *   The Map owns one index and keeps it current in setCell(); queries are
+ *   read-only and safe to run concurrently.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/**
+ * @class ConnectivityIndex
+ *
+ * @brief Component labels of the passable cells, indexed by padded cell.
+ */
+class ConnectivityIndex {
+public:
+    /// Component id of blocked cells
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    /**
+     * @brief Labels every component of the map from scratch.
+     */
+    void build(const Map& map);
+
+    /**
+     * @brief Updates the labels after a cell became passable.
+     *
+     * @param map Map whose passability already reflects the change.
+     * @param idx Padded index of the cell.
+     */
+    void onOpened(const Map& map, int idx);
+
+    /**
+     * @brief Updates the labels after a cell became blocked.
+     *
+     * @param map Map whose passability already reflects the change.
+     * @param idx Padded index of the cell.
+     */
+    void onBlocked(const Map& map, int idx);
+
+    /**
+     * @return Component id of a padded cell, or NONE if it is blocked.
+     *         Ids are stable until the next change of the map.
+     */
+    uint32_t componentOf(int idx) const {
+        uint32_t label = labels[idx];
+        return label == NONE ? NONE : find(label);
+    }
+
+    /**
+     * @return Number of cells in the component of a padded cell (0 if blocked).
+     */
+    size_t componentSize(int idx) const {
+        uint32_t root = componentOf(idx);
+        return root == NONE ? 0 : sizes[root];
+    }
+
+private:
+    // Root of a label; union by size keeps chains logarithmic
+    uint32_t find(uint32_t label) const {
+        while (parents[label] != label) {
+            label = parents[label];
+        }
+        return label;
+    }
+
+    // New single-label set holding count cells
+    uint32_t newLabel(uint32_t count);
+
+    // Merges the sets of two roots; returns the surviving root
+    uint32_t unite(uint32_t a, uint32_t b);
+
+    std::vector<uint32_t> labels;   ///< Label per padded cell (NONE if blocked)
+    std::vector<uint32_t> parents;  ///< Union-find parent per label
+    std::vector<uint32_t> sizes;    ///< Cell count per root label
+
+    // Scratch state of the split search, kept between calls
+    std::vector<uint32_t> visitStamps;
+    std::vector<uint8_t> visitOwners;
+    uint32_t visitGeneration = 0;
+};
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * File:    CooperativeAStar.cpp
+ *
+ * Overview:
+ *   Implementation of the CooperativeAStar class. Every action costs one
+ *   time step, so g equals the time of a state and each (cell, time) pair
+ *   is expanded at most once; a hash set over such pairs is the closed list.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "CooperativeAStar.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+
+namespace {
+
+struct StateNode {
+    int cell;     // Padded index
+    int time;     // Steps since the start of the window
+    int parent;   // Index into the node list, -1 for the start
+};
+
+struct OpenEntry {
+    int f;
+    int time;
+    int node;
+    // Lowest f first; among equals, the deepest state
+    bool operator>(const OpenEntry& other) const {
+        return f != other.f ? f > other.f : time < other.time;
+    }
+};
+
+// Heuristic of cells that cannot reach the goal
+const int UNREACHABLE_STEPS = -1;
+
+uint64_t stateKey(int cell, int time)
+{
+    return (uint64_t(uint32_t(time)) << 32) | uint32_t(cell);
+}
+
+} // namespace
+
+/**
+ * @brief Plans one agent for the next window steps.
+ *
+ * @return Cells for times 0..T; see the header for details.
+ */
+std::vector<std::pair<int,int>> CooperativeAStar::findPath(const Map& map,
+                                                            const ReservationTable& reservations,
+                                                            const FlowField& field,
+                                                            int agent,
+                                                            int startRow, int startCol,
+                                                            int window,
+                                                            size_t maxExpansions)
+{
+    const int stride = map.getStride();
+    const int moves[5] = {0, 1, stride, -1, -stride};  // Wait first
+    const int goal = map.paddedIndex(field.getGoalRow(), field.getGoalCol());
+    const int start = map.paddedIndex(startRow, startCol);
+
+    // Time steps, not terrain costs, are minimized here: no path is shorter
+    // than its cost divided by the largest step cost
+    const double maxStepCost = map.getMaxStepCost();
+    auto heuristic = [&](int cell) {
+        float cost = field.distance(map.paddedRow(cell), map.paddedCol(cell));
+        return cost == FlowField::UNREACHABLE ? UNREACHABLE_STEPS
+                                              : static_cast<int>(cost / maxStepCost);
+    };
+
+    // The goal is a valid end state only if nobody needs it later in the window
+    auto goalFreeFrom = [&](int time) {
+        for (int t = time; t <= window; ++t) {
+            if (!reservations.isFree(goal, t, agent)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<StateNode> nodes;
+    std::vector<OpenEntry> open;
+    std::unordered_set<uint64_t> closed;
+    std::greater<OpenEntry> compare;
+
+    int endNode = -1;
+    if (field.isReachable(startRow, startCol)) {
+        nodes.push_back({start, 0, -1});
+        open.push_back({heuristic(start), 0, 0});
+        closed.insert(stateKey(start, 0));
+    }
+
+    size_t expansions = 0;
+    while (!open.empty() && expansions < maxExpansions) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        OpenEntry current = open.back();
+        open.pop_back();
+        StateNode node = nodes[current.node];
+        ++expansions;
+
+        if (node.time == window || (node.cell == goal && goalFreeFrom(node.time))) {
+            endNode = current.node;
+            break;
+        }
+
+        int nextTime = node.time + 1;
+        for (int move : moves) {
+            int next = node.cell + move;
+            if (!map.passable(next)) {
+                continue;
+            }
+            int h = heuristic(next);
+            if (h == UNREACHABLE_STEPS || !reservations.isFree(next, nextTime, agent)) {
+                continue;
+            }
+            if (move != 0) {
+                // Swap conflict: the agent now at next moves into our cell
+                int32_t other = reservations.owner(next, node.time);
+                if (other != ReservationTable::NONE && other != agent &&
+                    reservations.owner(node.cell, nextTime) == other) {
+                    continue;
+                }
+            }
+            if (!closed.insert(stateKey(next, nextTime)).second) {
+                continue;
+            }
+            nodes.push_back({next, nextTime, current.node});
+            open.push_back({nextTime + h, nextTime,
+                            static_cast<int>(nodes.size()) - 1});
+            std::push_heap(open.begin(), open.end(), compare);
+        }
+    }
+
+    std::vector<std::pair<int,int>> path;
+    if (endNode < 0) {
+        // No plan within the budget: wait where we are
+        path.push_back({startRow, startCol});
+        return path;
+    }
+    for (int n = endNode; n >= 0; n = nodes[n].parent) {
+        path.push_back({map.paddedRow(nodes[n].cell), map.paddedCol(nodes[n].cell)});
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+/******************************************************************************
+ * File:    CooperativeAStar.h
+ *
+ * Overview:
+ *   This header declares the CooperativeAStar class, the low-level search
+ *   of windowed cooperative A* (WHCA*). It plans one agent through
+ *   space-time (cell, time step) around the reservations of the agents
+ *   planned before it:
+ *
+ *   - Each tick the agent moves to a 4-neighbor or waits; either costs 1.
+ *   - A move is rejected if the target is reserved at the next step
+ *     (vertex conflict) or if the agent holding the target now holds the
+ *     current cell next step (swap conflict).
+ *   - The search stops at the window depth, or earlier at the goal if the
+ *     goal stays free for the rest of the window. The path cost from a
+ *     FlowField toward the goal, divided by the largest step cost, is the
+ *     heuristic, so beyond the window the agent still heads the right way.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "FlowField.h"
+#include "ReservationTable.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CooperativeAStar
+ *
+ * @brief Contains the static space-time search used by cooperative planning.
+ */
+class CooperativeAStar {
+public:
+    /// Expansion cap per search; beyond it the agent waits in place
+    static constexpr size_t DEFAULT_MAX_EXPANSIONS = 20000;
+
+    /**
+     * @brief Plans one agent for the next window steps.
+     *
+     * Reservations use padded cell indices (Map::paddedIndex) and times
+     * relative to the start of the window.
+     *
+     * @param map           Map to plan on.
+     * @param reservations  Reservations of higher-priority agents.
+     * @param field         Flow field toward the agent's goal (heuristic).
+     * @param agent         Id of the agent being planned.
+     * @param startRow      Current row of the agent (time 0).
+     * @param startCol      Current column of the agent.
+     * @param window        Planning depth, in time steps.
+     * @param maxExpansions Search effort limit.
+     * @return Cells for times 0, 1, ..., T (T <= window; repeated cells are
+     *         waits). T < window means the agent stays at the goal. If no
+     *         plan was found, only the start cell is returned.
+     */
+    static std::vector<std::pair<int, int>> findPath(const Map& map,
+                                                     const ReservationTable& reservations,
+                                                     const FlowField& field,
+                                                     int agent,
+                                                     int startRow, int startCol,
+                                                     int window,
+                                                     size_t maxExpansions = DEFAULT_MAX_EXPANSIONS);
+};
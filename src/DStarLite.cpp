@@ -0,0 +1,268 @@
+/******************************************************************************
+ * File:    DStarLite.cpp
+ *
+ * Overview:
+ *   Implementation of the DStarLite class. Cells are addressed by their
+ *   padded index, so the blocked border ends every neighbor scan without
+ *   bounds checks. Queue removals are lazy: an entry is live only while its
+ *   key matches queuedKey and inQueue is set.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "DStarLite.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+/**
+ * @brief Manhattan distance from the current start to a cell, scaled by the
+ *        cheapest step cost so it stays a lower bound.
+ */
+double DStarLite::heuristic(int idx) const
+{
+    return heuristicScale * (std::abs(map->paddedRow(idx) - map->paddedRow(start)) +
+                             std::abs(map->paddedCol(idx) - map->paddedCol(start)));
+}
+
+/**
+ * @brief D* Lite priority of a cell.
+ */
+DStarLite::Key DStarLite::calculateKey(int idx) const
+{
+    double best = std::min(g[idx], rhs[idx]);
+    return {best == INF ? INF : best + heuristic(idx) + km, best};
+}
+
+/**
+ * @brief Recomputes rhs of a cell from its neighbors and fixes its queue entry.
+ *
+ * A step from the cell to a neighbor costs the neighbor's terrain cost.
+ */
+void DStarLite::updateVertex(int idx)
+{
+    if (idx != goal) {
+        double best = INF;
+        if (map->passable(idx)) {
+            for (int offset : offsets) {
+                int next = idx + offset;
+                if (map->passable(next) && g[next] < INF) {
+                    best = std::min(best, g[next] + map->stepCost(next));
+                }
+            }
+        }
+        rhs[idx] = best;
+    }
+
+    inQueue[idx] = 0;
+    if (g[idx] != rhs[idx]) {
+        Key key = calculateKey(idx);
+        inQueue[idx] = 1;
+        queuedKey[idx] = key;
+        queue.push_back({key, idx});
+        std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+    }
+}
+
+/**
+ * @brief Discards dead entries from the top of the queue.
+ *
+ * @return True if a live entry is left on top.
+ */
+bool DStarLite::popStale()
+{
+    while (!queue.empty()) {
+        const QueueEntry& top = queue.front();
+        if (inQueue[top.index] && queuedKey[top.index] == top.key) {
+            return true;
+        }
+        std::pop_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+        queue.pop_back();
+    }
+    return false;
+}
+
+/**
+ * @brief Processes the queue until the start is consistent.
+ */
+void DStarLite::computeShortestPath()
+{
+    while (popStale() &&
+           (queue.front().key < calculateKey(start) || rhs[start] != g[start])) {
+        QueueEntry top = queue.front();
+        std::pop_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+        queue.pop_back();
+        int u = top.index;
+        ++expansions;
+
+        Key newKey = calculateKey(u);
+        if (top.key < newKey) {
+            // Stale priority (the start moved): requeue with the current key
+            queuedKey[u] = newKey;
+            queue.push_back({newKey, u});
+            std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+        } else if (g[u] > rhs[u]) {
+            // Overconsistent: settle it and relax the neighbors
+            g[u] = rhs[u];
+            inQueue[u] = 0;
+            for (int offset : offsets) {
+                updateVertex(u + offset);
+            }
+        } else {
+            // Underconsistent: reset and let it and its neighbors recompute
+            g[u] = INF;
+            inQueue[u] = 0;
+            updateVertex(u);
+            for (int offset : offsets) {
+                updateVertex(u + offset);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Plans from scratch.
+ *
+ * @param map      Map to plan on.
+ * @param startRow Row index of the start cell.
+ * @param startCol Column index of the start cell.
+ * @param goalRow  Row index of the goal cell.
+ * @param goalCol  Column index of the goal cell.
+ * @return True if a path exists.
+ */
+bool DStarLite::initialize(const Map& map, int startRow, int startCol, int goalRow, int goalCol)
+{
+    this->map = &map;
+    int stride = map.getStride();
+    offsets[0] = 1;
+    offsets[1] = stride;
+    offsets[2] = -1;
+    offsets[3] = -stride;
+
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < map.getHeight() && c >= 0 && c < map.getWidth();
+    };
+    this->goalRow = goalRow;
+    this->goalCol = goalCol;
+    km = 0.0;
+    heuristicScale = map.getMinStepCost();
+    expansions = 0;
+
+    size_t cellCount = static_cast<size_t>(map.getPaddedCellCount());
+    g.assign(cellCount, INF);
+    rhs.assign(cellCount, INF);
+    queuedKey.assign(cellCount, Key{INF, INF});
+    inQueue.assign(cellCount, 0);
+    queue.clear();
+
+    if (!inBounds(startRow, startCol) || !inBounds(goalRow, goalCol)) {
+        start = goal = lastStart = -1;
+        return false;
+    }
+    start = lastStart = map.paddedIndex(startRow, startCol);
+    goal = map.paddedIndex(goalRow, goalCol);
+
+    if (map.passable(goal)) {
+        rhs[goal] = 0;
+        updateVertex(goal);
+    }
+    computeShortestPath();
+    return g[start] < INF;
+}
+
+/**
+ * @brief Records that the agent now stands at (r, c).
+ */
+void DStarLite::updateStart(int r, int c)
+{
+    if (start >= 0) {
+        start = map->paddedIndex(r, c);
+    }
+}
+
+/**
+ * @brief Queues the repair for a cell whose passability or cost changed.
+ *
+ * The cell and its four neighbors get their rhs values recomputed, which
+ * covers every edge cost touching the cell.
+ */
+void DStarLite::notifyCellChanged(int r, int c)
+{
+    if (start < 0) {
+        return;
+    }
+    int idx = map->paddedIndex(r, c);
+
+    // The goal itself became blocked or reopened
+    if (idx == goal) {
+        rhs[goal] = map->passable(goal) ? 0 : INF;
+    }
+    updateVertex(idx);
+    for (int offset : offsets) {
+        int next = idx + offset;
+        if (map->passable(next)) {
+            updateVertex(next);
+        }
+    }
+}
+
+/**
+ * @brief Repairs the search after start moves and cell changes.
+ *
+ * @return True if a path exists.
+ */
+bool DStarLite::replan()
+{
+    if (start < 0) {
+        return false;
+    }
+
+    // A cheaper terrain than at initialize() would make the keys overestimate
+    if (map->getMinStepCost() < heuristicScale) {
+        return initialize(*map, map->paddedRow(start), map->paddedCol(start), goalRow, goalCol);
+    }
+
+    // Keys computed for the old start are lower bounds; km keeps them valid
+    km += heuristicScale * (std::abs(map->paddedRow(lastStart) - map->paddedRow(start)) +
+                            std::abs(map->paddedCol(lastStart) - map->paddedCol(start)));
+    lastStart = start;
+
+    computeShortestPath();
+    return g[start] < INF;
+}
+
+/**
+ * @return The current path from the start to the goal, following the
+ *         neighbor with the lowest step cost plus g value at each step.
+ */
+std::vector<std::pair<int,int>> DStarLite::extractPath() const
+{
+    std::vector<std::pair<int,int>> path;
+    if (start < 0 || g[start] >= INF || !map->passable(start)) {
+        return path;
+    }
+
+    int current = start;
+    path.push_back({map->paddedRow(current), map->paddedCol(current)});
+    // Costs are positive, so a consistent search strictly decreases g along the path
+    while (current != goal) {
+        int next = -1;
+        double best = INF;
+        for (int offset : offsets) {
+            int candidate = current + offset;
+            if (map->passable(candidate) && g[candidate] < g[current] &&
+                g[candidate] + map->stepCost(candidate) < best) {
+                best = g[candidate] + map->stepCost(candidate);
+                next = candidate;
+            }
+        }
+        if (next < 0) {
+            path.clear();
+            return path;
+        }
+        current = next;
+        path.push_back({map->paddedRow(current), map->paddedCol(current)});
+    }
+    return path;
+}
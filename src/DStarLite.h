@@ -0,0 +1,118 @@
+#pragma once
+
+/******************************************************************************
+ * File:    DStarLite.h
+ *
+ * Overview:
+ *   This header declares the DStarLite class, an incremental planner for a
+ *   single agent (Koenig and Likhachev's D* Lite, optimized version).
+ *
+ *   The search runs backward from the goal and keeps its g/rhs values
+ *   between calls. When cells change passability or cost, only the
+ *   vertices whose distances are affected are reprocessed; the agent can
+ *   also move along its path without invalidating anything. Paths are
+ *   4-connected and each step costs the terrain cost of the cell entered
+ *   (Map::stepCost), like Pathfinding::aStar, so they are optimal for the
+ *   current map and match the A* plans they repair.
+ *
+ *   The state is O(padded cell count) per planner, so planners are meant
+ *   for the agents that actually need repairs.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class DStarLite
+ *
+ * @brief Per-agent D* Lite search state over a Map.
+ */
+class DStarLite {
+public:
+    /**
+     * @brief Plans from scratch from (startRow, startCol) to (goalRow, goalCol).
+     *
+     * @param map Map to plan on; must outlive the planner (or the next
+     *            initialize call).
+     * @return True if a path exists.
+     */
+    bool initialize(const Map& map, int startRow, int startCol, int goalRow, int goalCol);
+
+    /**
+     * @brief Records that the agent now stands at (r, c).
+     */
+    void updateStart(int r, int c);
+
+    /**
+     * @brief Queues the repair for a cell whose passability or cost changed.
+     *
+     * Call after the change was applied to the Map. The work happens in the
+     * next replan().
+     */
+    void notifyCellChanged(int r, int c);
+
+    /**
+     * @brief Repairs the search after updateStart/notifyCellChanged calls.
+     *
+     * @return True if a path exists.
+     */
+    bool replan();
+
+    /**
+     * @return The current path from the start to the goal (both included),
+     *         or an empty vector if there is none.
+     */
+    std::vector<std::pair<int, int>> extractPath() const;
+
+    /**
+     * @return True if initialize() was called.
+     */
+    bool isInitialized() const { return map != nullptr; }
+
+    int getGoalRow() const { return goalRow; }
+    int getGoalCol() const { return goalCol; }
+
+    /**
+     * @return Number of vertex expansions since initialize().
+     */
+    size_t getExpansionCount() const { return expansions; }
+
+private:
+    using Key = std::pair<double, double>;
+
+    struct QueueEntry {
+        Key key;
+        int index;
+        bool operator>(const QueueEntry& other) const { return key > other.key; }
+    };
+
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+
+    double heuristic(int idx) const;
+    Key calculateKey(int idx) const;
+    void updateVertex(int idx);
+    void computeShortestPath();
+    bool popStale();
+
+    const Map* map = nullptr;
+    int start = -1, goal = -1;   // Padded indices
+    int lastStart = -1;          // Start at the previous replan (for km)
+    int goalRow = -1, goalCol = -1;
+    int offsets[4] = {0, 0, 0, 0};
+    double km = 0.0;
+    double heuristicScale = 1.0;  // Cheapest step cost at initialize()
+
+    std::vector<double> g;        // Cost from a cell to the goal
+    std::vector<double> rhs;
+    std::vector<Key> queuedKey;         // Key of the live queue entry
+    std::vector<uint8_t> inQueue;       // 1 if the cell has a live queue entry
+    std::vector<QueueEntry> queue;      // Min-heap with lazy deletion
+    size_t expansions = 0;
+};
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * File:    FlowField.cpp
+ *
+ * Overview:
+ *   Implementation of the FlowField class. The field is filled by a search
+ *   outward from the goal over the map's padded passability bitset: a
+ *   breadth-first search when every terrain cost is the same, Dijkstra's
+ *   algorithm otherwise. Each reached cell points back at the neighbor it
+ *   was reached from, which is that neighbor's step cost closer to the goal.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "FlowField.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+// Orthogonal neighbor offsets (right, down, left, up)
+const int DIRECTIONS[4][2] = { {0, 1}, {1, 0}, {0, -1}, {-1, 0} };
+
+} // namespace
+
+/**
+ * @brief Builds the field for the given goal with a reverse search.
+ *
+ * Stepping from a cell onto a neighbor closer to the goal costs the
+ * neighbor's terrain cost, as in Pathfinding::aStar.
+ *
+ * @param map     Map to search.
+ * @param goalR   Row index of the goal cell.
+ * @param goalC   Column index of the goal cell.
+ */
+void FlowField::build(const Map& map, int goalR, int goalC)
+{
+    width = map.getWidth();
+    goalRow = goalR;
+    goalCol = goalC;
+    mapVersion = map.getVersion();
+    built = true;
+
+    const int stride = map.getStride();
+    const int offsets[4] = { 1, stride, -1, -stride };
+
+    distances.assign(map.getPaddedCellCount(), UNREACHABLE);
+    directions.assign(map.getPaddedCellCount(), NO_DIRECTION);
+
+    if (goalR < 0 || goalR >= map.getHeight() || goalC < 0 || goalC >= width) {
+        return;
+    }
+    int goal = map.paddedIndex(goalR, goalC);
+    if (!map.passable(goal)) {
+        return;
+    }
+    distances[goal] = 0;
+
+    if (map.getMinStepCost() == map.getMaxStepCost()) {
+        // Uniform costs: cells are settled in breadth-first order
+        const float stepCost = static_cast<float>(map.getMinStepCost());
+        std::vector<int> queue;
+        queue.reserve(map.getWidth() * map.getHeight());
+        queue.push_back(goal);
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int current = queue[head];
+            float next = distances[current] + stepCost;
+            for (int d = 0; d < 4; ++d) {
+                int neighbor = current + offsets[d];
+                if (!map.passable(neighbor) || distances[neighbor] != UNREACHABLE) {
+                    continue;
+                }
+                distances[neighbor] = next;
+                // Moving from the neighbor back to current is the opposite direction
+                directions[neighbor] = static_cast<uint8_t>((d + 2) % 4);
+                queue.push_back(neighbor);
+            }
+        }
+        return;
+    }
+
+    // Weighted costs: Dijkstra with lazy deletion of outdated heap entries
+    using Entry = std::pair<float, int>;
+    std::vector<Entry> open;
+    std::greater<Entry> compare;
+    open.push_back({0.0f, goal});
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        Entry current = open.back();
+        open.pop_back();
+        if (current.first > distances[current.second]) {
+            continue;
+        }
+        // Entering current from a neighbor costs current's terrain cost
+        float next = current.first + map.stepCost(current.second);
+        for (int d = 0; d < 4; ++d) {
+            int neighbor = current.second + offsets[d];
+            if (!map.passable(neighbor) || next >= distances[neighbor]) {
+                continue;
+            }
+            distances[neighbor] = next;
+            directions[neighbor] = static_cast<uint8_t>((d + 2) % 4);
+            open.push_back({next, neighbor});
+            std::push_heap(open.begin(), open.end(), compare);
+        }
+    }
+}
+
+/**
+ * @brief Reads the next cell toward the goal in O(1).
+ *
+ * @param r, c    Current cell (inside the map).
+ * @param nr, nc  Receives the next cell.
+ * @return False if (r, c) is the goal or cannot reach it.
+ */
+bool FlowField::nextStep(int r, int c, int& nr, int& nc) const
+{
+    uint8_t d = directions[paddedIndex(r, c)];
+    if (d == NO_DIRECTION) {
+        return false;
+    }
+    nr = r + DIRECTIONS[d][0];
+    nc = c + DIRECTIONS[d][1];
+    return true;
+}
+
+/**
+ * @brief Follows the direction field from (r, c) to the goal.
+ *
+ * @return The cells from (r, c) to the goal (inclusive), or an empty vector
+ *         if the goal is unreachable.
+ */
+std::vector<std::pair<int,int>> FlowField::extractPath(int r, int c) const
+{
+    std::vector<std::pair<int, int>> path;
+    if (!isReachable(r, c)) {
+        return path;
+    }
+    path.push_back({r, c});
+    int nr, nc;
+    while (nextStep(r, c, nr, nc)) {
+        r = nr;
+        c = nc;
+        path.push_back({r, c});
+    }
+    return path;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+/******************************************************************************
+ * File:    FlowField.h
+ *
+ * Overview:
+ *   This header declares the FlowField class: a distance field and a
+ *   direction field toward one goal, built by a single reverse search from
+ *   the goal. Any number of agents heading to that goal can then read their
+ *   next step in O(1) instead of running their own search.
+ *
+ *   Movement and costs match Pathfinding::aStar (4-connected, each step
+ *   costs the terrain cost of the cell entered), so the distance of a cell
+ *   equals the cost of the A* path from it. Uniform-cost maps are filled by
+ *   a breadth-first search, others by Dijkstra's algorithm.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FlowField
+ *
+ * @brief Per-goal distance and direction field.
+ *
+ * A built field is read-only and may be shared between threads.
+ */
+class FlowField {
+public:
+    /// Distance value of cells that cannot reach the goal
+    static constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+    /**
+     * @brief Builds the field for the given goal.
+     *
+     * An out-of-bounds or blocked goal yields a field where every cell is
+     * unreachable.
+     *
+     * @param map     Map to search.
+     * @param goalRow Row index of the goal cell.
+     * @param goalCol Column index of the goal cell.
+     */
+    void build(const Map& map, int goalRow, int goalCol);
+
+    /**
+     * @return True if the field was built for the map's current version.
+     */
+    bool isCurrent(const Map& map) const {
+        return built && mapVersion == map.getVersion() && width == map.getWidth();
+    }
+
+    /**
+     * @return Path cost from (r, c) to the goal (the step count on a
+     *         unit-cost map), or UNREACHABLE. (r, c) must be inside the map.
+     */
+    float distance(int r, int c) const { return distances[paddedIndex(r, c)]; }
+
+    /**
+     * @return True if the goal can be reached from (r, c).
+     */
+    bool isReachable(int r, int c) const { return distance(r, c) != UNREACHABLE; }
+
+    /**
+     * @brief Reads the next cell toward the goal in O(1).
+     *
+     * @param r, c    Current cell (inside the map).
+     * @param nr, nc  Receives the next cell.
+     * @return False if (r, c) is the goal or cannot reach it.
+     */
+    bool nextStep(int r, int c, int& nr, int& nc) const;
+
+    /**
+     * @brief Follows the direction field from (r, c) to the goal.
+     *
+     * @return The cells from (r, c) to the goal (inclusive), or an empty
+     *         vector if the goal is unreachable.
+     */
+    std::vector<std::pair<int, int>> extractPath(int r, int c) const;
+
+    int getGoalRow() const { return goalRow; }
+    int getGoalCol() const { return goalCol; }
+
+private:
+    // Index in the map's padded layout (see Map::paddedIndex)
+    int paddedIndex(int r, int c) const { return (r + 1) * (width + 2) + (c + 1); }
+
+    static constexpr uint8_t NO_DIRECTION = 0xFF;
+
+    bool built = false;
+    uint64_t mapVersion = 0;          ///< Map::getVersion() at build time
+    int width = 0;                    ///< Map width at build time
+    int goalRow = -1, goalCol = -1;
+    std::vector<float> distances;     ///< Path cost to the goal, per padded cell
+    std::vector<uint8_t> directions;  ///< Index into DIRECTIONS, per padded cell
+};
@@ -0,0 +1,290 @@
+/******************************************************************************
+ * File:    GoalAssignment.cpp
+ *
+ * Overview:
+ *   Implementation of the GoalAssignment solvers.
+ *
+ *   Highlights:
+ *   - hungarian() is the potentials-based O(n^2 m) formulation, working on
+ *     a 1-based copy of the problem with a dummy row/column 0.
+ *   - The spatial index is a uniform grid of goal buckets. A nearest query
+ *     scans rings of buckets around the query and stops as soon as no
+ *     unvisited ring can hold a closer goal.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "GoalAssignment.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief Uniform bucket grid over goal positions for nearest-goal queries.
+ */
+class GoalGrid {
+public:
+    static constexpr int BUCKET_SIZE = 16;
+
+    explicit GoalGrid(const std::vector<std::pair<int, int>>& goalCells)
+        : goals(goalCells)
+    {
+        minRow = minCol = std::numeric_limits<int>::max();
+        int maxRow = std::numeric_limits<int>::min();
+        int maxCol = std::numeric_limits<int>::min();
+        for (const auto& g : goals) {
+            minRow = std::min(minRow, g.first);
+            minCol = std::min(minCol, g.second);
+            maxRow = std::max(maxRow, g.first);
+            maxCol = std::max(maxCol, g.second);
+        }
+        rows = goals.empty() ? 0 : (maxRow - minRow) / BUCKET_SIZE + 1;
+        cols = goals.empty() ? 0 : (maxCol - minCol) / BUCKET_SIZE + 1;
+        buckets.assign(static_cast<size_t>(rows) * cols, {});
+        for (int i = 0; i < (int)goals.size(); ++i) {
+            buckets[bucketOf(goals[i].first, goals[i].second)].push_back(i);
+        }
+    }
+
+    /**
+     * @return Index of the nearest remaining goal to (r, c), or -1.
+     */
+    int nearest(int r, int c) const {
+        if (buckets.empty()) {
+            return -1;
+        }
+        int br = std::clamp((r - minRow) / BUCKET_SIZE, 0, rows - 1);
+        int bc = std::clamp((c - minCol) / BUCKET_SIZE, 0, cols - 1);
+
+        int best = -1;
+        int bestDist = std::numeric_limits<int>::max();
+        int maxRing = std::max(std::max(br, rows - 1 - br), std::max(bc, cols - 1 - bc));
+        for (int ring = 0; ring <= maxRing; ++ring) {
+            // Every bucket of this ring is at least (ring - 1) buckets away
+            if (best >= 0 && bestDist <= (ring - 1) * BUCKET_SIZE) {
+                break;
+            }
+            for (int rr = br - ring; rr <= br + ring; ++rr) {
+                if (rr < 0 || rr >= rows) {
+                    continue;
+                }
+                bool edgeRow = (rr == br - ring || rr == br + ring);
+                for (int cc = bc - ring; cc <= bc + ring; ++cc) {
+                    if (cc < 0 || cc >= cols) {
+                        continue;
+                    }
+                    // Only the outline of the ring is new
+                    if (!edgeRow && cc != bc - ring && cc != bc + ring) {
+                        continue;
+                    }
+                    for (int id : buckets[rr * cols + cc]) {
+                        int d = std::abs(goals[id].first - r) + std::abs(goals[id].second - c);
+                        if (d < bestDist || (d == bestDist && id < best)) {
+                            bestDist = d;
+                            best = id;
+                        }
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Removes a goal so later queries no longer return it.
+     */
+    void remove(int id) {
+        auto& bucket = buckets[bucketOf(goals[id].first, goals[id].second)];
+        auto it = std::find(bucket.begin(), bucket.end(), id);
+        if (it != bucket.end()) {
+            *it = bucket.back();
+            bucket.pop_back();
+        }
+    }
+
+private:
+    int bucketOf(int r, int c) const {
+        return ((r - minRow) / BUCKET_SIZE) * cols + (c - minCol) / BUCKET_SIZE;
+    }
+
+    const std::vector<std::pair<int, int>>& goals;
+    int minRow = 0, minCol = 0;
+    int rows = 0, cols = 0;
+    std::vector<std::vector<int>> buckets;
+};
+
+} // namespace
+
+/**
+ * @brief Optimal assignment minimizing the total cost (Hungarian algorithm).
+ *
+ * @param costs Row-major rows x cols cost matrix.
+ * @param rows  Number of agents.
+ * @param cols  Number of goals; must be >= rows.
+ * @return      Goal index for each agent.
+ */
+std::vector<int> GoalAssignment::hungarian(const std::vector<double>& costs,
+                                           int rows, int cols)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    auto a = [&](int i, int j) { return costs[(i - 1) * cols + (j - 1)]; };
+
+    std::vector<double> u(rows + 1, 0.0), v(cols + 1, 0.0);
+    std::vector<int> p(cols + 1, 0), way(cols + 1, 0);
+
+    for (int i = 1; i <= rows; ++i) {
+        p[0] = i;
+        int j0 = 0;
+        std::vector<double> minv(cols + 1, INF);
+        std::vector<char> used(cols + 1, false);
+        do {
+            used[j0] = true;
+            int i0 = p[j0];
+            int j1 = 0;
+            double delta = INF;
+            for (int j = 1; j <= cols; ++j) {
+                if (used[j]) {
+                    continue;
+                }
+                double cur = a(i0, j) - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= cols; ++j) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+
+        // Augment along the alternating path
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    std::vector<int> result(rows, -1);
+    for (int j = 1; j <= cols; ++j) {
+        if (p[j] != 0) {
+            result[p[j] - 1] = j - 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Approximate one-to-one assignment by Manhattan distance.
+ *
+ * @return Goal index for each agent; -1 once goals run out.
+ */
+std::vector<int> GoalAssignment::greedyNearest(const std::vector<std::pair<int, int>>& agents,
+                                               const std::vector<std::pair<int, int>>& goals)
+{
+    GoalGrid grid(goals);
+    std::vector<int> result(agents.size(), -1);
+
+    // Serve agents closest to a goal first, so contested goals go to them
+    std::vector<int> firstChoiceDist(agents.size(), 0);
+    for (size_t i = 0; i < agents.size(); ++i) {
+        int g = grid.nearest(agents[i].first, agents[i].second);
+        if (g >= 0) {
+            firstChoiceDist[i] = std::abs(goals[g].first - agents[i].first) +
+                                 std::abs(goals[g].second - agents[i].second);
+        }
+    }
+    std::vector<int> order(agents.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return firstChoiceDist[a] < firstChoiceDist[b];
+    });
+
+    for (int i : order) {
+        int g = grid.nearest(agents[i].first, agents[i].second);
+        if (g < 0) {
+            break;   // No goals left
+        }
+        result[i] = g;
+        grid.remove(g);
+    }
+    return result;
+}
+
+/**
+ * @brief Approximate one-to-one assignment for an arbitrary pair cost.
+ *
+ * The costs are evaluated once into a matrix, so callers may pass costs
+ * that are expensive to compute.
+ *
+ * @return Goal index for each agent; -1 if no reachable goal is left.
+ */
+std::vector<int> GoalAssignment::greedyCheapest(int rows, int cols,
+                                                const std::function<double(int, int)>& cost)
+{
+    std::vector<double> costs(static_cast<size_t>(rows) * cols);
+    std::vector<double> firstChoiceCost(rows, UNREACHABLE_COST);
+    for (int i = 0; i < rows; ++i) {
+        for (int g = 0; g < cols; ++g) {
+            double c = cost(i, g);
+            costs[static_cast<size_t>(i) * cols + g] = c;
+            firstChoiceCost[i] = std::min(firstChoiceCost[i], c);
+        }
+    }
+
+    // Serve agents with the cheapest first choice first, as greedyNearest()
+    std::vector<int> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return firstChoiceCost[a] < firstChoiceCost[b];
+    });
+
+    std::vector<int> result(rows, -1);
+    std::vector<char> taken(cols, false);
+    for (int i : order) {
+        const double* row = costs.data() + static_cast<size_t>(i) * cols;
+        double best = UNREACHABLE_COST;
+        for (int g = 0; g < cols; ++g) {
+            if (!taken[g] && row[g] < best) {
+                best = row[g];
+                result[i] = g;
+            }
+        }
+        if (result[i] >= 0) {
+            taken[result[i]] = true;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Nearest goal per agent by Manhattan distance; goals may be shared.
+ *
+ * Ties go to the goal with the lower index.
+ *
+ * @return Goal index for each agent; -1 if there are no goals.
+ */
+std::vector<int> GoalAssignment::nearestGoals(const std::vector<std::pair<int, int>>& agents,
+                                              const std::vector<std::pair<int, int>>& goals)
+{
+    GoalGrid grid(goals);
+    std::vector<int> result(agents.size(), -1);
+    for (size_t i = 0; i < agents.size(); ++i) {
+        result[i] = grid.nearest(agents[i].first, agents[i].second);
+    }
+    return result;
+}
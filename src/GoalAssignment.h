@@ -0,0 +1,86 @@
+#pragma once
+
+/******************************************************************************
+ * File:    GoalAssignment.h
+ *
+ * Overview:
+ *   This header declares the GoalAssignment class, which pairs agents with
+ *   goals:
+ *   - hungarian(): optimal one-to-one assignment for a dense cost matrix,
+ *     O(n^3), used for small groups.
+ *   - greedyNearest(): approximate one-to-one assignment for thousands of
+ *     agents. Goals live in a bucket grid, and agents closest to any goal
+ *     pick first, each taking its nearest free goal.
+ *   - greedyCheapest(): the same greedy order for any pair cost (e.g. true
+ *     path distances), evaluating every agent/goal pair once.
+ *   - nearestGoals(): nearest goal per agent (goals may be shared), also
+ *     answered from the bucket grid instead of scanning every goal.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class GoalAssignment
+ *
+ * @brief Static assignment solvers. Positions are (row, column) pairs and
+ *        results hold one goal index per agent (-1 if none).
+ */
+class GoalAssignment {
+public:
+    /// Largest group solved optimally by MultiUnitCoordinator::assignGoals()
+    static constexpr int HUNGARIAN_LIMIT = 256;
+
+    /// Cost used for agent/goal pairs that cannot reach each other
+    static constexpr double UNREACHABLE_COST = 1e9;
+
+    /**
+     * @brief Optimal assignment minimizing the total cost.
+     *
+     * @param costs Row-major rows x cols matrix; costs[r * cols + c] is the
+     *              cost of giving goal c to agent r.
+     * @param rows  Number of agents.
+     * @param cols  Number of goals; must be >= rows.
+     * @return      Goal index for each agent.
+     */
+    static std::vector<int> hungarian(const std::vector<double>& costs,
+                                      int rows, int cols);
+
+    /**
+     * @brief Approximate one-to-one assignment by Manhattan distance.
+     *
+     * Agents are served in order of their distance to the nearest goal and
+     * take the nearest goal still free.
+     *
+     * @return Goal index for each agent; -1 once goals run out.
+     */
+    static std::vector<int> greedyNearest(const std::vector<std::pair<int, int>>& agents,
+                                          const std::vector<std::pair<int, int>>& goals);
+
+    /**
+     * @brief Approximate one-to-one assignment for an arbitrary pair cost.
+     *
+     * Agents are served in order of their cheapest goal and take the
+     * cheapest goal still free. Pairs costing UNREACHABLE_COST or more are
+     * never assigned. O(rows * cols) evaluations of cost.
+     *
+     * @param rows Number of agents.
+     * @param cols Number of goals.
+     * @param cost cost(agent, goal).
+     * @return     Goal index for each agent; -1 if no reachable goal is left.
+     */
+    static std::vector<int> greedyCheapest(int rows, int cols,
+                                           const std::function<double(int, int)>& cost);
+
+    /**
+     * @brief Nearest goal per agent by Manhattan distance; goals may be shared.
+     *
+     * @return Goal index for each agent; -1 if there are no goals.
+     */
+    static std::vector<int> nearestGoals(const std::vector<std::pair<int, int>>& agents,
+                                         const std::vector<std::pair<int, int>>& goals);
+};
@@ -0,0 +1,517 @@
+/******************************************************************************
+ * File:    HierarchicalPathfinder.cpp
+ *
+ * Overview:
+ *   This file contains the implementation of the HierarchicalPathfinder class.
+ *
+ *   Highlights:
+ *   - Abstract nodes belong to exactly one border, so a border can be
+ *     rebuilt by dropping its nodes and detecting its entrances again.
+ *   - Intra-cluster distances come from a breadth-first search confined to
+ *     the cluster, which matches the unit-cost, 4-connected Pathfinding::aStar.
+ *   - Queries do not touch the abstraction: the start and goal links are kept
+ *     in small side lists, so findPath() is const.
+ *   - The caller's SearchContext is reused for the linking searches, the
+ *     abstract search (indexed by node id) and every refinement search.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "HierarchicalPathfinder.h"
+#include "Pathfinding.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Runs of open border cells at least this long get an entrance at each end
+const int MAX_ENTRANCE_WIDTH = 6;
+
+} // namespace
+
+/**
+ * @brief Builds the abstraction for the given map and starts observing it.
+ *
+ * @param mapRef      Map to abstract; must outlive this object.
+ * @param clusterSize Side length of a cluster, in cells.
+ */
+HierarchicalPathfinder::HierarchicalPathfinder(const Map& mapRef, int clusterSize)
+    : map(mapRef),
+      clusterSize(std::max(clusterSize, 2))
+{
+    rebuild();
+    map.addObserver(this);
+}
+
+/**
+ * @brief Stops observing the map.
+ */
+HierarchicalPathfinder::~HierarchicalPathfinder()
+{
+    map.removeObserver(this);
+}
+
+/**
+ * @brief Rebuilds the whole abstraction from the current map contents.
+ */
+void HierarchicalPathfinder::rebuild()
+{
+    clustersX = (map.getWidth()  + clusterSize - 1) / clusterSize;
+    clustersY = (map.getHeight() + clusterSize - 1) / clusterSize;
+
+    nodes.clear();
+    freeNodes.clear();
+    clusterNodes.assign(clustersX * clustersY, {});
+    hBorderNodes.assign(clustersY > 1 ? (clustersY - 1) * clustersX : 0, {});
+    vBorderNodes.assign(clustersX > 1 ? clustersY * (clustersX - 1) : 0, {});
+
+    for (int b = 0; b < (int)hBorderNodes.size(); ++b) {
+        rebuildBorder(true, b);
+    }
+    for (int b = 0; b < (int)vBorderNodes.size(); ++b) {
+        rebuildBorder(false, b);
+    }
+    for (int cluster = 0; cluster < (int)clusterNodes.size(); ++cluster) {
+        rebuildIntraEdges(cluster);
+    }
+}
+
+/**
+ * @return Number of live abstract nodes.
+ */
+int HierarchicalPathfinder::getAbstractNodeCount() const
+{
+    return static_cast<int>(nodes.size() - freeNodes.size());
+}
+
+/**
+ * @brief Rebuilds the clusters affected by a passability change at (r, c).
+ *
+ * The cell's own cluster always needs new intra-cluster edges. If the cell
+ * lies on a cluster edge, the entrances of that border change too, and so do
+ * the intra-cluster edges of the cluster on the other side.
+ */
+void HierarchicalPathfinder::onCellChanged(int r, int c)
+{
+    int cy = r / clusterSize;
+    int cx = c / clusterSize;
+
+    std::vector<int> dirty = { clusterOf(r, c) };
+    auto touch = [&](std::pair<int, int> clusters) {
+        dirty.push_back(clusters.first);
+        dirty.push_back(clusters.second);
+    };
+
+    if (r % clusterSize == clusterSize - 1 && cy < clustersY - 1) {
+        touch(rebuildBorder(true, cy * clustersX + cx));
+    }
+    if (r % clusterSize == 0 && cy > 0) {
+        touch(rebuildBorder(true, (cy - 1) * clustersX + cx));
+    }
+    if (c % clusterSize == clusterSize - 1 && cx < clustersX - 1) {
+        touch(rebuildBorder(false, cy * (clustersX - 1) + cx));
+    }
+    if (c % clusterSize == 0 && cx > 0) {
+        touch(rebuildBorder(false, cy * (clustersX - 1) + (cx - 1)));
+    }
+
+    std::sort(dirty.begin(), dirty.end());
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+    for (int cluster : dirty) {
+        rebuildIntraEdges(cluster);
+    }
+}
+
+/**
+ * @brief Rebuilds the whole abstraction after the map was reloaded.
+ */
+void HierarchicalPathfinder::onMapReloaded()
+{
+    rebuild();
+}
+
+/**
+ * @return Cluster id of the cell (r, c).
+ */
+int HierarchicalPathfinder::clusterOf(int r, int c) const
+{
+    return (r / clusterSize) * clustersX + (c / clusterSize);
+}
+
+/**
+ * @brief Cell bounds of a cluster: rows [r0, r1), columns [c0, c1).
+ */
+void HierarchicalPathfinder::clusterBounds(int cluster, int& r0, int& c0,
+                                           int& r1, int& c1) const
+{
+    r0 = (cluster / clustersX) * clusterSize;
+    c0 = (cluster % clustersX) * clusterSize;
+    r1 = std::min(r0 + clusterSize, map.getHeight());
+    c1 = std::min(c0 + clusterSize, map.getWidth());
+}
+
+/**
+ * @brief Replaces the entrances of one border.
+ *
+ * A horizontal border separates cluster (cy, cx) from (cy + 1, cx); a
+ * vertical border separates (cy, cx) from (cy, cx + 1).
+ *
+ * @param horizontal True for a horizontal border.
+ * @param border     Index into hBorderNodes or vBorderNodes.
+ * @return The ids of the two clusters sharing the border.
+ */
+std::pair<int, int> HierarchicalPathfinder::rebuildBorder(bool horizontal, int border)
+{
+    std::vector<int>& borderNodes = horizontal ? hBorderNodes[border]
+                                               : vBorderNodes[border];
+    for (int id : borderNodes) {
+        removeNode(id);
+    }
+    borderNodes.clear();
+
+    // Locate the border: the first cell on each side and the walking direction
+    int cy, cx, firstA, firstB, length;
+    int rowA, colA, rowB, colB, stepR, stepC;
+    if (horizontal) {
+        cy = border / clustersX;
+        cx = border % clustersX;
+        firstB = (cy + 1) * clusterSize;        // Top row of the lower cluster
+        firstA = firstB - 1;                    // Bottom row of the upper cluster
+        rowA = firstA; rowB = firstB;
+        colA = colB = cx * clusterSize;
+        stepR = 0; stepC = 1;
+        length = std::min(clusterSize, map.getWidth() - colA);
+    } else {
+        cy = border / (clustersX - 1);
+        cx = border % (clustersX - 1);
+        firstB = (cx + 1) * clusterSize;        // Left column of the right cluster
+        firstA = firstB - 1;                    // Right column of the left cluster
+        colA = firstA; colB = firstB;
+        rowA = rowB = cy * clusterSize;
+        stepR = 1; stepC = 0;
+        length = std::min(clusterSize, map.getHeight() - rowA);
+    }
+    int clusterA = cy * clustersX + cx;
+    int clusterB = horizontal ? clusterA + clustersX : clusterA + 1;
+
+    auto open = [&](int k) {
+        return map.passable(map.paddedIndex(rowA + k * stepR, colA + k * stepC)) &&
+               map.passable(map.paddedIndex(rowB + k * stepR, colB + k * stepC));
+    };
+    auto addEntrance = [&](int k) {
+        int a = addNode(rowA + k * stepR, colA + k * stepC, clusterA);
+        int b = addNode(rowB + k * stepR, colB + k * stepC, clusterB);
+        nodes[a].edges.push_back(Edge{ b, 1.0, false });
+        nodes[b].edges.push_back(Edge{ a, 1.0, false });
+        borderNodes.push_back(a);
+        borderNodes.push_back(b);
+    };
+
+    // Each maximal run of cells open on both sides becomes an entrance
+    for (int k = 0; k < length; ) {
+        if (!open(k)) {
+            ++k;
+            continue;
+        }
+        int runStart = k;
+        while (k < length && open(k)) {
+            ++k;
+        }
+        int runLength = k - runStart;
+        if (runLength < MAX_ENTRANCE_WIDTH) {
+            addEntrance(runStart + runLength / 2);
+        } else {
+            addEntrance(runStart);
+            addEntrance(k - 1);
+        }
+    }
+
+    return { clusterA, clusterB };
+}
+
+/**
+ * @brief Recomputes the intra-cluster edges between the nodes of a cluster.
+ *
+ * Runs one confined breadth-first search per node; nodes that cannot reach
+ * each other inside the cluster get no edge.
+ */
+void HierarchicalPathfinder::rebuildIntraEdges(int cluster)
+{
+    const std::vector<int>& ids = clusterNodes[cluster];
+    for (int id : ids) {
+        auto& edges = nodes[id].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [](const Edge& e) { return e.intra; }),
+                    edges.end());
+    }
+
+    for (int from : ids) {
+        clusterSearch(buildContext, cluster, nodes[from].row, nodes[from].col);
+        for (int to : ids) {
+            if (to == from) {
+                continue;
+            }
+            int idx = map.paddedIndex(nodes[to].row, nodes[to].col);
+            if (buildContext.isVisited(idx)) {
+                nodes[from].edges.push_back(Edge{ to, buildContext.gCost(idx), true });
+            }
+        }
+    }
+    ++clusterRebuilds;
+}
+
+/**
+ * @brief Adds an abstract node, reusing a free id when possible.
+ *
+ * @return The id of the new node.
+ */
+int HierarchicalPathfinder::addNode(int r, int c, int cluster)
+{
+    int id;
+    if (!freeNodes.empty()) {
+        id = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        id = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    }
+    AbstractNode& node = nodes[id];
+    node.row = r;
+    node.col = c;
+    node.cluster = cluster;
+    node.alive = true;
+    node.edges.clear();
+    clusterNodes[cluster].push_back(id);
+    return id;
+}
+
+/**
+ * @brief Removes an abstract node from its cluster and recycles its id.
+ *
+ * Edges pointing at the node are dropped when the cluster's intra edges and
+ * its border are rebuilt, which always accompanies a removal.
+ */
+void HierarchicalPathfinder::removeNode(int id)
+{
+    AbstractNode& node = nodes[id];
+    auto& ids = clusterNodes[node.cluster];
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+    node.alive = false;
+    node.edges.clear();
+    freeNodes.push_back(id);
+}
+
+/**
+ * @brief Breadth-first search confined to one cluster.
+ *
+ * Distances and parents are left in the context, indexed by padded cell index.
+ *
+ * @param context   Scratch buffers; reset by this call.
+ * @param cluster   Cluster to stay within.
+ * @param r, c      Start cell (inside the cluster).
+ * @param stopIndex Padded index at which to stop early, or -1.
+ */
+void HierarchicalPathfinder::clusterSearch(SearchContext& context, int cluster,
+                                           int r, int c, int stopIndex) const
+{
+    int r0, c0, r1, c1;
+    clusterBounds(cluster, r0, c0, r1, c1);
+
+    context.reset(map.getPaddedCellCount());
+    std::vector<SearchContext::Node>& queue = context.openList();
+
+    const int directions[4][2] = { {0, 1}, {1, 0}, {0, -1}, {-1, 0} };
+
+    queue.push_back(SearchContext::Node{ r, c, 0.0, 0.0 });
+    context.update(map.paddedIndex(r, c), 0.0, -1);
+
+    // The open list is used as a FIFO queue here
+    for (size_t head = 0; head < queue.size(); ++head) {
+        SearchContext::Node current = queue[head];
+        int currentIndex = map.paddedIndex(current.row, current.col);
+        if (currentIndex == stopIndex) {
+            break;
+        }
+        for (const auto& dir : directions) {
+            int nr = current.row + dir[0];
+            int nc = current.col + dir[1];
+            if (nr < r0 || nr >= r1 || nc < c0 || nc >= c1) {
+                continue;
+            }
+            int idx = map.paddedIndex(nr, nc);
+            if (!map.passable(idx) || context.isVisited(idx)) {
+                continue;
+            }
+            context.update(idx, current.gCost + 1, currentIndex);
+            queue.push_back(SearchContext::Node{ nr, nc, current.gCost + 1, 0.0 });
+        }
+    }
+}
+
+/**
+ * @brief Finds a path using the abstraction.
+ *
+ * @param queryMap  Must be the map given to the constructor; any other map
+ *                  is searched with Pathfinding::aStar instead.
+ * @param context   Scratch buffers reused between searches.
+ * @param startRow  Row index of the start cell.
+ * @param startCol  Column index of the start cell.
+ * @param goalRow   Row index of the goal cell.
+ * @param goalCol   Column index of the goal cell.
+ * @return A vector of (row, column) pairs from start to goal; empty if no
+ *         path is found.
+ */
+std::vector<std::pair<int,int>> HierarchicalPathfinder::findPath(const Map& queryMap,
+                                                                  SearchContext& context,
+                                                                  int startRow, int startCol,
+                                                                  int goalRow, int goalCol) const
+{
+    if (&queryMap != &map) {
+        return Pathfinding::aStar(queryMap, context, startRow, startCol, goalRow, goalCol);
+    }
+
+    std::vector<std::pair<int, int>> path;
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < map.getHeight() && c >= 0 && c < map.getWidth();
+    };
+    if (!inBounds(startRow, startCol) || !inBounds(goalRow, goalCol) ||
+        !map.passable(map.paddedIndex(goalRow, goalCol))) {
+        return path;
+    }
+    if (startRow == goalRow && startCol == goalCol) {
+        path.push_back({startRow, startCol});
+        return path;
+    }
+
+    const int nodeCount = static_cast<int>(nodes.size());
+    const int START = nodeCount;       // Virtual abstract node for the start
+    const int GOAL  = nodeCount + 1;   // Virtual abstract node for the goal
+    int startCluster = clusterOf(startRow, startCol);
+    int goalCluster  = clusterOf(goalRow, goalCol);
+    int goalIndex    = map.paddedIndex(goalRow, goalCol);
+
+    // Link the start and goal to the nodes of their clusters
+    std::vector<Edge> startLinks;
+    std::vector<Edge> goalLinks;   // Edge::to is the node linking *to* the goal
+    clusterSearch(context, startCluster, startRow, startCol);
+    for (int id : clusterNodes[startCluster]) {
+        int idx = map.paddedIndex(nodes[id].row, nodes[id].col);
+        if (context.isVisited(idx)) {
+            startLinks.push_back(Edge{ id, context.gCost(idx), true });
+        }
+    }
+    if (startCluster == goalCluster && context.isVisited(goalIndex)) {
+        startLinks.push_back(Edge{ GOAL, context.gCost(goalIndex), true });
+    }
+    clusterSearch(context, goalCluster, goalRow, goalCol);
+    for (int id : clusterNodes[goalCluster]) {
+        int idx = map.paddedIndex(nodes[id].row, nodes[id].col);
+        if (context.isVisited(idx)) {
+            goalLinks.push_back(Edge{ id, context.gCost(idx), true });
+        }
+    }
+
+    // Abstract A* over node ids (plus the two virtual nodes)
+    auto position = [&](int id, int& r, int& c) {
+        if (id == START)     { r = startRow; c = startCol; }
+        else if (id == GOAL) { r = goalRow;  c = goalCol;  }
+        else                 { r = nodes[id].row; c = nodes[id].col; }
+    };
+    auto heuristic = [&](int id) {
+        int r, c;
+        position(id, r, c);
+        return static_cast<double>(std::abs(r - goalRow) + std::abs(c - goalCol));
+    };
+
+    context.reset(nodeCount + 2);
+    using Entry = std::pair<double, int>;   // (fCost, node id)
+    std::vector<Entry> open;
+    auto later = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+
+    context.update(START, 0.0, -1);
+    open.push_back({ heuristic(START), START });
+    bool found = false;
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), later);
+        Entry top = open.back();
+        open.pop_back();
+        int id = top.second;
+        double g = context.gCost(id);
+        if (top.first > g + heuristic(id)) {
+            continue;   // Stale entry
+        }
+        if (id == GOAL) {
+            found = true;
+            break;
+        }
+
+        auto relax = [&](int to, double cost) {
+            double ng = g + cost;
+            if (ng < context.gCost(to)) {
+                context.update(to, ng, id);
+                open.push_back({ ng + heuristic(to), to });
+                std::push_heap(open.begin(), open.end(), later);
+            }
+        };
+
+        if (id == START) {
+            for (const Edge& e : startLinks) {
+                relax(e.to, e.cost);
+            }
+            continue;
+        }
+        for (const Edge& e : nodes[id].edges) {
+            relax(e.to, e.cost);
+        }
+        if (nodes[id].cluster == goalCluster) {
+            for (const Edge& e : goalLinks) {
+                if (e.to == id) {
+                    relax(GOAL, e.cost);
+                }
+            }
+        }
+    }
+    if (!found) {
+        return path;
+    }
+
+    std::vector<int> abstractPath;
+    for (int id = GOAL; id != -1; id = context.parent(id)) {
+        abstractPath.push_back(id);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    // Refine each abstract edge into cells
+    path.push_back({startRow, startCol});
+    for (size_t i = 1; i < abstractPath.size(); ++i) {
+        int fromId = abstractPath[i - 1];
+        int toId   = abstractPath[i];
+        int fr, fc, tr, tc;
+        position(fromId, fr, fc);
+        position(toId, tr, tc);
+        if (fr == tr && fc == tc) {
+            continue;   // Two nodes on the same corner cell
+        }
+
+        int fromCluster = fromId == START ? startCluster
+                        : fromId == GOAL  ? goalCluster : nodes[fromId].cluster;
+        int toCluster   = toId == START   ? startCluster
+                        : toId == GOAL    ? goalCluster : nodes[toId].cluster;
+        if (fromCluster != toCluster) {
+            // Entrance pair: adjacent cells
+            path.push_back({tr, tc});
+            continue;
+        }
+
+        int target = map.paddedIndex(tr, tc);
+        clusterSearch(context, fromCluster, fr, fc, target);
+        size_t segmentStart = path.size();
+        for (int idx = target; context.parent(idx) != -1; idx = context.parent(idx)) {
+            path.push_back({map.paddedRow(idx), map.paddedCol(idx)});
+        }
+        std::reverse(path.begin() + segmentStart, path.end());
+    }
+    return path;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+/******************************************************************************
+ * File:    HierarchicalPathfinder.h
+ *
+ * Overview:
+ *   This header declares the HierarchicalPathfinder class, an HPA*-style
+ *   engine for long-distance queries on large maps.
+ *
+ *   The map is split into square clusters of a fixed size. Along every
+ *   border between two clusters, each maximal run of cells that is open on
+ *   both sides becomes an entrance: one pair of abstract nodes in the middle
+ *   of a short run, or one pair at each end of a long run. Nodes inside a
+ *   cluster are linked by their exact in-cluster distances, nodes of an
+ *   entrance pair by a unit step.
+ *
+ *   A query links the start and goal into the abstract graph, searches that
+ *   small graph, then refines each abstract edge into cells with a search
+ *   confined to one cluster. Paths are 4-connected like Pathfinding::aStar,
+ *   but may be slightly longer than optimal.
+ *
+ *   The engine observes its Map: when Map::setCell changes passability, only
+ *   the cluster containing the cell (and the neighbors sharing an affected
+ *   border) are rebuilt.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "Pathfinder.h"
+#include "SearchContext.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class HierarchicalPathfinder
+ *
+ * @brief Cluster-based abstraction of a Map plus the query routine using it.
+ *
+ * Queries are const and may run concurrently with separate SearchContexts.
+ * Map changes must not happen while queries are running.
+ */
+class HierarchicalPathfinder : public Pathfinder, private MapObserver {
+public:
+    static constexpr int DEFAULT_CLUSTER_SIZE = 16;
+
+    /**
+     * @brief Builds the abstraction for the given map and starts observing it.
+     *
+     * @param map         Map to abstract; must outlive this object.
+     * @param clusterSize Side length of a cluster, in cells.
+     */
+    explicit HierarchicalPathfinder(const Map& map,
+                                    int clusterSize = DEFAULT_CLUSTER_SIZE);
+    ~HierarchicalPathfinder() override;
+
+    HierarchicalPathfinder(const HierarchicalPathfinder&) = delete;
+    HierarchicalPathfinder& operator=(const HierarchicalPathfinder&) = delete;
+
+    /**
+     * @brief Rebuilds the whole abstraction (done automatically when the map
+     *        is reloaded).
+     */
+    void rebuild();
+
+    /**
+     * @brief Finds a path using the abstraction.
+     *
+     * If a different map than the one passed to the constructor is given,
+     * the query falls back to Pathfinding::aStar.
+     */
+    std::vector<std::pair<int, int>> findPath(const Map& map,
+                                              SearchContext& context,
+                                              int startRow, int startCol,
+                                              int goalRow, int goalCol) const override;
+
+    const char* name() const override { return "hpa"; }
+
+    /**
+     * @return Side length of a cluster, in cells.
+     */
+    int getClusterSize() const { return clusterSize; }
+
+    /**
+     * @return Number of live abstract nodes.
+     */
+    int getAbstractNodeCount() const;
+
+    /**
+     * @return Total number of cluster rebuilds (full builds included).
+     */
+    size_t getClusterRebuildCount() const { return clusterRebuilds; }
+
+private:
+    /**
+     * @brief Abstract graph edge.
+     */
+    struct Edge {
+        int to;        // Target node id
+        double cost;   // Path length in cells
+        bool intra;    // True if both ends are in the same cluster
+    };
+
+    /**
+     * @brief Abstract graph node, located on a cluster border.
+     */
+    struct AbstractNode {
+        int row, col;
+        int cluster;
+        bool alive;
+        std::vector<Edge> edges;
+    };
+
+    // MapObserver: rebuild the clusters affected by a passability change
+    void onCellChanged(int r, int c) override;
+
+    // MapObserver: rebuild everything for the reloaded grid
+    void onMapReloaded() override;
+
+    // Cluster id of a cell
+    int clusterOf(int r, int c) const;
+
+    // Cell bounds of a cluster: rows [r0, r1), columns [c0, c1)
+    void clusterBounds(int cluster, int& r0, int& c0, int& r1, int& c1) const;
+
+    // Replaces the entrances of one border; returns the two adjacent clusters
+    std::pair<int, int> rebuildBorder(bool horizontal, int border);
+
+    // Recomputes the intra-cluster edges between the nodes of a cluster
+    void rebuildIntraEdges(int cluster);
+
+    int addNode(int r, int c, int cluster);
+    void removeNode(int id);
+
+    // Breadth-first search confined to one cluster, starting at (r, c).
+    // Stops early once stopIndex (a padded index) is reached, if given.
+    void clusterSearch(SearchContext& context, int cluster,
+                       int r, int c, int stopIndex = -1) const;
+
+    const Map& map;
+    int clusterSize;
+    int clustersX = 0;   // Clusters per row
+    int clustersY = 0;   // Clusters per column
+
+    std::vector<AbstractNode> nodes;             // Indexed by node id
+    std::vector<int> freeNodes;                  // Recycled node ids
+    std::vector<std::vector<int>> clusterNodes;  // Node ids per cluster
+    std::vector<std::vector<int>> hBorderNodes;  // Node ids per horizontal border
+    std::vector<std::vector<int>> vBorderNodes;  // Node ids per vertical border
+
+    SearchContext buildContext;  // Scratch buffers used while (re)building
+    size_t clusterRebuilds = 0;
+};
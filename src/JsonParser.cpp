@@ -4,7 +4,12 @@
  * Description:
  *   A manual (naive) JSON parser that finds the "layers" array,
  *   then within it finds the first "data" array, and extracts each numeric
- *   entry. These values get stored in 'linearGridArray'.
+ *   entry. These values get stored in 'linearGridArray'. The grid size,
+ *   if the file states it, is reported to the sink afterwards.
+ *
+ *   Inside the "data" array, delimiters are located 32 bytes at a time
+ *   (see SimdScan.h) and each number is converted with std::from_chars,
+ *   so long tile arrays are scanned without a per-character loop.
  *
  *   NOTE: This approach is fragile and does not handle nested objects or
  *   escaped quotes, among other complexities. It is meant only for
@@ -13,7 +18,9 @@
  * Usage:
  *   1) Include "JsonParser.h" in code.
  *   2) Create a JsonParser object, call parseJson(jsonString),
- *      and then retrieve the data via getGridData().
+ *      and then retrieve the data via getGridData(), or
+ *   3) Call JsonParser::parseJson(data, length, sink) on any buffer
+ *      (such as a MappedFile) to receive the values without storing them.
  *
  * Author: Tarun Trilokesh
  * Date:   2025-06-04
@@ -21,10 +28,136 @@
  ******************************************************************************/
 
 #include "JsonParser.h"
+#include "Logger.h"
+#include "SimdScan.h"
 #include <iostream>
+#include <algorithm> // for std::min, std::search, std::find
 #include <cctype>   // for std::isspace
-#include <cstring>  // for std::strncmp
-#include <cstdlib>  // for std::atof
+#include <charconv> // for std::from_chars
+#include <cstring>  // for std::memcmp, std::strlen, std::memcpy
+#include <cstdlib>  // for std::strtod
+
+namespace {
+
+// Appends every value to a vector
+class VectorSink : public JsonValueSink {
+public:
+    explicit VectorSink(std::vector<double>& out) : out(out) {}
+    void onValue(double value) override { out.push_back(value); }
+
+private:
+    std::vector<double>& out;
+};
+
+// True if [pos, end) starts with the given literal
+bool startsWith(const char* pos, const char* end, const char* literal)
+{
+    size_t length = std::strlen(literal);
+    return static_cast<size_t>(end - pos) >= length &&
+           std::memcmp(pos, literal, length) == 0;
+}
+
+// Converts one array element [begin, end): a number with optional
+// surrounding whitespace. Sets empty if the element holds no number.
+bool parseNumber(const char* begin, const char* end, double& value, bool& empty)
+{
+    while (begin < end && std::isspace((unsigned char)*begin)) {
+        ++begin;
+    }
+    while (end > begin && std::isspace((unsigned char)end[-1])) {
+        --end;
+    }
+    empty = (begin == end);
+    if (empty) {
+        return true;
+    }
+
+    // JSON has no leading '+', but the old parser accepted it
+    if (*begin == '+') {
+        ++begin;
+    }
+
+#if defined(__cpp_lib_to_chars)
+    auto result = std::from_chars(begin, end, value);
+    const char* stop = result.ptr;
+    bool ok = result.ec == std::errc();
+#else
+    // Older standard libraries lack floating-point from_chars
+    char numberBuffer[64];
+    size_t length = std::min(static_cast<size_t>(end - begin), sizeof(numberBuffer) - 1);
+    std::memcpy(numberBuffer, begin, length);
+    numberBuffer[length] = '\0';
+    char* parsedEnd;
+    value = std::strtod(numberBuffer, &parsedEnd);
+    const char* stop = begin + (parsedEnd - numberBuffer);
+    bool ok = parsedEnd != numberBuffer;
+#endif
+
+    if (!ok || stop != end) {
+        std::cerr << "Invalid character in numeric data: " << (ok ? *stop : *begin) << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Reads the integer after the first occurrence of key in [begin, end)
+bool readIntAfterKey(const char* begin, const char* end, const char* key, int& out)
+{
+    const char* found = std::search(begin, end, key, key + std::strlen(key));
+    if (found == end) {
+        return false;
+    }
+    const char* pos = found + std::strlen(key);
+    while (pos < end && (std::isspace((unsigned char)*pos) || *pos == ':')) {
+        ++pos;
+    }
+    auto result = std::from_chars(pos, end, out);
+    return result.ec == std::errc() && out > 0;
+}
+
+// Same, searching both sides of the skipped range [skipBegin, skipEnd)
+bool readIntAfterKey(const char* begin, const char* skipBegin, const char* skipEnd,
+                     const char* end, const char* key, int& out)
+{
+    return readIntAfterKey(begin, skipBegin, key, out) ||
+           readIntAfterKey(skipEnd, end, key, out);
+}
+
+// Finds the stated grid size around the "data" array [dataBegin, dataEnd)
+// of the layer starting at layerBegin; see JsonValueSink::onGridSize()
+bool findGridSize(const char* data, const char* end, const char* layerBegin,
+                  const char* dataBegin, const char* dataEnd, int& width, int& height)
+{
+    // The layer's own keys, up to the end of its object
+    const char* layerEnd = std::find(dataEnd, end, '}');
+    if (readIntAfterKey(layerBegin, dataBegin, dataEnd, layerEnd, "\"width\"", width) &&
+        readIntAfterKey(layerBegin, dataBegin, dataEnd, layerEnd, "\"height\"", height)) {
+        return true;
+    }
+
+    // Canvas pixels over tile pixels
+    const char* canvas = std::search(dataEnd, end, "\"canvas\"", "\"canvas\"" + 8);
+    if (canvas == end) {
+        canvas = std::search(data, dataBegin, "\"canvas\"", "\"canvas\"" + 8);
+        if (canvas == dataBegin) {
+            return false;
+        }
+    }
+    const char* canvasEnd = std::find(canvas, end, '}');
+    int canvasWidth, canvasHeight, tileWidth, tileHeight;
+    if (!readIntAfterKey(canvas, canvasEnd, "\"width\"", canvasWidth) ||
+        !readIntAfterKey(canvas, canvasEnd, "\"height\"", canvasHeight) ||
+        !readIntAfterKey(data, dataBegin, dataEnd, end, "\"tilewidth\"", tileWidth) ||
+        !readIntAfterKey(data, dataBegin, dataEnd, end, "\"tileheight\"", tileHeight) ||
+        canvasWidth % tileWidth != 0 || canvasHeight % tileHeight != 0) {
+        return false;
+    }
+    width = canvasWidth / tileWidth;
+    height = canvasHeight / tileHeight;
+    return true;
+}
+
+} // namespace
 
 /**
  * @brief Parses the JSON content, looking for "layers" and then "data" in
@@ -36,121 +169,136 @@
  */
 bool JsonParser::parseJson(const std::string& jsonData)
 {
-    // Convert std::string to C-style string for pointer-based parsing
-    const char* pos = jsonData.c_str();
+    VectorSink sink(linearGridArray);
+    return parseJson(jsonData.data(), jsonData.size(), sink);
+}
+
+/**
+ * @brief Parses JSON content from a buffer, passing each value to the sink.
+ *
+ * The scan is bounded by length rather than by a '\0', so the buffer can be
+ * a read-only file mapping. Parsing stops after the first "data" array;
+ * the grid size, if stated, is then looked up around it.
+ *
+ * @param data   Start of the JSON content.
+ * @param length Number of bytes in the buffer.
+ * @param sink   Receiver for the values of the "data" array.
+ * @return True if parsing succeeded and data was extracted; false otherwise.
+ */
+bool JsonParser::parseJson(const char* data, size_t length, JsonValueSink& sink)
+{
+    const char* pos = data;
+    const char* end = data + length;
 
     bool foundLayers = false;  // Whether we've encountered "layers"
-    bool readingData = false;  // Whether we're currently extracting "data" array values
+    size_t valueCount = 0;     // Number of values passed to the sink
+    const char* layerBegin = nullptr;  // Just inside the "layers" array
+    const char* dataBegin = nullptr;   // The '[' of the "data" array
+    const char* dataEnd = nullptr;     // Just past the "data" array
 
-    // Parse until the end of the string ('\0')
-    while(*pos != '\0') 
+    // Parse until the end of the buffer
+    while (pos < end)
     {
         // Skip any leading whitespace (spaces, tabs, newlines)
-        while (std::isspace((unsigned char)*pos)) {
+        while (pos < end && std::isspace((unsigned char)*pos)) {
             ++pos;
         }
 
-        // Locate the "layers" array by searching for the literal "\"layers\":"
-        if (!foundLayers && std::strncmp(pos, "\"layers\":", 8) == 0) {
+        // Locate the "layers" array by searching for the literal "\"layers\""
+        if (!foundLayers && startsWith(pos, end, "\"layers\"")) {
             foundLayers = true;
-            pos += 8; // Move the pointer past "\"layers\":"
+            pos += 8; // Move the pointer past "\"layers\""
 
-            // Move forward until we find '[' or end of string
-            while (*pos != '[' && *pos != '\0') {
+            // Move forward until we find '[' or end of buffer
+            while (pos < end && *pos != '[') {
                ++pos;
             }
+            layerBegin = pos;
         }
 
-        // Once we've found "layers", look for the "\"data\":"
-        if (foundLayers && std::strncmp(pos, "\"data\":", 6) == 0) {
-            // Move pointer past "\"data\":"
+        // Once we've found "layers", look for the "\"data\""
+        if (foundLayers && startsWith(pos, end, "\"data\"")) {
+            // Move pointer past "\"data\""
             pos += 6;
 
             // Move forward until we find the '[' that starts the "data" array
-            while (*pos != '[' && *pos != '\0') {
+            while (pos < end && *pos != '[') {
                 ++pos;
             }
-
-            // If we find '[', we are now ready to read the data
-            if (*pos == '[') {
-                ++pos;         // Move past '['
-                readingData = true;  // Indicate we're reading the tile data
+            if (pos == end) {
+                break;
             }
-        }
+            dataBegin = pos;
+            ++pos; // Move past '['
 
-        // If we are reading the "data" array, parse numbers until ']' or '\0'
-        if (readingData) {
-            // Keep reading tokens until we reach ']' or end of string
-            while (*pos != ']' && *pos != '\0') {
-                // Skip any whitespace between numbers
-                while (std::isspace((unsigned char)*pos)) {
-                    ++pos;
-                }
+            // Walk the delimiters block by block; each one ends an element
+            const char* elementStart = pos;
+            bool closed = false;
+            while (pos < end && !closed) {
+                size_t blockSize = std::min(SimdScan::BLOCK, static_cast<size_t>(end - pos));
+                uint32_t mask = blockSize == SimdScan::BLOCK
+                    ? SimdScan::delimiterMask(pos)
+                    : SimdScan::delimiterMaskScalar(pos, blockSize);
 
-                // If we hit ']' or end of string, break from data reading
-                if (*pos == ']' || *pos == '\0') {
-                    readingData = false;
-                    break;
-                }
+                while (mask != 0) {
+                    const char* delimiter = pos + SimdScan::lowestBit(mask);
+                    mask &= mask - 1;
 
-                // Temporary buffer to capture one numeric value
-                char numberBuffer[64];
-                int nbIndex = 0;
-
-                // Read the numeric characters (up to ',' or ']' or '\0')
-                while (*pos != ',' && *pos != ']' && *pos != '\0') {
-                    if (std::isdigit(*pos) || *pos == '.' || *pos == '-' || *pos == '+') {
-                        // Only allow valid numeric characters
-                        if (nbIndex < (int)sizeof(numberBuffer) - 1) {
-                            numberBuffer[nbIndex++] = *pos;
-                        }
-                    } else if (!std::isspace((unsigned char)*pos)) {
-                        // Log an error for invalid characters (excluding whitespace)
-                        std::cerr << "Invalid character in numeric data: " << *pos << "\n";
+                    double value;
+                    bool empty;
+                    if (!parseNumber(elementStart, delimiter, value, empty)) {
                         return false; // Exit on invalid character
                     }
-                    ++pos;
-                }
+                    if (!empty) {
+                        sink.onValue(value);
+                        ++valueCount;
+                    }
 
-                // Null-terminate the buffer to make a proper C-string
-                numberBuffer[nbIndex] = '\0';
-
-                // Convert this numeric string to a double
-                if (nbIndex > 0) {
-                    try {
-                        double numValue = std::atof(numberBuffer);
-                        // Store the number in the linearGridArray
-                        linearGridArray.push_back(numValue);
-                    } catch (...) {
-                        std::cerr << "Error converting number: " << numberBuffer << "\n";
-                        return false; // Exit on conversion error
+                    elementStart = delimiter + 1;
+                    if (*delimiter == ']') {
+                        closed = true;
+                        dataEnd = elementStart;
+                        break;
                     }
                 }
+                pos += blockSize;
+            }
 
-                // If we ended on a comma, skip it and move to next number
-                if (*pos == ',') {
-                    ++pos;
+            // Unterminated array: keep the last element, like the old parser
+            if (!closed) {
+                double value;
+                bool empty;
+                if (!parseNumber(elementStart, end, value, empty)) {
+                    return false;
+                }
+                if (!empty) {
+                    sink.onValue(value);
+                    ++valueCount;
                 }
             }
 
-            // If we see ']' here, we've finished reading the "data" array
-            if (*pos == ']') {
-                readingData = false;
-            }
+            // Only the first "data" array is read
+            break;
         }
 
-        // Move past the current character if it's not '\0'
-        if (*pos != '\0') {
+        // Move past the current character
+        if (pos < end) {
             ++pos;
         }
     }
 
+    int width, height;
+    if (valueCount > 0 && dataEnd &&
+        findGridSize(data, end, layerBegin, dataBegin, dataEnd, width, height)) {
+        sink.onGridSize(width, height);
+    }
+
     // Did we successfully extract any numbers?
-    if (!linearGridArray.empty()) {
-        std::cout << "Parsed grid data successfully!\n";
+    if (valueCount > 0) {
+        RTS_LOG(Info) << "Parsed grid data successfully!\n";
         return true;
     } else {
         std::cerr << "Failed to parse grid data.\n";
         return false;
     }
-} // end of parseJson
\ No newline at end of file
+} // end of parseJson
@@ -4,7 +4,8 @@
  * Description:
  * Parses the JSON content, looking for "layers" and then "data" in
  * the first layer. Extracts numeric values (including floating-point)
- * and stores them in linearGridArray.
+ * and either stores them in linearGridArray or hands them to a
+ * JsonValueSink as they are read.
  *
  * @param jsonData A string containing the entire JSON content.
  * @return True if parsing succeeded and data was extracted; false otherwise.
@@ -15,8 +16,27 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
+
+/**
+ * Receives the values of the "data" array one by one, in file order, so
+ * callers can decode tiles straight into their own storage.
+ */
+class JsonValueSink {
+public:
+    virtual ~JsonValueSink() = default;
+    virtual void onValue(double value) = 0;
+
+    /**
+     * Called after the values if the file states the grid size: the first
+     * layer's "width"/"height" (as in Tiled), or else "canvas" pixels
+     * divided by the tileset's "tilewidth"/"tileheight".
+     */
+    virtual void onGridSize(int /*width*/, int /*height*/) {}
+};
  
 class JsonParser {
 public:
@@ -29,18 +49,35 @@ public:
      * @return True if parsing succeeded and data was extracted; false otherwise.
      */
     bool parseJson(const std::string& jsonData);
+
+    /**
+     * Parses JSON content held in a buffer that need not be null-terminated
+     * (e.g. a memory-mapped file), passing every value to the sink instead
+     * of storing it.
+     *
+     * @param data   Start of the JSON content.
+     * @param length Number of bytes in the buffer.
+     * @param sink   Receiver for the values of the "data" array.
+     * @return True if parsing succeeded and data was extracted; false otherwise.
+     */
+    static bool parseJson(const char* data, size_t length, JsonValueSink& sink);
  
     /**
-     * Returns a copy of the flattened grid data extracted from the JSON file.
+     * Returns the flattened grid data extracted from the JSON file.
      * Each entry corresponds to one tile on the map.
      *
-     * @return A vector of integers (the flattened map data).
+     * @return A vector of doubles (the flattened map data).
+     */
+    const std::vector<double>& getGridData() const { return linearGridArray; }
+
+    /**
+     * Moves the flattened grid data out of the parser.
+     *
+     * @return A vector of doubles (the flattened map data).
      */
-    std::vector<double> getGridData() const { return linearGridArray; }
+    std::vector<double> takeGridData() { return std::move(linearGridArray); }
  
 private:
     // Stores the flattened map data from "layers[0].data"
     std::vector<double> linearGridArray;
 };
-
- 
\ No newline at end of file
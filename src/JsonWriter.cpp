@@ -0,0 +1,299 @@
+/******************************************************************************
+ * File:    JsonWriter.cpp
+ *
+ * Overview:
+ *   Implementation of the JsonWriter class and writeMapJson(...). Files are
+ *   written with plain open()/write() (_open()/_write() on Windows), one
+ *   buffer-sized chunk at a time.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "JsonWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Fixed parts of the output format
+const char MAP_JSON_PREFIX[] = R"({
+  "layers": [
+    {
+      "name": "world",
+      "tileset": "MapEditor Tileset_woodland.png",
+      "data": [
+)";
+
+const char MAP_JSON_SUFFIX[] = R"(
+      ]
+    }
+  ],
+  "tilesets": [
+    {
+      "name": "MapEditor Tileset_woodland.png",
+      "image": "MapEditor Tileset_woodland.png",
+      "imagewidth": 512,
+      "imageheight": 512,
+      "tilewidth": 32,
+      "tileheight": 32
+    }
+  ],
+  "canvas": {
+    "width": )";
+
+const int TILE_PIXELS = 32;  // Tile size of the tileset above; canvas = cells * TILE_PIXELS
+
+const size_t NUMBER_CAPACITY = 400;  // Enough for any double in fixed notation
+
+// Writes all bytes, retrying after partial writes and interrupts
+bool writeAll(int fd, const char* data, size_t length)
+{
+    while (length > 0) {
+#ifdef _WIN32
+        int chunk = length > (1u << 30) ? (1 << 30) : static_cast<int>(length);
+        int written = _write(fd, data, chunk);
+#else
+        ssize_t written = ::write(fd, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Fallback for standard libraries without floating-point to_chars
+#if !defined(__cpp_lib_to_chars)
+size_t printNumber(char* out, const char* format, double value)
+{
+    int n = std::snprintf(out, NUMBER_CAPACITY, format, value);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+#endif
+
+} // namespace
+
+JsonWriter::JsonWriter()
+    : buffer(BUFFER_SIZE)
+{
+}
+
+JsonWriter::JsonWriter(std::string& target)
+    : buffer(BUFFER_SIZE), target(&target)
+{
+}
+
+JsonWriter::~JsonWriter()
+{
+    close();
+}
+
+/**
+ * @brief Creates (or truncates) a file and directs output to it.
+ *
+ * @param filePath Destination path.
+ * @return True if the file could be opened.
+ */
+bool JsonWriter::open(const std::string& filePath)
+{
+    close();
+    failed = false;
+    target = nullptr;
+#ifdef _WIN32
+    fd = _open(filePath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+               _S_IREAD | _S_IWRITE);
+#else
+    fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    return fd >= 0;
+}
+
+/**
+ * @brief Appends raw bytes, flushing whenever the buffer fills up.
+ */
+void JsonWriter::write(const char* data, size_t length)
+{
+    while (length > 0) {
+        if (used == buffer.size() && !flush()) {
+            return;
+        }
+        size_t chunk = std::min(length, buffer.size() - used);
+        std::memcpy(buffer.data() + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+/**
+ * @brief Appends a number in the given format.
+ */
+void JsonWriter::writeNumber(double value, TileNumberFormat format)
+{
+    if (buffer.size() - used < NUMBER_CAPACITY && !flush()) {
+        return;
+    }
+    used += formatNumber(value, format, buffer.data() + used);
+}
+
+/**
+ * @brief Formats a number into out (at least 400 bytes).
+ *
+ * Fixed gives the same text as std::to_string. Integral prints whole
+ * numbers without decimals and everything else in the shortest form that
+ * reads back exactly.
+ *
+ * @return Number of characters written.
+ */
+size_t JsonWriter::formatNumber(double value, TileNumberFormat format, char* out)
+{
+    char* end = out + NUMBER_CAPACITY;
+    bool integral = format == TileNumberFormat::Integral &&
+                    std::isfinite(value) && std::fabs(value) < 1e15 &&
+                    value == std::trunc(value);
+#if defined(__cpp_lib_to_chars)
+    std::to_chars_result result;
+    if (integral) {
+        result = std::to_chars(out, end, static_cast<long long>(value));
+    } else if (format == TileNumberFormat::Integral) {
+        result = std::to_chars(out, end, value);
+    } else {
+        result = std::to_chars(out, end, value, std::chars_format::fixed, 6);
+    }
+    return static_cast<size_t>(result.ptr - out);
+#else
+    (void)end;
+    if (integral) {
+        return printNumber(out, "%.0f", value);
+    }
+    return printNumber(out, format == TileNumberFormat::Integral ? "%.17g" : "%f", value);
+#endif
+}
+
+/**
+ * @brief Writes the buffered bytes out.
+ *
+ * @return False if any write so far has failed.
+ */
+bool JsonWriter::flush()
+{
+    if (failed) {
+        used = 0;
+        return false;
+    }
+    if (used > 0) {
+        if (target) {
+            target->append(buffer.data(), used);
+        } else if (fd < 0 || !writeAll(fd, buffer.data(), used)) {
+            failed = true;
+        }
+        used = 0;
+    }
+    return !failed;
+}
+
+/**
+ * @brief Flushes and closes the file (if any).
+ *
+ * @return False if any write so far has failed.
+ */
+bool JsonWriter::close()
+{
+    bool ok = flush();
+    if (fd >= 0) {
+#ifdef _WIN32
+        ok = _close(fd) == 0 && ok;
+#else
+        ok = ::close(fd) == 0 && ok;
+#endif
+        fd = -1;
+    }
+    return ok;
+}
+
+/**
+ * @brief Streams a Map as Tiled-like JSON.
+ *
+ * The data array is written row by row from the tile ids, each cell copying
+ * the text of its dictionary entry.
+ *
+ * @param map    Map to write.
+ * @param writer Destination.
+ * @param format How tile values are printed.
+ * @return False if writing failed.
+ */
+bool writeMapJson(const Map& map, JsonWriter& writer, TileNumberFormat format)
+{
+    // Format every distinct tile value once, with its trailing separator
+    std::vector<std::string> tileText(map.getTileDictionarySize());
+    char number[NUMBER_CAPACITY];
+    for (size_t id = 0; id < tileText.size(); ++id) {
+        size_t length = JsonWriter::formatNumber(map.tileValue(static_cast<uint16_t>(id)),
+                                                 format, number);
+        tileText[id].assign(number, length);
+        tileText[id] += ", ";
+    }
+
+    writer.write(MAP_JSON_PREFIX, sizeof(MAP_JSON_PREFIX) - 1);
+    int w = map.getWidth();
+    int h = map.getHeight();
+    for (int r = 0; r < h; ++r) {
+        const uint16_t* ids = map.tileRow(r);
+        for (int c = 0; c < w; ++c) {
+            const std::string& text = tileText[ids[c]];
+            // No separator after the last cell
+            bool last = (r == h - 1 && c == w - 1);
+            writer.write(text.data(), last ? text.size() - 2 : text.size());
+        }
+    }
+    writer.write(MAP_JSON_SUFFIX, sizeof(MAP_JSON_SUFFIX) - 1);
+
+    // The canvas states the grid size, so non-square maps load back as-is
+    std::string canvas = std::to_string(w * TILE_PIXELS) + ",\n    \"height\": " +
+                         std::to_string(h * TILE_PIXELS) + "\n  }\n}\n";
+    writer.write(canvas.data(), canvas.size());
+    return writer.flush();
+}
+
+/**
+ * @brief Streams a Map as JSON to a file.
+ *
+ * @param map      Map to write.
+ * @param filePath Destination path.
+ * @param format   How tile values are printed.
+ * @return False if the file could not be opened or written.
+ */
+bool writeMapJson(const Map& map, const std::string& filePath, TileNumberFormat format)
+{
+    JsonWriter writer;
+    if (!writer.open(filePath)) {
+        std::cerr << "Error opening file for writing: " << filePath << std::endl;
+        return false;
+    }
+    writeMapJson(map, writer, format);
+    if (!writer.close()) {
+        std::cerr << "Error writing file: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/******************************************************************************
+ * File:    JsonWriter.h
+ *
+ * Overview:
+ *   This header declares the JsonWriter class, a small buffered writer that
+ *   sends its output either straight to a file descriptor or into a
+ *   std::string, and writeMapJson(...), which streams a Map as Tiled-like
+ *   JSON through it.
+ *
+ *   Output goes through one fixed-size chunk buffer, so writing a map to a
+ *   file uses constant memory regardless of the map size. Every distinct
+ *   tile value is formatted once with std::to_chars; each cell then only
+ *   copies the pre-formatted text of its tile id.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @enum TileNumberFormat
+ * @brief How tile values are printed.
+ */
+enum class TileNumberFormat {
+    Fixed,     ///< Six decimals, like std::to_string ("3.000000")
+    Integral   ///< Integral values without decimals ("3"), others shortest ("0.5")
+};
+
+/**
+ * @class JsonWriter
+ *
+ * @brief Buffered output to a file descriptor or a string.
+ *
+ * Errors are sticky: once a write fails, later writes are dropped and
+ * flush()/close() return false.
+ */
+class JsonWriter {
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    JsonWriter();
+
+    /**
+     * @brief Creates a writer that appends to target instead of a file.
+     */
+    explicit JsonWriter(std::string& target);
+
+    ~JsonWriter();
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /**
+     * @brief Creates (or truncates) a file and directs output to it.
+     *
+     * @param filePath Destination path.
+     * @return True if the file could be opened.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Appends raw bytes.
+     */
+    void write(const char* data, size_t length);
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    /**
+     * @brief Appends a number in the given format.
+     */
+    void writeNumber(double value, TileNumberFormat format);
+
+    /**
+     * @brief Writes the buffered bytes out.
+     *
+     * @return False if any write so far has failed.
+     */
+    bool flush();
+
+    /**
+     * @brief Flushes and closes the file (if any).
+     *
+     * @return False if any write so far has failed.
+     */
+    bool close();
+
+    /**
+     * @brief Formats a number into out (at least 400 bytes).
+     *
+     * @return Number of characters written.
+     */
+    static size_t formatNumber(double value, TileNumberFormat format, char* out);
+
+private:
+    std::vector<char> buffer;        ///< Fixed-size chunk buffer
+    size_t used = 0;                 ///< Bytes pending in buffer
+    int fd = -1;                     ///< Destination file, if any
+    std::string* target = nullptr;   ///< Destination string, if any
+    bool failed = false;             ///< Sticky error flag
+};
+
+/**
+ * @brief Streams a Map as Tiled-like JSON ("layers[0].data" plus a tileset).
+ *
+ * @param map    Map to write.
+ * @param writer Destination.
+ * @param format How tile values are printed.
+ * @return False if writing failed.
+ */
+bool writeMapJson(const Map& map, JsonWriter& writer,
+                  TileNumberFormat format = TileNumberFormat::Fixed);
+
+/**
+ * @brief Streams a Map as JSON to a file.
+ *
+ * @param map      Map to write.
+ * @param filePath Destination path.
+ * @param format   How tile values are printed.
+ * @return False if the file could not be opened or written.
+ */
+bool writeMapJson(const Map& map, const std::string& filePath,
+                  TileNumberFormat format = TileNumberFormat::Fixed);
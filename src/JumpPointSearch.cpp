@@ -0,0 +1,367 @@
+/******************************************************************************
+ * File:    JumpPointSearch.cpp
+ *
+ * Overview:
+ *   This file contains the implementation of the JumpPointSearch class.
+ *
+ *   Highlights:
+ *   - Jumps are iterative, so long corridors on large maps cannot overflow
+ *     the call stack.
+ *   - Neighbor pruning and forced-neighbor tests follow the "no corner
+ *     cutting" variant of JPS: a diagonal move needs both orthogonal
+ *     neighbors open, so diagonal moves have no forced neighbors, and a
+ *     straight move only turns toward a side cell whose cell behind is
+ *     blocked.
+ *   - Unreachable goals are rejected in O(1) from the map's connected
+ *     areas, as by Pathfinding::aStar.
+ *   - Only jump points are stored in the SearchContext; the returned path is
+ *     expanded cell by cell between consecutive jump points.
+ *   - Passability is read from the map's padded bitset, so the blocked
+ *     border terminates every jump without bounds checks. Straight jumps
+ *     test 64 cells per step, along rows of that bitset and along columns
+ *     of its transposed copy.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "JumpPointSearch.h"
+#include "Pathfinding.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+const double SQRT2 = 1.4142135623730951;
+
+// Sign of an integer (-1, 0 or 1)
+int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+// Index of the lowest / highest set bit; mask must not be 0
+int lowestBit(uint64_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+int highestBit(uint64_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(mask);
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Octile distance between two cells (straight cost 1, diagonal sqrt(2)).
+ *
+ * @param r1 Row index of the first cell.
+ * @param c1 Column index of the first cell.
+ * @param r2 Row index of the second cell.
+ * @param c2 Column index of the second cell.
+ * @return   Estimated distance between the two cells.
+ */
+double JumpPointSearch::heuristic(int r1, int c1, int r2, int c2) {
+    int dr = std::abs(r1 - r2);
+    int dc = std::abs(c1 - c2);
+    return (dr + dc) + (SQRT2 - 2.0) * std::min(dr, dc);
+}
+
+/**
+ * @brief Jumps in a straight line (dr or dc is 0) until a jump point is found.
+ *
+ * A cell is a jump point if it is the goal or if a side neighbor is open
+ * while the cell behind that side neighbor is blocked (a forced neighbor).
+ *
+ * The line is scanned 64 cells at a time: rows in the map's padded bitset,
+ * columns in its transposed copy, where the cells of a line are consecutive
+ * bits and the side lines lie one stride away. The first cell that is
+ * blocked, forced or the goal ends the scan; the blocked border guarantees
+ * one exists.
+ *
+ * @return True if a jump point was found; it is written to outRow/outCol.
+ */
+bool JumpPointSearch::jumpStraight(const Map& map, int r, int c, int dr, int dc,
+                                   int goalRow, int goalCol,
+                                   int& outRow, int& outCol)
+{
+    const bool horizontal = dc != 0;
+    const int step = horizontal ? dc : dr;
+    const int side = horizontal ? map.getStride() : map.getHeight() + 2;
+    auto window = [&](int idx) {
+        return horizontal ? map.passableWindow(idx) : map.passableColumnWindow(idx);
+    };
+    const int start = horizontal ? map.paddedIndex(r, c) : map.transposedIndex(r, c);
+    const bool goalOnLine = horizontal ? goalRow == r : goalCol == c;
+    const int goal = horizontal ? map.paddedIndex(goalRow, goalCol)
+                                : map.transposedIndex(goalRow, goalCol);
+
+    // Each window covers 64 cells ahead; backward scans read them from the top bit
+    for (int pos = start; ; pos += 64 * step) {
+        const int base = step > 0 ? pos : pos - 63;
+        uint64_t open = window(base);
+        uint64_t forced = (window(base - side) & ~window(base - side - step)) |
+                          (window(base + side) & ~window(base + side - step));
+        uint64_t stop = ~open | forced;
+        if (goalOnLine && goal >= base && goal < base + 64) {
+            stop |= uint64_t(1) << (goal - base);
+        }
+        if (stop == 0) {
+            continue;
+        }
+        int bit = step > 0 ? lowestBit(stop) : highestBit(stop);
+        if (!((open >> bit) & 1)) {
+            return false;
+        }
+        int distance = std::abs(base + bit - start);
+        outRow = r + dr * distance;
+        outCol = c + dc * distance;
+        return true;
+    }
+}
+
+/**
+ * @brief Jumps from (r, c) in direction (dr, dc) until a jump point is found.
+ *
+ * Diagonal jumps stop at any cell from which a straight jump along either
+ * component direction finds a jump point.
+ *
+ * @return True if a jump point was found; it is written to outRow/outCol.
+ */
+bool JumpPointSearch::jump(const Map& map, int r, int c, int dr, int dc,
+                           int goalRow, int goalCol, int& outRow, int& outCol)
+{
+    if (dr == 0 || dc == 0) {
+        return jumpStraight(map, r, c, dr, dc, goalRow, goalCol, outRow, outCol);
+    }
+
+    auto walkable = [&](int rr, int cc) {
+        return map.passable(map.paddedIndex(rr, cc));
+    };
+
+    while (walkable(r, c)) {
+        if (r == goalRow && c == goalCol) {
+            outRow = r;
+            outCol = c;
+            return true;
+        }
+
+        // Check for straight jump points reachable from this cell
+        int ignoreRow, ignoreCol;
+        if (jumpStraight(map, r + dr, c, dr, 0, goalRow, goalCol, ignoreRow, ignoreCol) ||
+            jumpStraight(map, r, c + dc, 0, dc, goalRow, goalCol, ignoreRow, ignoreCol)) {
+            outRow = r;
+            outCol = c;
+            return true;
+        }
+
+        // No corner cutting: both orthogonal cells must be open to continue
+        if (!walkable(r + dr, c) || !walkable(r, c + dc)) {
+            return false;
+        }
+        r += dr;
+        c += dc;
+    }
+    return false;
+}
+
+/**
+ * @brief Main Jump Point Search routine.
+ *
+ * @param map       Reference to the Map object containing the grid data.
+ * @param context   Scratch buffers reused between searches.
+ * @param startRow  Row index of the start cell.
+ * @param startCol  Column index of the start cell.
+ * @param goalRow   Row index of the goal cell.
+ * @param goalCol   Column index of the goal cell.
+ *
+ * @return A vector of (row, column) pairs that represents the path from start to goal.
+ *         Returns an empty vector if no path is found.
+ */
+std::vector<std::pair<int,int>> JumpPointSearch::findPath(const Map& map,
+                                                           SearchContext& context,
+                                                           int startRow, int startCol,
+                                                           int goalRow, int goalCol)
+{
+    // Jump points expanded and pushed, for the Statistics counters
+    SearchStats* stats = nullptr;
+    SearchRecord record(stats);
+
+    // Diagonals need both orthogonal cells open, so the 4-connected areas
+    // of the map are exactly the areas this search can reach
+    std::vector<std::pair<int, int>> path;
+    if (!Pathfinding::acceptEndpoints(map, startRow, startCol, goalRow, goalCol)) {
+        return path;
+    }
+
+    auto walkable = [&](int r, int c) {
+        return map.passable(map.paddedIndex(r, c));
+    };
+
+    context.reset(map.getPaddedCellCount());
+
+    using Node = SearchContext::Node;
+    std::vector<Node>& openSet = context.openList();
+    SearchContext::NodeComparator compare;
+
+    openSet.push_back(Node{ startRow, startCol, 0.0,
+                            heuristic(startRow, startCol, goalRow, goalCol) });
+    context.update(map.paddedIndex(startRow, startCol), 0.0, -1);
+
+    bool foundPath = false;
+    size_t expansions = 0;
+    size_t pushes = 1;
+    size_t peakOpenSize = 1;
+
+    // Candidate directions for the current node (at most 8)
+    int dirs[8][2];
+
+    while (!openSet.empty()) {
+        std::pop_heap(openSet.begin(), openSet.end(), compare);
+        Node current = openSet.back();
+        openSet.pop_back();
+
+        int r = current.row;
+        int c = current.col;
+        int currentIndex = map.paddedIndex(r, c);
+
+        // Skip entries that were superseded by a cheaper push
+        if (current.gCost > context.gCost(currentIndex)) {
+            continue;
+        }
+
+        if (r == goalRow && c == goalCol) {
+            foundPath = true;
+            break;
+        }
+        ++expansions;
+
+        // Collect the pruned set of directions to jump along
+        int dirCount = 0;
+        auto addDir = [&](int dr, int dc) {
+            dirs[dirCount][0] = dr;
+            dirs[dirCount][1] = dc;
+            ++dirCount;
+        };
+
+        int parentIndex = context.parent(currentIndex);
+        if (parentIndex < 0) {
+            // Start node: every open neighbor, diagonals without corner cutting
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    if ((dr == 0 && dc == 0) || !walkable(r + dr, c + dc)) {
+                        continue;
+                    }
+                    if (dr != 0 && dc != 0 &&
+                        (!walkable(r + dr, c) || !walkable(r, c + dc))) {
+                        continue;
+                    }
+                    addDir(dr, dc);
+                }
+            }
+        } else {
+            int dr = sign(r - map.paddedRow(parentIndex));
+            int dc = sign(c - map.paddedCol(parentIndex));
+
+            if (dr != 0 && dc != 0) {
+                // Diagonal: both components, plus the diagonal itself
+                bool vertical   = walkable(r + dr, c);
+                bool horizontal = walkable(r, c + dc);
+                if (vertical)   addDir(dr, 0);
+                if (horizontal) addDir(0, dc);
+                if (vertical && horizontal) addDir(dr, dc);
+            } else if (dc != 0) {
+                // Horizontal: ahead, plus the forced neighbors above and below
+                // (as in jumpStraight) and the diagonals past them
+                bool next  = walkable(r, c + dc);
+                bool below = walkable(r + 1, c) && !walkable(r + 1, c - dc);
+                bool above = walkable(r - 1, c) && !walkable(r - 1, c - dc);
+                if (next) {
+                    addDir(0, dc);
+                    if (below) addDir(1, dc);
+                    if (above) addDir(-1, dc);
+                }
+                if (below) addDir(1, 0);
+                if (above) addDir(-1, 0);
+            } else {
+                // Vertical: ahead, plus the forced neighbors left and right
+                bool next  = walkable(r + dr, c);
+                bool right = walkable(r, c + 1) && !walkable(r - dr, c + 1);
+                bool left  = walkable(r, c - 1) && !walkable(r - dr, c - 1);
+                if (next) {
+                    addDir(dr, 0);
+                    if (right) addDir(dr, 1);
+                    if (left)  addDir(dr, -1);
+                }
+                if (right) addDir(0, 1);
+                if (left)  addDir(0, -1);
+            }
+        }
+
+        // Jump along each direction and push the jump points found
+        for (int i = 0; i < dirCount; ++i) {
+            int jr, jc;
+            if (!jump(map, r + dirs[i][0], c + dirs[i][1], dirs[i][0], dirs[i][1],
+                      goalRow, goalCol, jr, jc)) {
+                continue;
+            }
+
+            // Segments between jump points are straight or diagonal lines
+            double newGCost = current.gCost + heuristic(r, c, jr, jc);
+            int jumpIndex = map.paddedIndex(jr, jc);
+            if (newGCost < context.gCost(jumpIndex)) {
+                context.update(jumpIndex, newGCost, currentIndex);
+                openSet.push_back(Node{ jr, jc, newGCost,
+                                        heuristic(jr, jc, goalRow, goalCol) });
+                std::push_heap(openSet.begin(), openSet.end(), compare);
+                ++pushes;
+                peakOpenSize = std::max(peakOpenSize, openSet.size());
+            }
+        }
+    }
+    if (stats) {
+        stats->expansions = expansions;
+        stats->pushes = pushes;
+        stats->peakOpenSize = peakOpenSize;
+    }
+
+    if (foundPath) {
+        // Walk back over the jump points, expanding each segment cell by cell
+        int idx = map.paddedIndex(goalRow, goalCol);
+        path.push_back({goalRow, goalCol});
+        for (int parentIdx = context.parent(idx);
+             parentIdx != -1;
+             idx = parentIdx, parentIdx = context.parent(idx)) {
+            int r  = map.paddedRow(idx);
+            int c  = map.paddedCol(idx);
+            int pr = map.paddedRow(parentIdx);
+            int pc = map.paddedCol(parentIdx);
+            int dr = sign(pr - r);
+            int dc = sign(pc - c);
+            while (r != pr || c != pc) {
+                r += dr;
+                c += dc;
+                path.push_back({r, c});
+            }
+        }
+        std::reverse(path.begin(), path.end());
+    }
+    return path;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/******************************************************************************
+ * File:    JumpPointSearch.h
+ *
+ * Overview:
+ *   This header declares the JumpPointSearch class, an 8-connected search for
+ *   uniform-cost grids. Jump Point Search prunes the symmetric paths that
+ *   plain A* expands on open terrain: from each node it "jumps" in straight
+ *   or diagonal lines and only pushes cells that have forced neighbors, so
+ *   the open list holds a handful of jump points instead of whole regions.
+ *
+ *   Movement rules:
+ *   - Straight steps cost 1, diagonal steps cost sqrt(2).
+ *   - No corner cutting: a diagonal step is only allowed when both
+ *     orthogonally adjacent cells are passable.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "SearchContext.h"
+#include <vector>
+#include <utility>
+
+/**
+ * @class JumpPointSearch
+ *
+ * @brief Contains static methods for Jump Point Search on a Map.
+ */
+class JumpPointSearch {
+public:
+    /**
+     * @brief Run Jump Point Search on the given map.
+     *
+     * The returned path lists every cell (jump points are expanded), so it
+     * has the same shape as Pathfinding::aStar output, but consecutive cells
+     * may be diagonal neighbors.
+     *
+     * @param map       Reference to the Map object.
+     * @param context   Scratch buffers reused between searches.
+     * @param startRow  Row index of the start cell.
+     * @param startCol  Column index of the start cell.
+     * @param goalRow   Row index of the goal cell.
+     * @param goalCol   Column index of the goal cell.
+     * @return          A vector of (row, column) pairs representing the path
+     *                  from start to goal. Empty if no path is found.
+     */
+    static std::vector<std::pair<int, int>> findPath(const Map& map,
+                                                     SearchContext& context,
+                                                     int startRow,
+                                                     int startCol,
+                                                     int goalRow,
+                                                     int goalCol);
+
+private:
+    /**
+     * @brief Octile distance, the exact cost between two cells on an open grid.
+     */
+    static double heuristic(int r1, int c1, int r2, int c2);
+
+    /**
+     * @brief Jumps from (r, c) in direction (dr, dc) until a jump point is found.
+     *
+     * @param map     Reference to the Map object.
+     * @param r, c    Cell to start jumping from (the step has already been taken).
+     * @param dr, dc  Direction of travel; each component is -1, 0 or 1.
+     * @param goalRow, goalCol  Goal cell, which is always a jump point.
+     * @param outRow, outCol   The jump point, if one is found.
+     * @return        True if a jump point was found.
+     */
+    static bool jump(const Map& map, int r, int c, int dr, int dc,
+                     int goalRow, int goalCol, int& outRow, int& outCol);
+
+    /**
+     * @brief Straight-line part of jump(); dr or dc must be 0.
+     */
+    static bool jumpStraight(const Map& map, int r, int c, int dr, int dc,
+                             int goalRow, int goalCol, int& outRow, int& outCol);
+};
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * File:    LandmarkTable.cpp
+ *
+ * Overview:
+ *   Implementation of the LandmarkTable class.
+ *
+ *   Highlights:
+ *   - The largest connected area is found first (each cell is visited by at
+ *     most one component search), so landmarks are not wasted on pockets
+ *     that few queries touch.
+ *   - Farthest-point selection: the first landmark is the cell farthest
+ *     from a seed, each further one the cell farthest from all landmarks
+ *     chosen so far. Landmarks thus end up on the periphery, where the
+ *     triangle bound is tightest.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "LandmarkTable.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const uint32_t NOT_REACHED = std::numeric_limits<uint32_t>::max();
+
+// Breadth-first search over padded cells; order receives the cells reached
+void breadthFirst(const Map& map, int source, std::vector<uint32_t>& dist,
+                  std::vector<int>& order)
+{
+    const int stride = map.getStride();
+    const int offsets[4] = {1, stride, -1, -stride};
+    dist.assign(static_cast<size_t>(map.getPaddedCellCount()), NOT_REACHED);
+    order.clear();
+    dist[source] = 0;
+    order.push_back(source);
+    for (size_t head = 0; head < order.size(); ++head) {
+        int cell = order[head];
+        for (int offset : offsets) {
+            int next = cell + offset;
+            if (map.passable(next) && dist[next] == NOT_REACHED) {
+                dist[next] = dist[cell] + 1;
+                order.push_back(next);
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Chooses the landmarks and builds their distance tables.
+ *
+ * @param map   Map to preprocess.
+ * @param landmarkCount Number of landmarks (clamped to 1..MAX_LANDMARK_COUNT).
+ */
+void LandmarkTable::build(const Map& map, int landmarkCount)
+{
+    width = map.getWidth();
+    height = map.getHeight();
+    mapVersion = map.getVersion();
+    landmarks.clear();
+    distances.clear();
+    count = 0;
+
+    // Seed: any cell of the largest connected area
+    const int stride = map.getStride();
+    const int offsets[4] = {1, stride, -1, -stride};
+    std::vector<uint8_t> seen(static_cast<size_t>(map.getPaddedCellCount()), 0);
+    std::vector<int> order;
+    int seed = -1;
+    size_t seedSize = 0;
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            int cell = map.paddedIndex(r, c);
+            if (!map.passable(cell) || seen[cell]) {
+                continue;
+            }
+            order.assign(1, cell);
+            seen[cell] = 1;
+            for (size_t head = 0; head < order.size(); ++head) {
+                for (int offset : offsets) {
+                    int next = order[head] + offset;
+                    if (map.passable(next) && !seen[next]) {
+                        seen[next] = 1;
+                        order.push_back(next);
+                    }
+                }
+            }
+            if (order.size() > seedSize) {
+                seedSize = order.size();
+                seed = cell;
+            }
+        }
+    }
+    if (seed < 0) {
+        return;
+    }
+
+    int wanted = std::min(std::max(landmarkCount, 1), MAX_LANDMARK_COUNT);
+    count = static_cast<int>(std::min<size_t>(wanted, seedSize));
+    distances.assign(static_cast<size_t>(map.getPaddedCellCount()) * count, UNREACHABLE);
+
+    // Distance to the nearest chosen landmark, over the seed's area
+    std::vector<uint32_t> dist;
+    breadthFirst(map, seed, dist, order);
+    std::vector<int> area = order;
+    std::vector<uint32_t> nearest = dist;
+
+    for (int k = 0; k < count; ++k) {
+        int landmark = area[0];
+        for (int cell : area) {
+            if (nearest[cell] > nearest[landmark]) {
+                landmark = cell;
+            }
+        }
+        landmarks.push_back({map.paddedRow(landmark), map.paddedCol(landmark)});
+
+        breadthFirst(map, landmark, dist, order);
+        for (int cell : order) {
+            distances[static_cast<size_t>(cell) * count + k] =
+                static_cast<uint16_t>(std::min<uint32_t>(dist[cell], UNREACHABLE - 1));
+            // The seed only picks the first landmark
+            nearest[cell] = k == 0 ? dist[cell] : std::min(nearest[cell], dist[cell]);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+/******************************************************************************
+ * File:    LandmarkTable.h
+ *
+ * Overview:
+ *   This header declares the LandmarkTable class, the precomputed data of
+ *   the ALT heuristic (A*, Landmarks, Triangle inequality).
+ *
+ *   A few landmark cells are chosen by farthest-point selection inside the
+ *   largest connected area, and a breadth-first search from each records
+ *   its exact distance to every cell. For any landmark L, the triangle
+ *   inequality gives |d(L, a) - d(L, b)| <= d(a, b), so the best such bound
+ *   over all landmarks is an admissible heuristic. Behind walls and in
+ *   mazes it is far tighter than the Manhattan distance, which lets exact
+ *   A* skip most of the dead ends it would otherwise explore.
+ *
+ *   Distances are uint16 (saturated, which keeps the bound admissible) and
+ *   interleaved per cell, so one lookup touches one cache line. Tables can
+ *   be built offline and stored in a ".rtsmap" file (see BinaryMap).
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+/**
+ * @class LandmarkTable
+ *
+ * @brief Landmark distance tables for one map version.
+ *
+ * A built table is read-only and may be shared between threads.
+ */
+class LandmarkTable {
+public:
+    static constexpr int DEFAULT_LANDMARK_COUNT = 8;
+    static constexpr int MAX_LANDMARK_COUNT = 64;
+
+    /// Distance value of cells a landmark cannot reach
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+    /**
+     * @brief Chooses up to count landmarks and builds their distance tables.
+     *
+     * Fewer landmarks are kept if the largest connected area has fewer
+     * cells; a map without passable cells yields an empty table.
+     *
+     * @param map   Map to preprocess.
+     * @param landmarkCount Number of landmarks (1..MAX_LANDMARK_COUNT).
+     */
+    void build(const Map& map, int landmarkCount = DEFAULT_LANDMARK_COUNT);
+
+    /**
+     * @return True if the table was built (or loaded) for the map's current
+     *         version. Stale tables may overestimate and must not be used.
+     */
+    bool isCurrent(const Map& map) const {
+        return count > 0 && mapVersion == map.getVersion() &&
+               width == map.getWidth() && height == map.getHeight();
+    }
+
+    /**
+     * @return Number of landmarks; 0 if the table is empty.
+     */
+    int getCount() const { return count; }
+
+    /**
+     * @return Cell of landmark k.
+     */
+    std::pair<int, int> getLandmark(int k) const { return landmarks[k]; }
+
+    /**
+     * @return Steps from landmark k to a padded cell, or UNREACHABLE.
+     */
+    uint16_t distance(int k, int paddedCell) const {
+        return distances[static_cast<size_t>(paddedCell) * count + k];
+    }
+
+    /**
+     * @brief Triangle-inequality lower bound on the steps between two cells.
+     *
+     * @param a, b Padded indices (see Map::paddedIndex) of in-bounds cells.
+     * @return     A bound never above the true distance; 0 if no landmark
+     *             reaches both cells.
+     */
+    int lowerBound(int a, int b) const {
+        const uint16_t* da = &distances[static_cast<size_t>(a) * count];
+        const uint16_t* db = &distances[static_cast<size_t>(b) * count];
+        int best = 0;
+        for (int k = 0; k < count; ++k) {
+            if (da[k] != UNREACHABLE && db[k] != UNREACHABLE) {
+                int diff = std::abs(int(da[k]) - int(db[k]));
+                best = diff > best ? diff : best;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @return Bytes used by the distance tables.
+     */
+    size_t memoryBytes() const { return distances.size() * sizeof(uint16_t); }
+
+private:
+    friend class BinaryMap;
+
+    int count = 0;
+    int width = 0, height = 0;
+    uint64_t mapVersion = 0;                     ///< Map::getVersion() at build time
+    std::vector<std::pair<int, int>> landmarks;  ///< Landmark cells
+    std::vector<uint16_t> distances;             ///< [paddedCell * count + k]
+};
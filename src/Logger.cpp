@@ -0,0 +1,189 @@
+/******************************************************************************
+ * File:    Logger.cpp
+ *
+ * Overview:
+ *   Implementation of the Logger class. The asynchronous mode double
+ *   buffers: callers append to a queue under a mutex, and the writer
+ *   thread swaps the whole queue out and prints it without holding the
+ *   lock, so callers only wait for a vector append. Errors and warnings go
+ *   to std::cerr; std::cout is flushed first so both streams stay in order
+ *   when they share a terminal or file.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Logger.h"
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+std::atomic<int> Logger::threshold{static_cast<int>(LogLevel::Debug)};
+
+namespace {
+
+// Writes one message to the stream of its level
+void print(LogLevel level, const std::string& message)
+{
+    if (level <= LogLevel::Warning) {
+        std::cout.flush();
+        std::cerr << message;
+    } else {
+        std::cout << message;
+    }
+}
+
+struct LogState {
+    std::mutex mutex;
+    std::condition_variable wake;     // Messages queued, or stop requested
+    std::condition_variable drained;  // Queue written out
+    std::vector<std::pair<LogLevel, std::string>> queue;
+    bool running = false;             // Messages go to the writer thread
+    bool writing = false;             // Writer holds a swapped-out batch
+    bool stopping = false;
+    std::thread writer;
+    std::mutex outputMutex;           // Keeps synchronous messages whole
+
+    ~LogState() { stop(); }
+
+    void run() {
+        std::vector<std::pair<LogLevel, std::string>> batch;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                break;
+            }
+            batch.swap(queue);
+            writing = true;
+            lock.unlock();
+            for (const auto& entry : batch) {
+                print(entry.first, entry.second);
+            }
+            std::cout.flush();
+            batch.clear();
+            lock.lock();
+            writing = false;
+            drained.notify_all();
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) {
+                return;
+            }
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+
+        // Messages queued after the writer's last batch
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& entry : queue) {
+            print(entry.first, entry.second);
+        }
+        queue.clear();
+        running = false;
+        stopping = false;
+        drained.notify_all();
+    }
+};
+
+LogState& state()
+{
+    static LogState logState;
+    return logState;
+}
+
+} // namespace
+
+/**
+ * @brief Sets the least severe level that is printed.
+ */
+void Logger::setLevel(LogLevel level)
+{
+    threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+/**
+ * @return The least severe level that is printed.
+ */
+LogLevel Logger::getLevel()
+{
+    return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Switches between synchronous writes and the background writer.
+ */
+void Logger::setAsync(bool enabled)
+{
+    LogState& s = state();
+    if (!enabled) {
+        s.stop();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.running) {
+        s.running = true;
+        s.writer = std::thread([&s] { s.run(); });
+    }
+}
+
+/**
+ * @brief Prints a message, or queues it while the writer thread runs.
+ *
+ * Error and Warning messages go to std::cerr, the others to std::cout.
+ */
+void Logger::write(LogLevel level, std::string message)
+{
+    if (!isEnabled(level)) {
+        return;
+    }
+    LogState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.running) {
+            s.queue.emplace_back(level, std::move(message));
+            s.wake.notify_one();
+            return;
+        }
+    }
+    std::lock_guard<std::mutex> lock(s.outputMutex);
+    print(level, message);
+}
+
+/**
+ * @brief Waits until every queued message has been written.
+ */
+void Logger::flush()
+{
+    LogState& s = state();
+    std::unique_lock<std::mutex> lock(s.mutex);
+    s.drained.wait(lock, [&] { return !s.running || (s.queue.empty() && !s.writing); });
+    lock.unlock();
+    std::cout.flush();
+}
+
+/**
+ * @brief Parses a level name.
+ */
+bool Logger::parseLevel(const std::string& name, LogLevel& level)
+{
+    const std::pair<const char*, LogLevel> names[] = {
+        { "error", LogLevel::Error }, { "warning", LogLevel::Warning },
+        { "info", LogLevel::Info },   { "debug", LogLevel::Debug }
+    };
+    for (const auto& entry : names) {
+        if (name == entry.first) {
+            level = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+/******************************************************************************
+ * File:    Logger.h
+ *
+ * Overview:
+ *   This header declares the Logger class, the leveled console log of the
+ *   project, and the RTS_LOG macro that writes to it:
+ *
+ *     RTS_LOG(Info) << "Found " << count << " agent(s)\n";
+ *
+ *   A message is only formatted if its level is enabled, so disabled
+ *   levels cost one comparison. Messages are written exactly as given
+ *   (the caller supplies the newline): errors and warnings to std::cerr,
+ *   info and debug lines to std::cout.
+ *
+ *   By default messages are written synchronously. setAsync(true) hands
+ *   them to a background thread instead, so planning code never waits on
+ *   console I/O; flush() or setAsync(false) waits until everything queued
+ *   has been written. The coordinator logs its errors here too; load and
+ *   file errors are still reported on std::cerr by their callers.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+/**
+ * @enum LogLevel
+ * @brief Message severity; a level enables itself and everything above.
+ */
+enum class LogLevel {
+    Error,    ///< Failures
+    Warning,  ///< Agents left without goal or path
+    Info,     ///< Phase summaries
+    Debug     ///< Per-agent details
+};
+
+/**
+ * @class Logger
+ * @brief Process-wide leveled log to std::cout and std::cerr, optionally
+ *        asynchronous.
+ *
+ * The default level is Debug, which prints every message.
+ */
+class Logger {
+public:
+    /**
+     * @brief Sets the least severe level that is printed.
+     */
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+
+    /**
+     * @return True if messages of the level are printed.
+     */
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) <= threshold.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Switches between synchronous writes and the background writer.
+     *
+     * Switching off flushes the queue and stops the writer thread.
+     */
+    static void setAsync(bool enabled);
+
+    /**
+     * @brief Prints a message (or queues it in asynchronous mode).
+     */
+    static void write(LogLevel level, std::string message);
+
+    /**
+     * @brief Waits until every queued message has been written.
+     */
+    static void flush();
+
+    /**
+     * @brief Parses a level name ("error", "warning", "info" or "debug").
+     *
+     * @return True if the name was recognized.
+     */
+    static bool parseLevel(const std::string& name, LogLevel& level);
+
+private:
+    static std::atomic<int> threshold;
+};
+
+/**
+ * @class LogLine
+ * @brief Collects one message and hands it to the Logger when destroyed.
+ */
+class LogLine {
+public:
+    explicit LogLine(LogLevel level) : level(level) {}
+    ~LogLine() { Logger::write(level, text.str()); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    std::ostringstream& stream() { return text; }
+
+private:
+    LogLevel level;
+    std::ostringstream text;
+};
+
+/// Streams a message at the given level (Error, Warning, Info or Debug);
+/// the operands are not evaluated when the level is disabled
+#define RTS_LOG(level)                                   \
+    if (!Logger::isEnabled(LogLevel::level)) {           \
+    } else                                               \
+        LogLine(LogLevel::level).stream()
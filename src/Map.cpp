@@ -4,8 +4,9 @@
  * Description:
  *   Implementation of the Map class. This class loads a 2D grid from a JSON file
  *   by using a custom JsonParser. It assumes the JSON has a "layers[0].data" array
- *   containing the tile values. The Map stores these values in a flattened
- *   std::vector<int>, providing getters and setters for cell access.
+ *   containing the tile values. The Map stores these values as flattened
+ *   16-bit ids into a tile dictionary, alongside the decoded tile types and
+ *   a passability bitset, providing getters and setters for cell access.
  *
  * Usage:
  *   1) Create a Map object.
@@ -18,66 +19,180 @@
  ******************************************************************************/
 
 #include "Map.h"
+#include "BinaryMap.h"
 #include "JsonParser.h"
+#include "MappedFile.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <stdexcept>
 #include <cmath>
+#include <limits>
+#include <algorithm>
+
+/**
+ * @brief Receives parsed values and interns them straight into a Map's tile ids.
+ *
+ * Tile data has long runs of the same value, so the last lookup is cached.
+ */
+class Map::TileSink : public JsonValueSink {
+public:
+    explicit TileSink(Map& target) : target(target) {}
+
+    void onValue(double value) override
+    {
+        if (target.tileIds.empty() || value != lastValue) {
+            lastValue = value;
+            lastId = target.internTile(value);
+        }
+        target.tileIds.push_back(lastId);
+    }
+
+    void onGridSize(int w, int h) override
+    {
+        width = w;
+        height = h;
+    }
+
+    int width = 0;   ///< Stated grid size; 0 if the file has none
+    int height = 0;
+
+private:
+    Map& target;
+    double lastValue = 0.0;
+    uint16_t lastId = 0;
+};
 
 /**
  * * @brief Loads map data from a JSON file.
  * *
- * This function attempts to open the specified JSON file, parse it using
- * the JsonParser class, and store the resulting grid data in the Map object.
+ * This function memory-maps the specified JSON file, parses it in place using
+ * the JsonParser class, and stores the resulting grid data in the Map object.
  * The JSON file is expected to contain a "layers[0].data" array of integers,
- * which will populate the grid. The function checks if the data size is a
- * perfect square and sets the width and height accordingly.
+ * which will populate the grid. The grid size is taken from the file (see
+ * JsonValueSink::onGridSize) and must match the number of values; files
+ * that do not state it must hold a square grid.
+ *
+ * The new grid is built on the side and moved in on success, so a failed load
+ * leaves the current grid (and the registered observers) untouched.
  * 
  * @param filePath Path to the JSON file.
  * @return True if loading and parsing succeed; false otherwise.
  */
 bool Map::loadFromJson(const std::string& filePath)
 {
-    // Attempt to open the JSON file
-    std::ifstream fin(filePath);
-    if (!fin) {
+    // Attempt to map the JSON file
+    MappedFile file;
+    if (!file.open(filePath)) {
         std::cerr << "Error opening file: " << filePath << std::endl;
         return false;
     }
 
-    // Read the entire file contents into a string
-    std::string jsonContent(
-        (std::istreambuf_iterator<char>(fin)),
-         std::istreambuf_iterator<char>()
-    );
-
-    // Use the custom JsonParser to extract the data array
-    JsonParser parser;
-    if (!parser.parseJson(jsonContent)) {
-        std::cerr << "Error parsing JSON data." << std::endl;
+    // Use the custom JsonParser to decode the data array into a fresh grid.
+    // Every value takes at least two bytes ("3,"), so this bounds the count;
+    // the grid size is only known after the parse, which trims the excess.
+    Map loaded;
+    loaded.terrainCosts = terrainCosts;
+    loaded.tileIds.reserve(file.size() / 2);
+    TileSink sink(loaded);
+    try {
+        if (!JsonParser::parseJson(file.data(), file.size(), sink)) {
+            std::cerr << "Error parsing JSON data." << std::endl;
+            return false;
+        }
+    } catch (const std::length_error& e) {
+        std::cerr << "Invalid grid data: " << e.what() << std::endl;
         return false;
     }
 
-    // Store the parsed data in our vector
-    // Assuming a square map (width == height)
-    auto dataVector = parser.getGridData();
-    int dataCount = static_cast<int>(dataVector.size());
-    int dim = static_cast<int>(std::sqrt(dataCount));
+    int dataCount = static_cast<int>(loaded.tileIds.size());
+    if (sink.width > 0) {
+        // The stated size must account for every value
+        if (static_cast<long long>(sink.width) * sink.height != dataCount) {
+            std::cerr << "Invalid grid data size: " << dataCount << " for "
+                      << sink.width << "x" << sink.height << std::endl;
+            return false;
+        }
+        loaded.width = sink.width;
+        loaded.height = sink.height;
+    } else {
+        // No size given: assume a square map (width == height)
+        int dim = static_cast<int>(std::sqrt(dataCount));
+
+        // If dataCount is not a perfect square, reject the map
+        if (dim * dim != dataCount) {
+            std::cerr << "Invalid grid data size: " << dataCount << std::endl;
+            return false;
+        }
+        loaded.width = dim;
+        loaded.height = dim;
+    }
+    // The reserve above can be several times the cell count for files with
+    // whitespace or multi-digit values; it would otherwise move into *this
+    loaded.tileIds.shrink_to_fit();
+    loaded.decodeTiles();
+    loaded.connectivity.build(loaded);
+    loaded.version = version + 1;
+    loaded.resetRegionVersions();
+
+    // ObserverList ignores assignment, so the observers stay registered
+    *this = std::move(loaded);
+    notifyReloaded();
+    return true;
+}
 
-    // If dataCount is not a perfect square, reject the map
-    if (dim * dim != dataCount) {
-        std::cerr << "Invalid grid data size: " << dataCount << std::endl;
+/**
+ * @brief Replaces the grid with the given row-major values.
+ * 
+ * @param w      Number of columns.
+ * @param h      Number of rows.
+ * @param values w * h tile values.
+ * @return True on success; errors are reported on std::cerr.
+ */
+bool Map::loadFromValues(int w, int h, const std::vector<double>& values)
+{
+    if (w <= 0 || h <= 0 || static_cast<long long>(w) * h != static_cast<long long>(values.size())) {
+        std::cerr << "Invalid grid data size: " << values.size() << " for "
+                  << w << "x" << h << std::endl;
         return false;
     }
 
-    width = dim;
-    height = dim;
-    gridData = dataVector; // Flattened grid
+    Map loaded;
+    loaded.terrainCosts = terrainCosts;
+    loaded.tileIds.reserve(values.size());
+    TileSink sink(loaded);
+    try {
+        for (double value : values) {
+            sink.onValue(value);
+        }
+    } catch (const std::length_error& e) {
+        std::cerr << "Invalid grid data: " << e.what() << std::endl;
+        return false;
+    }
+    loaded.width = w;
+    loaded.height = h;
+    loaded.decodeTiles();
+    loaded.connectivity.build(loaded);
+    loaded.version = version + 1;
+    loaded.resetRegionVersions();
 
+    *this = std::move(loaded);
+    notifyReloaded();
     return true;
 }
 
+/**
+ * @brief Loads a map, choosing the format from the file extension.
+ * 
+ * @param filePath Path to a JSON or ".rtsmap" file.
+ * @return True if loading succeeds; false otherwise.
+ */
+bool Map::loadFromFile(const std::string& filePath)
+{
+    if (BinaryMap::isBinaryMapPath(filePath)) {
+        return BinaryMap::load(*this, filePath);
+    }
+    return loadFromJson(filePath);
+}
+
 /**
  * @brief Retrieves the value at row r, column c.
  * 
@@ -96,7 +211,7 @@ double Map::getCell(int r, int c) const
     if (r < 0 || r >= height || c < 0 || c >= width) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    return gridData[r * width + c];
+    return tileDictionary[tileIds[r * width + c]];
 }
 
 /**
@@ -104,6 +219,8 @@ double Map::getCell(int r, int c) const
  * 
  * This function modifies the value at the specified grid position. It throws
  * an std::out_of_range exception if the coordinates are outside the grid.
+ * The version is bumped if the cell's terrain cost changed, and registered
+ * observers are notified if its passability changed.
  * 
  * @param r Row index (0-based).
  * @param c Column index (0-based).
@@ -117,14 +234,383 @@ void Map::setCell(int r, int c, double value)
     if (r < 0 || r >= height || c < 0 || c >= width) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    gridData[r * width + c] = value;
+    int bit = paddedIndex(r, c);
+    bool wasPassable = passable(bit);
+    float oldCost = cellCosts[bit];
+    assignCell(r * width + c, value);
+    bool passabilityChanged = wasPassable != passable(bit);
+    if (passabilityChanged) {
+        if (wasPassable) {
+            connectivity.onBlocked(*this, bit);
+        } else {
+            connectivity.onOpened(*this, bit);
+        }
+    }
+
+    // Any cost change invalidates derived costs. A value interned here can
+    // only widen the step cost range if the cell's cost changed, too.
+    if (oldCost != cellCosts[bit]) {
+        ++version;
+        regionVersions[regionOf(r, c)] = version;
+    }
+
+    // Let derived structures repair themselves locally
+    if (passabilityChanged) {
+        for (MapObserver* observer : observers.items) {
+            observer->onCellChanged(r, c);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether two cells lie in the same connected passable area.
+ * 
+ * @return False if either cell is out of bounds or blocked.
+ */
+bool Map::areConnected(int r1, int c1, int r2, int c2) const
+{
+    if (r1 < 0 || r1 >= height || c1 < 0 || c1 >= width ||
+        r2 < 0 || r2 >= height || c2 < 0 || c2 >= width) {
+        return false;
+    }
+    uint32_t a = componentOf(paddedIndex(r1, c1));
+    return a != ConnectivityIndex::NONE && a == componentOf(paddedIndex(r2, c2));
+}
+
+/**
+ * @brief Retrieves the connected area of a cell.
+ * 
+ * @param r Row index (0-based).
+ * @param c Column index (0-based).
+ * @return Area id, or -1 if the cell is blocked.
+ * @throws std::out_of_range if (r,c) is outside the grid.
+ */
+int Map::getComponent(int r, int c) const
+{
+    if (r < 0 || r >= height || c < 0 || c >= width) {
+        throw std::out_of_range("Cell coordinates out of range");
+    }
+    uint32_t component = componentOf(paddedIndex(r, c));
+    return component == ConnectivityIndex::NONE ? -1 : static_cast<int>(component);
+}
+
+/**
+ * @brief Retrieves the decoded tile type at row r, column c.
+ * 
+ * @param r Row index (0-based).
+ * @param c Column index (0-based).
+ * @return The TileType of that cell.
+ * @throws std::out_of_range if (r,c) is outside the grid.
+ */
+TileType Map::getTileType(int r, int c) const
+{
+    if (r < 0 || r >= height || c < 0 || c >= width) {
+        throw std::out_of_range("Cell coordinates out of range");
+    }
+    return tileTypes[r * width + c];
+}
+
+/**
+ * @brief Checks whether units can walk on the cell at row r, column c.
+ * 
+ * @param r Row index (0-based).
+ * @param c Column index (0-based).
+ * @return True if the cell is passable.
+ * @throws std::out_of_range if (r,c) is outside the grid.
+ */
+bool Map::isPassable(int r, int c) const
+{
+    if (r < 0 || r >= height || c < 0 || c >= width) {
+        throw std::out_of_range("Cell coordinates out of range");
+    }
+    return passable(paddedIndex(r, c));
+}
+
+/**
+ * @brief Maps a raw tile value to its semantic type.
+ * 
+ * Walls are the value 3; start and goal markers are the special values
+ * used by MultiUnitCoordinator. Every other value is free terrain.
+ * 
+ * @param value Tile value as stored in the JSON data.
+ * @return The TileType for that value.
+ */
+TileType Map::classifyTile(double value)
+{
+    // Tiny epsilon, in case of floating error
+    const double EPS = 1e-6;
+    static const double START_VALUES[] = {0.5, 0.6, 0.9};
+    static const double GOAL_VALUES[]  = {8.1, 8.4, 8.13};
+
+    if (value == 3.0) {
+        return TileType::Wall;
+    }
+    for (double sv : START_VALUES) {
+        if (std::fabs(value - sv) < EPS) {
+            return TileType::Start;
+        }
+    }
+    for (double gv : GOAL_VALUES) {
+        if (std::fabs(value - gv) < EPS) {
+            return TileType::Goal;
+        }
+    }
+    return TileType::Free;
+}
+
+/**
+ * @brief Returns the tile id for a value, adding it to the dictionary if needed.
+ * 
+ * @param value Tile value to look up.
+ * @return The id of that value in tileDictionary.
+ * @throws std::length_error if the dictionary is full.
+ */
+uint16_t Map::internTile(double value)
+{
+    auto it = tileLookup.find(value);
+    if (it != tileLookup.end()) {
+        return it->second;
+    }
+    if (tileDictionary.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::length_error("Too many distinct tile values");
+    }
+    uint16_t id = static_cast<uint16_t>(tileDictionary.size());
+    tileDictionary.push_back(value);
+    tileLookup.emplace(value, id);
+    float cost = static_cast<float>(resolveTerrainCost(value));
+    tileCosts.push_back(cost);
+    // Widen the range (decodeTiles() recomputes it exactly after a load)
+    if (cost != static_cast<float>(IMPASSABLE)) {
+        minStepCost = std::min(minStepCost, double(cost));
+        maxStepCost = std::max(maxStepCost, double(cost));
+        integerCosts = integerCosts && std::floor(cost) == cost;
+    }
+    return id;
+}
+
+/**
+ * @brief Stores a value in the cell at the given flat index.
+ * 
+ * Updates the tile id, the decoded tile type, the terrain cost and the
+ * (padded) passability bit.
+ * 
+ * @param idx   Flat cell index (row * width + col).
+ * @param value The new tile value.
+ */
+void Map::assignCell(int idx, double value)
+{
+    uint16_t id = internTile(value);
+    tileIds[idx] = id;
+    tileTypes[idx] = classifyTile(value);
+
+    // The passability bitset and the costs are stored in the padded layout
+    int bit = paddedIndex(idx / width, idx % width);
+    cellCosts[bit] = tileCosts[id];
+    setPassable(bit, tileCosts[id] != IMPASSABLE);
+}
+
+/**
+ * @brief Sets the passability of a padded cell in both bitsets.
+ */
+void Map::setPassable(int idx, bool open)
+{
+    int column = transposedIndex(paddedRow(idx), paddedCol(idx));
+    uint64_t mask = uint64_t(1) << (idx & 63);
+    uint64_t columnMask = uint64_t(1) << (column & 63);
+    if (open) {
+        passableBits[idx >> 6] |= mask;
+        passableColumnBits[column >> 6] |= columnMask;
+    } else {
+        passableBits[idx >> 6] &= ~mask;
+        passableColumnBits[column >> 6] &= ~columnMask;
+    }
+}
+
+/**
+ * @brief Rebuilds the transposed bitset from the row-major one.
+ */
+void Map::rebuildColumnBits()
+{
+    passableColumnBits.assign(passableBits.size(), 0);
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            if (passable(paddedIndex(r, c))) {
+                int column = transposedIndex(r, c);
+                passableColumnBits[column >> 6] |= uint64_t(1) << (column & 63);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sizes the per-region versions for the current dimensions.
+ * 
+ * Every region starts at the global version, which is larger than any
+ * region version handed out before a reload.
+ */
+void Map::resetRegionVersions()
+{
+    regionsX = (width + REGION_SIZE - 1) / REGION_SIZE;
+    int regionsY = (height + REGION_SIZE - 1) / REGION_SIZE;
+    regionVersions.assign(static_cast<size_t>(regionsX) * regionsY, version);
+}
+
+/**
+ * @brief Tells the observers that a load replaced the grid.
+ */
+void Map::notifyReloaded()
+{
+    for (MapObserver* observer : observers.items) {
+        observer->onMapReloaded();
+    }
+}
+
+/**
+ * @brief Rebuilds the decoded tile types, the costs and the passability bitset.
+ * 
+ * Each dictionary entry is classified and priced once; cells then only map
+ * their id.
+ *
+ * @param rebuildPassability False if passableBits is already valid (e.g. it
+ *                           was loaded from a binary map). Ignored once
+ *                           terrain costs were set, since they may block
+ *                           other values than walls.
+ */
+void Map::decodeTiles(bool rebuildPassability)
+{
+    std::vector<TileType> typeById(tileDictionary.size());
+    tileCosts.resize(tileDictionary.size());
+    for (size_t id = 0; id < tileDictionary.size(); ++id) {
+        typeById[id] = classifyTile(tileDictionary[id]);
+        tileCosts[id] = static_cast<float>(resolveTerrainCost(tileDictionary[id]));
+    }
+    updateStepCostRange();
+    rebuildPassability = rebuildPassability || !terrainCosts.empty();
+
+    int cellCount = width * height;
+    tileTypes.resize(cellCount);
+    cellCosts.assign(getPaddedCellCount(), static_cast<float>(IMPASSABLE)); // Border stays blocked
+    if (rebuildPassability) {
+        passableBits.assign((getPaddedCellCount() + 63) / 64, 0);
+    }
+    for (int r = 0; r < height; ++r) {
+        const uint16_t* ids = &tileIds[r * width];
+        TileType* types = &tileTypes[r * width];
+        int bit = paddedIndex(r, 0);
+        for (int c = 0; c < width; ++c, ++bit) {
+            types[c] = typeById[ids[c]];
+            cellCosts[bit] = tileCosts[ids[c]];
+            if (rebuildPassability && tileCosts[ids[c]] != IMPASSABLE) {
+                passableBits[bit >> 6] |= uint64_t(1) << (bit & 63);
+            }
+        }
+    }
+    rebuildColumnBits();
+}
+
+/**
+ * @brief Sets the cost of entering cells holding a tile value.
+ * 
+ * Cells whose passability flips are reported to the observers; the
+ * connected areas are relabeled once if any did.
+ * 
+ * @param value Tile value as stored in the JSON data.
+ * @param cost  Cost > 0, or IMPASSABLE.
+ * @return False if cost is not positive.
+ */
+bool Map::setTerrainCost(double value, double cost)
+{
+    if (!(cost > 0.0)) {
+        std::cerr << "Invalid terrain cost " << cost << " for tile value " << value << std::endl;
+        return false;
+    }
+    terrainCosts[value] = cost;
+    auto it = tileLookup.find(value);
+    if (it == tileLookup.end()) {
+        return true;  // Applied once the value is first stored
+    }
+
+    uint16_t id = it->second;
+    tileCosts[id] = static_cast<float>(cost);
+    updateStepCostRange();
+    std::vector<std::pair<int,int>> changed;
+    for (int i = 0; i < width * height; ++i) {
+        if (tileIds[i] != id) {
+            continue;
+        }
+        int bit = paddedIndex(i / width, i % width);
+        bool wasPassable = passable(bit);
+        cellCosts[bit] = tileCosts[id];
+        setPassable(bit, cost != IMPASSABLE);
+        if (wasPassable != passable(bit)) {
+            changed.push_back({i / width, i % width});
+        }
+    }
+
+    // Costs affect every cached path, so all regions move to the new version
+    ++version;
+    resetRegionVersions();
+    if (!changed.empty()) {
+        connectivity.build(*this);
+        for (const auto& cell : changed) {
+            for (MapObserver* observer : observers.items) {
+                observer->onCellChanged(cell.first, cell.second);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Retrieves the terrain cost of a tile value.
+ * 
+ * @param value Tile value as stored in the JSON data.
+ * @return Its cost, or IMPASSABLE.
+ */
+double Map::getTerrainCost(double value) const
+{
+    return resolveTerrainCost(value);
+}
+
+/**
+ * @brief Terrain cost of a value: its setTerrainCost() entry, else 1 for
+ *        walkable values and IMPASSABLE for walls.
+ */
+double Map::resolveTerrainCost(double value) const
+{
+    auto it = terrainCosts.find(value);
+    if (it != terrainCosts.end()) {
+        return it->second;
+    }
+    return classifyTile(value) == TileType::Wall ? IMPASSABLE : 1.0;
+}
+
+/**
+ * @brief Recomputes the range of the finite tile costs (1 if there are none)
+ *        and whether they are all whole numbers.
+ */
+void Map::updateStepCostRange()
+{
+    minStepCost = maxStepCost = 1.0;
+    integerCosts = true;
+    bool any = false;
+    for (float cost : tileCosts) {
+        if (cost == static_cast<float>(IMPASSABLE)) {
+            continue;
+        }
+        minStepCost = any ? std::min(minStepCost, double(cost)) : cost;
+        maxStepCost = any ? std::max(maxStepCost, double(cost)) : cost;
+        integerCosts = integerCosts && std::floor(cost) == cost;
+        any = true;
+    }
 }
 
 /**
  * @brief Finds all cells in the grid that match the specified value.
  * 
- * This function iterates through the grid and collects the coordinates of
- * all cells that match the target value. It returns a vector of (row, column)
+ * This function looks the value up in the tile dictionary, then iterates
+ * through the tile ids and collects the coordinates of all cells that match
+ * the target value. It returns a vector of (row, column)
  * pairs where the value matches targetValue.
  * 
  * @param targetValue The value to search for.
@@ -134,14 +620,50 @@ std::vector<std::pair<int,int>> Map::findCellsByValue(double targetValue) const
 {
     // Tiny epsilon, in case of floating error
     const double EPS = 1e-6;
+
+    // Resolve the value against the dictionary once...
+    std::vector<bool> matchingIds(tileDictionary.size(), false);
+    bool anyMatch = false;
+    for (size_t id = 0; id < tileDictionary.size(); ++id) {
+        if (std::fabs(tileDictionary[id] - targetValue) < EPS) {
+            matchingIds[id] = true;
+            anyMatch = true;
+        }
+    }
+
+    // ...then scan the compact tile ids
     std::vector<std::pair<int,int>> positions;
-    for (int r = 0; r < height; ++r) {
-        for (int c = 0; c < width; ++c) {
-            double cellVal = getCell(r, c);
-            if (std::fabs(cellVal - targetValue) < EPS) {
-                positions.push_back({r, c});
-            }
+    if (!anyMatch) {
+        return positions;
+    }
+    for (int i = 0; i < width * height; ++i) {
+        if (matchingIds[tileIds[i]]) {
+            positions.push_back({i / width, i % width});
         }
     }
     return positions;
+}
+
+/**
+ * @brief Registers an observer notified on passability changes and reloads.
+ * 
+ * @param observer Observer to add; ignored if already registered.
+ */
+void Map::addObserver(MapObserver* observer) const
+{
+    auto& items = observers.items;
+    if (std::find(items.begin(), items.end(), observer) == items.end()) {
+        items.push_back(observer);
+    }
+}
+
+/**
+ * @brief Unregisters an observer previously passed to addObserver().
+ * 
+ * @param observer Observer to remove.
+ */
+void Map::removeObserver(MapObserver* observer) const
+{
+    auto& items = observers.items;
+    items.erase(std::remove(items.begin(), items.end(), observer), items.end());
 }
\ No newline at end of file
@@ -6,6 +6,30 @@
  *   from a JSON file (via a custom JsonParser). It provides getters for the
  *   grid dimensions and cell values, as well as a setter to modify cell data.
  *
+ *   Storage:
+ *   - Each distinct tile value is stored once in a tile dictionary; cells
+ *     hold a 16-bit index into it, so the original values are still
+ *     available (e.g. for generateJsonOutput).
+ *   - Tile values are decoded once into a one-byte TileType per cell and a
+ *     passability bitset, which is what the searches read.
+ *   - The passability bitset uses a padded layout with a one-cell blocked
+ *     border, so a searcher stepping to any neighbor of an in-bounds cell
+ *     never needs a bounds check. A transposed copy keeps each column
+ *     contiguous, so line scans can test 64 cells per word both ways.
+ *   - Map files are memory-mapped and parsed in place; values go straight
+ *     into the tile dictionary without an intermediate copy of the grid.
+ *     The same storage can be saved and reloaded as-is in the binary
+ *     format of BinaryMap.
+ *   - Every tile value has a terrain cost (1 by default, IMPASSABLE for
+ *     walls), resolved into a dense per-cell cost array in the padded
+ *     layout, so a search reads the cost of a step with one load.
+ *   - A ConnectivityIndex labels the connected areas of passable cells and
+ *     is kept current by setCell, so unreachable goals are detected in O(1).
+ *
+ *   getCell(...) / setCell(...) are the safe, bounds-checked API. The inline
+ *   accessors in the "Unchecked fast path" section do no validation and are
+ *   meant for search inner loops that have already validated their input.
+ *
  * Usage:
  *   1) Create a Map object.
  *   2) Call loadFromJson(...) with the path to your JSON file.
@@ -18,20 +42,82 @@
 
 #pragma once
 
+#include "ConnectivityIndex.h"
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+/**
+ * @enum TileType
+ * @brief Semantic class of a tile, decoded once from its numeric value.
+ */
+enum class TileType : uint8_t {
+    Free,   ///< Walkable terrain (any value without a special meaning)
+    Wall,   ///< Blocked terrain (value 3)
+    Start,  ///< Agent start marker (0.5, 0.6, 0.9)
+    Goal    ///< Goal marker (8.1, 8.4, 8.13)
+};
+
+/**
+ * @class MapObserver
+ * @brief Receives notifications when a Map cell changes in a way that
+ *        affects searches (currently: passability), and when a load
+ *        replaces the whole grid.
+ *
+ * Derived structures such as the hierarchical abstraction register an
+ * observer so they can rebuild only the affected region.
+ */
+class MapObserver {
+public:
+    virtual ~MapObserver() = default;
+
+    /**
+     * Called by Map::setCell after the passability of (r, c) changed.
+     */
+    virtual void onCellChanged(int r, int c) = 0;
+
+    /**
+     * Called after the whole grid was replaced by a load, possibly with
+     * new dimensions. No onCellChanged() calls are made for a reload.
+     */
+    virtual void onMapReloaded() = 0;
+};
+
 class Map {
 public:
     /**
      * Loads map data from a JSON file. The file is expected to have a
      * "layers[0].data" array of integers, which will populate the grid.
+     * Grids of any width and height load if the file states its size
+     * (see JsonValueSink::onGridSize); otherwise the grid must be square.
      *
      * @param filePath Path to the JSON file.
      * @return True if loading and parsing succeed; false otherwise.
      */
     bool loadFromJson(const std::string& filePath);
 
+    /**
+     * Loads map data from a JSON file or, if the path ends in ".rtsmap",
+     * from the binary format written by BinaryMap::save.
+     *
+     * @param filePath Path to the map file.
+     * @return True if loading succeeds; false otherwise.
+     */
+    bool loadFromFile(const std::string& filePath);
+
+    /**
+     * Replaces the grid with width x height values given in row-major
+     * order, e.g. one chunk of a ChunkedMap or a generated map. Terrain
+     * costs and observers are kept, as with loadFromJson.
+     *
+     * @return False if the sizes do not match or there are too many
+     *         distinct values; the map is then unchanged.
+     */
+    bool loadFromValues(int width, int height, const std::vector<double>& values);
+
     /**
      * @return The width of the grid (number of columns).
      */
@@ -55,6 +141,10 @@ public:
     /**
      * Sets the grid value at (r, c) to the specified integer.
      *
+     * Bumps the version if the cell's terrain cost changes. Observers are
+     * only notified if its passability changes; cost-only changes are
+     * visible through getVersion() and getRegionVersion().
+     *
      * @param r Row index (0-based).
      * @param c Column index (0-based).
      * @param value The new integer value to store.
@@ -62,6 +152,185 @@ public:
      */
     void setCell(int r, int c, double value);
 
+    /**
+     * Retrieves the decoded tile type at row r, column c.
+     *
+     * @param r Row index (0-based).
+     * @param c Column index (0-based).
+     * @return The TileType of that cell.
+     * @throws std::out_of_range if (r,c) is outside the grid.
+     */
+    TileType getTileType(int r, int c) const;
+
+    /**
+     * Checks whether units can walk on the cell at row r, column c.
+     *
+     * @param r Row index (0-based).
+     * @param c Column index (0-based).
+     * @return True if the cell is passable.
+     * @throws std::out_of_range if (r,c) is outside the grid.
+     */
+    bool isPassable(int r, int c) const;
+
+    /**
+     * Checks whether a 4-connected path can exist between two cells.
+     *
+     * @return True if both cells are inside the map, passable and in the
+     *         same connected area. O(1), no search.
+     */
+    bool areConnected(int r1, int c1, int r2, int c2) const;
+
+    /**
+     * Retrieves the connected area of a cell.
+     *
+     * @param r Row index (0-based).
+     * @param c Column index (0-based).
+     * @return Area id (equal ids are mutually reachable), or -1 if the cell
+     *         is blocked. Ids may change whenever passability changes.
+     * @throws std::out_of_range if (r,c) is outside the grid.
+     */
+    int getComponent(int r, int c) const;
+
+    /// Terrain cost of tile values units cannot enter
+    static constexpr double IMPASSABLE = std::numeric_limits<double>::infinity();
+
+    /**
+     * Sets the cost of entering any cell holding the given tile value.
+     *
+     * Tile values cost 1 unless set here; walls (3) are IMPASSABLE. Any
+     * value may be given another finite cost or made impassable, in which
+     * case passability, the connected areas and the observers are updated
+     * as by setCell. The setting survives reloads. Bumps the version.
+     *
+     * @param value Tile value as stored in the JSON data.
+     * @param cost  Cost > 0, or IMPASSABLE.
+     * @return False (with an error message) if cost is not positive.
+     */
+    bool setTerrainCost(double value, double cost);
+
+    /**
+     * @return The terrain cost of a tile value (see setTerrainCost()).
+     */
+    double getTerrainCost(double value) const;
+
+    /**
+     * @return The smallest finite terrain cost of any tile value in the
+     *         map. Distance heuristics scaled by it stay admissible.
+     */
+    double getMinStepCost() const { return minStepCost; }
+
+    /**
+     * @return The largest finite terrain cost of any tile value in the map.
+     */
+    double getMaxStepCost() const { return maxStepCost; }
+
+    /**
+     * @return True if every finite terrain cost in the map is a whole
+     *         number, so path costs are exact integers.
+     */
+    bool hasIntegerCosts() const { return integerCosts; }
+
+    /**
+     * Maps a raw tile value to its semantic type.
+     *
+     * @param value Tile value as stored in the JSON data.
+     * @return The TileType for that value.
+     */
+    static TileType classifyTile(double value);
+
+    // ---------------------------------------------------------------------
+    // Unchecked fast path. None of these validate their arguments.
+    // ---------------------------------------------------------------------
+
+    /**
+     * @return Number of cells per row in the padded layout (width + 2).
+     */
+    int getStride() const { return width + 2; }
+
+    /**
+     * @return Number of cells in the padded layout ((width+2) * (height+2)).
+     */
+    int getPaddedCellCount() const { return (width + 2) * (height + 2); }
+
+    /**
+     * Converts (r, c) to an index in the padded layout. Valid for
+     * -1 <= r <= height and -1 <= c <= width (the border cells).
+     */
+    int paddedIndex(int r, int c) const { return (r + 1) * (width + 2) + (c + 1); }
+
+    /**
+     * @return Row of a padded index (-1 or height for border cells).
+     */
+    int paddedRow(int idx) const { return idx / (width + 2) - 1; }
+
+    /**
+     * @return Column of a padded index (-1 or width for border cells).
+     */
+    int paddedCol(int idx) const { return idx % (width + 2) - 1; }
+
+    /**
+     * Tests one bit of the padded passability bitset. Border cells are
+     * always impassable.
+     *
+     * @param idx Padded index (see paddedIndex()).
+     */
+    bool passable(int idx) const {
+        return (passableBits[idx >> 6] >> (idx & 63)) & 1;
+    }
+
+    /**
+     * @return Passability of the padded cells idx .. idx + 63; bit k is
+     *         cell idx + k. Indices outside the padded layout read as
+     *         blocked, so idx may be negative.
+     */
+    uint64_t passableWindow(int idx) const { return bitWindow(passableBits, idx); }
+
+    /**
+     * Converts (r, c) to an index in the transposed padded layout, which
+     * stores the padded grid column by column. Valid for the same range as
+     * paddedIndex().
+     */
+    int transposedIndex(int r, int c) const { return (c + 1) * (height + 2) + (r + 1); }
+
+    /**
+     * @return passableWindow() of the transposed layout: bit k is the cell
+     *         k rows below transposed index idx, so column scans can test
+     *         64 cells at once as well.
+     */
+    uint64_t passableColumnWindow(int idx) const { return bitWindow(passableColumnBits, idx); }
+
+    /**
+     * @return Cost of entering a padded cell (IMPASSABLE for blocked and
+     *         border cells).
+     */
+    float stepCost(int idx) const { return cellCosts[idx]; }
+
+    /**
+     * @return Connected area of a padded cell, or ConnectivityIndex::NONE
+     *         if it is blocked.
+     */
+    uint32_t componentOf(int idx) const { return connectivity.componentOf(idx); }
+
+    /**
+     * @return Pointer to the first tile id of row r (width entries).
+     */
+    const uint16_t* tileRow(int r) const { return tileIds.data() + r * width; }
+
+    /**
+     * @return Pointer to the first decoded tile type of row r (width entries).
+     */
+    const TileType* typeRow(int r) const { return tileTypes.data() + r * width; }
+
+    /**
+     * @return The tile value stored under a tile id (see tileRow()).
+     */
+    double tileValue(uint16_t id) const { return tileDictionary[id]; }
+
+    /**
+     * @return Number of distinct tile values (valid ids are 0 .. size-1).
+     */
+    int getTileDictionarySize() const { return static_cast<int>(tileDictionary.size()); }
+
     /**
      * Finds all cells in the grid that match the specified value.
      *
@@ -70,8 +339,119 @@ public:
      */
     std::vector<std::pair<int,int>> findCellsByValue(double targetValue) const;
 
+    /**
+     * @return A counter incremented whenever setCell changes the cost (or
+     *         passability) of a cell and whenever terrain costs change.
+     *         Derived data (e.g. flow fields) built at the same version is
+     *         still valid.
+     */
+    uint64_t getVersion() const { return version; }
+
+    /// Side length, in cells, of the square regions that carry their own version
+    static constexpr int REGION_SIZE = 32;
+
+    /**
+     * @return Region id of the cell (r, c); regions are REGION_SIZE squares
+     *         numbered row by row.
+     */
+    int regionOf(int r, int c) const {
+        return (r / REGION_SIZE) * regionsX + (c / REGION_SIZE);
+    }
+
+    /**
+     * @return Number of regions.
+     */
+    int getRegionCount() const { return static_cast<int>(regionVersions.size()); }
+
+    /**
+     * @return Version of one region: the global version at the last
+     *         cost change inside it (or at load time). Data derived
+     *         from a region only is still valid while this is unchanged.
+     */
+    uint64_t getRegionVersion(int region) const { return regionVersions[region]; }
+
+    /**
+     * Registers an observer notified on passability changes and reloads.
+     * Observers stay registered across reloads, are not copied along with
+     * the Map and must unregister before destruction.
+     */
+    void addObserver(MapObserver* observer) const;
+
+    /**
+     * Unregisters an observer previously passed to addObserver().
+     */
+    void removeObserver(MapObserver* observer) const;
+
 private:
+    friend class BinaryMap;
+
+    // Observer list that starts out empty in copies of a Map
+    struct ObserverList {
+        std::vector<MapObserver*> items;
+        ObserverList() = default;
+        ObserverList(const ObserverList&) {}
+        ObserverList& operator=(const ObserverList&) { return *this; }
+    };
+
     int width = 0;               ///< Number of columns
     int height = 0;              ///< Number of rows
-    std::vector<double> gridData;   ///< Flattened grid data (size = width*height)
+    std::vector<double> tileDictionary;   ///< Distinct tile values, indexed by tile id
+    std::unordered_map<double, uint16_t> tileLookup; ///< Tile value -> tile id
+    std::vector<uint16_t> tileIds;        ///< Flattened tile ids (size = width*height)
+    std::vector<TileType> tileTypes;      ///< Flattened decoded tile types
+    std::vector<uint64_t> passableBits;   ///< One bit per padded cell, set if passable
+    std::vector<uint64_t> passableColumnBits; ///< passableBits in the transposed layout
+    std::unordered_map<double, double> terrainCosts; ///< Costs set via setTerrainCost()
+    std::vector<float> tileCosts;         ///< Terrain cost per tile id
+    std::vector<float> cellCosts;         ///< Terrain cost per padded cell
+    double minStepCost = 1.0;             ///< Smallest finite entry of tileCosts
+    double maxStepCost = 1.0;             ///< Largest finite entry of tileCosts
+    bool integerCosts = true;             ///< All finite entries of tileCosts are whole
+    mutable ObserverList observers;       ///< Notified on passability changes
+    uint64_t version = 0;                 ///< Bumped on every cost change
+    int regionsX = 0;                     ///< Regions per row
+    std::vector<uint64_t> regionVersions; ///< Per-region version (see getRegionVersion())
+    ConnectivityIndex connectivity;       ///< Connected areas of the passable cells
+
+    // Terrain cost of a value: its setTerrainCost() entry or the default
+    double resolveTerrainCost(double value) const;
+
+    // Recomputes minStepCost, maxStepCost and integerCosts from tileCosts
+    void updateStepCostRange();
+
+    // Returns the tile id for a value, adding it to the dictionary if needed
+    uint16_t internTile(double value);
+
+    // Stores a value in the cell at the given flat index and updates the decoded data
+    void assignCell(int idx, double value);
+
+    // Sets the passability of a padded cell in both bitsets
+    void setPassable(int idx, bool open);
+
+    // Rebuilds passableColumnBits from passableBits
+    void rebuildColumnBits();
+
+    // 64 bits of a bitset starting at bit idx; bits outside it read as 0
+    static uint64_t bitWindow(const std::vector<uint64_t>& bits, int idx) {
+        int word = idx >= 0 ? idx / 64 : -((63 - idx) / 64);
+        int shift = idx - word * 64;
+        auto at = [&](int w) {
+            return w >= 0 && w < static_cast<int>(bits.size()) ? bits[w] : uint64_t(0);
+        };
+        uint64_t low = at(word) >> shift;
+        return shift == 0 ? low : low | (at(word + 1) << (64 - shift));
+    }
+
+    // Sizes regionVersions for the current dimensions, all at the global version
+    void resetRegionVersions();
+
+    // Tells the observers that a load replaced the grid
+    void notifyReloaded();
+
+    // Rebuilds tileTypes, the costs (and optionally passableBits) from tileIds
+    // and the dictionary; passableBits is always rebuilt if costs were set
+    void decodeTiles(bool rebuildPassability = true);
+
+    // Interns parsed values straight into tileIds (defined in Map.cpp)
+    class TileSink;
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * File:    MapConvert.cpp
+ *
+ * Overview:
+ *   Command-line converter between the JSON map format and the binary
+ *   ".rtsmap" format of BinaryMap, and from either to the chunked
+ *   ".rtsworld" format of ChunkedMap. The direction follows the file
+ *   extensions:
+ *
+ *     map-convert input.json output.rtsmap [--lz4] [--landmarks K]
+ *     map-convert input.rtsmap output.json [--integer-tiles]
+ *     map-convert input.json output.rtsworld [--chunk-size N]
+ *
+ *   --landmarks precomputes K ALT landmark tables (see LandmarkTable) and
+ *   stores them in the binary file. --chunk-size sets the side length of
+ *   the chunks of a world (default 64).
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "Map.h"
+#include "BinaryMap.h"
+#include "ChunkedMap.h"
+#include "JsonWriter.h"
+#include "LandmarkTable.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: map-convert <input.json|input.rtsmap> "
+                  << "<output.rtsmap|output.json|output.rtsworld> [--lz4] [--landmarks K] "
+                  << "[--integer-tiles] [--chunk-size N]\n";
+        return 1;
+    }
+
+    std::string inputFile  = argv[1];
+    std::string outputFile = argv[2];
+    bool compress = false;
+    int landmarkCount = 0;
+    TileNumberFormat format = TileNumberFormat::Fixed;
+    int chunkSize = ChunkedMap::DEFAULT_CHUNK_SIZE;
+    for (int i = 3; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--lz4") {
+            compress = true;
+        } else if (flag == "--landmarks" && i + 1 < argc) {
+            landmarkCount = std::atoi(argv[++i]);
+            if (landmarkCount < 1 || landmarkCount > LandmarkTable::MAX_LANDMARK_COUNT) {
+                std::cerr << "Landmark count must be between 1 and "
+                          << LandmarkTable::MAX_LANDMARK_COUNT << "\n";
+                return 1;
+            }
+        } else if (flag == "--integer-tiles") {
+            format = TileNumberFormat::Integral;
+        } else if (flag == "--chunk-size" && i + 1 < argc) {
+            chunkSize = std::atoi(argv[++i]);
+            if (chunkSize < 4) {
+                std::cerr << "Chunk size must be at least 4\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << flag << "\n";
+            return 1;
+        }
+    }
+
+    Map map;
+    if (!map.loadFromFile(inputFile)) {
+        std::cerr << "Failed to load map from file.\n";
+        return 1;
+    }
+
+    if (ChunkedMap::isChunkedMapPath(outputFile)) {
+        if (!ChunkedMap::write(map, outputFile, chunkSize)) {
+            return 1;
+        }
+        ChunkedMap world;
+        if (!world.open(outputFile)) {
+            return 1;
+        }
+        std::cout << "Wrote " << world.getChunkCount() << " chunk(s) of " << chunkSize << "x"
+                  << chunkSize << ", " << world.getAbstractNodeCount() << " entrance node(s)\n";
+    } else if (BinaryMap::isBinaryMapPath(outputFile)) {
+        LandmarkTable landmarks;
+        if (landmarkCount > 0) {
+            landmarks.build(map, landmarkCount);
+            std::cout << "Built " << landmarks.getCount() << " landmark table(s), "
+                      << landmarks.memoryBytes() / 1024 << " KiB\n";
+        }
+        if (!BinaryMap::save(map, outputFile, compress,
+                             landmarks.getCount() > 0 ? &landmarks : nullptr)) {
+            return 1;
+        }
+    } else {
+        if (!writeMapJson(map, outputFile, format)) {
+            return 1;
+        }
+    }
+
+    std::cout << "Converted " << inputFile << " (" << map.getWidth() << "x"
+              << map.getHeight() << ") to " << outputFile << "\n";
+    return 0;
+}
@@ -0,0 +1,329 @@
+/******************************************************************************
+ * File:    MapGenerator.cpp
+ *
+ * Overview:
+ *   Implementation of the MapGenerator class: synthetic map layouts and
+ *   scenario files.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "MapGenerator.h"
+#include "Map.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const double FREE = 0.0;
+const double WALL = 3.0;
+
+// Rooms layout: rooms of ROOM_SIZE cells every ROOM_PITCH cells
+const int ROOM_SIZE = 16;
+const int ROOM_PITCH = 20;
+
+// Draws per query before generateScenario() gives up on a sparse map
+const int MAX_QUERY_ATTEMPTS = 1000;
+
+// Goals tried for one start before another start is drawn
+const int GOAL_ATTEMPTS = 64;
+
+/**
+ * SplitMix64: tiny, fast and fully specified, so sequences are the same
+ * with every compiler and standard library.
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform integer in [0, bound)
+    int below(int bound) { return static_cast<int>(next() % static_cast<uint64_t>(bound)); }
+
+    // Uniform double in [0, 1)
+    double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    uint64_t state;
+};
+
+void generateRandom(std::vector<double>& values, Random& random, double density)
+{
+    for (double& value : values) {
+        value = random.unit() < density ? WALL : FREE;
+    }
+}
+
+/**
+ * Recursive backtracker on the cells with even coordinates; the odd cells
+ * between them are walls unless the walk carved through.
+ */
+void generateMaze(std::vector<double>& values, int width, int height, Random& random)
+{
+    std::fill(values.begin(), values.end(), WALL);
+    const int cellCols = (width + 1) / 2;
+    const int cellRows = (height + 1) / 2;
+    std::vector<char> visited(static_cast<size_t>(cellRows) * cellCols, 0);
+    std::vector<int> stack{0};
+    visited[0] = 1;
+    values[0] = FREE;
+
+    const int dr[4] = { -1, 1, 0, 0 };
+    const int dc[4] = { 0, 0, -1, 1 };
+    while (!stack.empty()) {
+        const int cell = stack.back();
+        const int r = cell / cellCols;
+        const int c = cell % cellCols;
+        int options[4];
+        int optionCount = 0;
+        for (int d = 0; d < 4; ++d) {
+            int nr = r + dr[d];
+            int nc = c + dc[d];
+            if (nr >= 0 && nr < cellRows && nc >= 0 && nc < cellCols &&
+                !visited[static_cast<size_t>(nr) * cellCols + nc]) {
+                options[optionCount++] = d;
+            }
+        }
+        if (optionCount == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const int d = options[random.below(optionCount)];
+        const int nr = r + dr[d];
+        const int nc = c + dc[d];
+        visited[static_cast<size_t>(nr) * cellCols + nc] = 1;
+        values[static_cast<size_t>(2 * r + dr[d]) * width + (2 * c + dc[d])] = FREE;
+        values[static_cast<size_t>(2 * nr) * width + 2 * nc] = FREE;
+        stack.push_back(nr * cellCols + nc);
+    }
+}
+
+void generateRooms(std::vector<double>& values, int width, int height, Random& random)
+{
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            bool wall = r % ROOM_PITCH >= ROOM_SIZE || c % ROOM_PITCH >= ROOM_SIZE;
+            values[static_cast<size_t>(r) * width + c] = wall ? WALL : FREE;
+        }
+    }
+    auto carve = [&](int r, int c) {
+        if (r < height && c < width) {
+            values[static_cast<size_t>(r) * width + c] = FREE;
+        }
+    };
+
+    for (int top = 0; top < height; top += ROOM_PITCH) {
+        for (int left = 0; left < width; left += ROOM_PITCH) {
+            const int roomRows = std::min(ROOM_SIZE, height - top);
+            const int roomCols = std::min(ROOM_SIZE, width - left);
+            // Corridor to the right neighbor, 2 cells wide where the room allows
+            if (left + ROOM_PITCH < width) {
+                int r = top + random.below(std::max(1, roomRows - 1));
+                for (int c = left + ROOM_SIZE; c < left + ROOM_PITCH; ++c) {
+                    carve(r, c);
+                    if (r + 1 < top + roomRows) {
+                        carve(r + 1, c);
+                    }
+                }
+            }
+            // Corridor to the lower neighbor
+            if (top + ROOM_PITCH < height) {
+                int c = left + random.below(std::max(1, roomCols - 1));
+                for (int r = top + ROOM_SIZE; r < top + ROOM_PITCH; ++r) {
+                    carve(r, c);
+                    if (c + 1 < left + roomCols) {
+                        carve(r, c + 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Generates a map of free tiles (0) and walls (3).
+ */
+bool MapGenerator::generate(Map& map, Layout layout, int width, int height,
+                            uint64_t seed, double density)
+{
+    if (width < 1 || height < 1) {
+        std::cerr << "Invalid map size: " << width << "x" << height << "\n";
+        return false;
+    }
+    if (layout == Layout::Random && !(density >= 0.0 && density < 1.0)) {
+        std::cerr << "Obstacle density must be in [0, 1): " << density << "\n";
+        return false;
+    }
+
+    Random random(seed);
+    std::vector<double> values(static_cast<size_t>(width) * height, FREE);
+    switch (layout) {
+    case Layout::Open:
+        break;
+    case Layout::Random:
+        generateRandom(values, random, density);
+        break;
+    case Layout::Maze:
+        generateMaze(values, width, height, random);
+        break;
+    case Layout::Rooms:
+        generateRooms(values, width, height, random);
+        break;
+    }
+    return map.loadFromValues(width, height, values);
+}
+
+/**
+ * @brief Draws start/goal queries between mutually reachable cells.
+ *
+ * Rejection sampling: starts are redrawn until passable, goals until they
+ * share the start's connected area. A start whose area is too small to hit
+ * within GOAL_ATTEMPTS draws is replaced.
+ */
+std::vector<MapGenerator::Query> MapGenerator::generateScenario(const Map& map, size_t count,
+                                                                uint64_t seed)
+{
+    std::vector<Query> queries;
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+    const int cells = width * height;
+    bool anyPassable = false;
+    for (int idx = 0; idx < cells && !anyPassable; ++idx) {
+        anyPassable = map.isPassable(idx / width, idx % width);
+    }
+    if (!anyPassable) {
+        std::cerr << "Map has no passable cell for a scenario\n";
+        return queries;
+    }
+
+    Random random(seed);
+    queries.reserve(count);
+    while (queries.size() < count) {
+        bool found = false;
+        for (int attempt = 0; attempt < MAX_QUERY_ATTEMPTS && !found; ++attempt) {
+            int start = random.below(cells);
+            int sr = start / width;
+            int sc = start % width;
+            if (!map.isPassable(sr, sc)) {
+                continue;
+            }
+            for (int g = 0; g < GOAL_ATTEMPTS; ++g) {
+                int goal = random.below(cells);
+                int gr = goal / width;
+                int gc = goal % width;
+                if (goal != start && map.areConnected(sr, sc, gr, gc)) {
+                    queries.push_back(Query{ sr, sc, gr, gc });
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found) {
+            std::cerr << "Stopped after " << queries.size()
+                      << " queries: too few mutually reachable cells\n";
+            break;
+        }
+    }
+    return queries;
+}
+
+/**
+ * @brief Writes a scenario file for a map of the given size.
+ */
+bool MapGenerator::writeScenario(const std::string& filePath, int width, int height,
+                                 const std::vector<Query>& queries)
+{
+    std::ofstream out(filePath);
+    if (!out) {
+        std::cerr << "Could not open file for writing: " << filePath << "\n";
+        return false;
+    }
+    out << "rts-scenario 1\n" << width << " " << height << " " << queries.size() << "\n";
+    for (const Query& q : queries) {
+        out << q.startRow << " " << q.startCol << " " << q.goalRow << " " << q.goalCol << "\n";
+    }
+    if (!out) {
+        std::cerr << "Failed to write scenario: " << filePath << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a scenario file and checks it against a map.
+ */
+bool MapGenerator::readScenario(const std::string& filePath, const Map& map,
+                                std::vector<Query>& queries)
+{
+    std::ifstream in(filePath);
+    if (!in) {
+        std::cerr << "Could not open file: " << filePath << "\n";
+        return false;
+    }
+    std::string magic;
+    int version = 0, width = 0, height = 0;
+    size_t count = 0;
+    if (!(in >> magic >> version >> width >> height >> count) ||
+        magic != "rts-scenario" || version != 1) {
+        std::cerr << "Not a scenario file: " << filePath << "\n";
+        return false;
+    }
+    if (width != map.getWidth() || height != map.getHeight()) {
+        std::cerr << "Scenario is for a " << width << "x" << height << " map, not "
+                  << map.getWidth() << "x" << map.getHeight() << "\n";
+        return false;
+    }
+
+    std::vector<Query> loaded;
+    loaded.reserve(count);
+    auto inside = [&](int r, int c) { return r >= 0 && r < height && c >= 0 && c < width; };
+    for (size_t i = 0; i < count; ++i) {
+        Query q;
+        if (!(in >> q.startRow >> q.startCol >> q.goalRow >> q.goalCol) ||
+            !inside(q.startRow, q.startCol) || !inside(q.goalRow, q.goalCol)) {
+            std::cerr << "Invalid query " << i << " in " << filePath << "\n";
+            return false;
+        }
+        loaded.push_back(q);
+    }
+    queries.swap(loaded);
+    return true;
+}
+
+/**
+ * @brief Parses a layout name.
+ */
+bool MapGenerator::parseLayout(const std::string& name, Layout& layout)
+{
+    for (Layout candidate : { Layout::Open, Layout::Random, Layout::Maze, Layout::Rooms }) {
+        if (name == layoutName(candidate)) {
+            layout = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @return The name of a layout.
+ */
+const char* MapGenerator::layoutName(Layout layout)
+{
+    switch (layout) {
+    case Layout::Open:   return "open";
+    case Layout::Random: return "random";
+    case Layout::Maze:   return "maze";
+    case Layout::Rooms:  return "rooms";
+    }
+    return "unknown";
+}
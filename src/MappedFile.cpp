@@ -0,0 +1,123 @@
+/******************************************************************************
+ * File:    MappedFile.cpp
+ *
+ * Overview:
+ *   Implementation of the MappedFile class, with a POSIX and a Windows
+ *   mapping path and a plain read() fallback shared by both.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "MappedFile.h"
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Releases the mapping.
+ */
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+/**
+ * @brief Opens and maps a file, releasing any previous mapping.
+ *
+ * Empty files and files that cannot be mapped are read into an owned buffer.
+ *
+ * @param filePath Path to the file.
+ * @return True on success; on failure the view is empty.
+ */
+bool MappedFile::open(const std::string& filePath)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (ptr) {
+                fileHandle = file;
+                mappingHandle = mapping;
+                view = static_cast<const char*>(ptr);
+                length = static_cast<size_t>(fileSize.QuadPart);
+                mapped = true;
+                return true;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* ptr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED) {
+            // The parser walks the file front to back
+            madvise(ptr, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            ::close(fd);
+            view = static_cast<const char*>(ptr);
+            length = static_cast<size_t>(info.st_size);
+            mapped = true;
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    // Fallback: read the file into an owned buffer
+    std::ifstream fin(filePath, std::ios::binary);
+    if (!fin) {
+        return false;
+    }
+    fallback.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    view = fallback.data();
+    length = fallback.size();
+    return true;
+}
+
+/**
+ * @brief Releases the mapping (or the fallback buffer).
+ */
+void MappedFile::close()
+{
+    if (mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(view);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<char*>(view), length);
+#endif
+    }
+    fallback.clear();
+    fallback.shrink_to_fit();
+    view = nullptr;
+    length = 0;
+    mapped = false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+/******************************************************************************
+ * File:    MappedFile.h
+ *
+ * Overview:
+ *   This header declares the MappedFile class, a read-only view of a whole
+ *   file. The file is memory-mapped (mmap on POSIX, MapViewOfFile on
+ *   Windows), so loaders can parse it in place without first copying it
+ *   into a std::string. If mapping is not possible, the file is read into
+ *   an owned buffer instead and the view behaves the same.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ *
+ * @brief Read-only, whole-file view. The bytes are NOT null-terminated.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Opens and maps a file, releasing any previous mapping.
+     *
+     * @param filePath Path to the file.
+     * @return True on success; on failure the view is empty.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Releases the mapping.
+     */
+    void close();
+
+    /**
+     * @return Pointer to the first byte of the file (may be null if empty).
+     */
+    const char* data() const { return view; }
+
+    /**
+     * @return Size of the file in bytes.
+     */
+    size_t size() const { return length; }
+
+private:
+    const char* view = nullptr;   ///< Start of the mapped (or buffered) bytes
+    size_t length = 0;            ///< Number of bytes in the view
+    bool mapped = false;          ///< True if view must be unmapped
+    std::vector<char> fallback;   ///< Owned copy when mapping is unavailable
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
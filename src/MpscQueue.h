@@ -0,0 +1,108 @@
+#pragma once
+
+/******************************************************************************
+ * File:    MpscQueue.h
+ *
+ * Overview:
+ *   This header defines MpscQueue, an unbounded multi-producer,
+ *   single-consumer FIFO after Dmitry Vyukov's intrusive MPSC queue.
+ *
+ *   push() is one atomic exchange plus one store and never waits for
+ *   other threads, so producers (game threads submitting path requests)
+ *   cannot block each other or the consumer. pop() must only ever run on
+ *   one thread at a time; callers that share the consumer role among
+ *   several threads serialize it themselves (see PathService).
+ *
+ *   A producer that was preempted between its two steps briefly hides the
+ *   entries pushed after it; pop() then reports the queue as empty and a
+ *   later call picks them up.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <atomic>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ *
+ * @brief Lock-free multi-producer, single-consumer queue.
+ *
+ * @tparam T Default-constructible, movable value type.
+ */
+template <class T>
+class MpscQueue {
+public:
+    MpscQueue() : head(&stub), tail(&stub) {}
+
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) {
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Appends a value. Safe to call from any number of threads.
+     */
+    void push(T value) {
+        link(new Node(std::move(value)));
+    }
+
+    /**
+     * @brief Removes the oldest value. Consumer thread only.
+     *
+     * @return False if the queue is empty (or its next entry is still
+     *         being linked by a producer).
+     */
+    bool pop(T& value) {
+        Node* first = tail;
+        Node* next = first->next.load(std::memory_order_acquire);
+        if (first == &stub) {
+            if (next == nullptr) {
+                return false;
+            }
+            tail = next;
+            first = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next == nullptr) {
+            if (first != head.load(std::memory_order_acquire)) {
+                return false;  // A producer is between its two steps
+            }
+            // first is the last entry: park the stub behind it to unlink it
+            link(&stub);
+            next = first->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return false;
+            }
+        }
+        tail = next;
+        value = std::move(first->value);
+        delete first;
+        return true;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    // Appends a node: swing the head, then link the old head to it
+    void link(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    Node stub;                 ///< Placeholder that keeps the list non-empty
+    std::atomic<Node*> head;   ///< Newest node; producers swing it
+    Node* tail;                ///< Oldest node; touched by the consumer only
+};
@@ -7,15 +7,23 @@
  *   - Assigns each agent to the nearest goal.
  *   - Uses A* to plan paths.
  *   - Steps agents 1 cell at a time, avoiding collisions.
+ *   - Optionally repairs paths with D* Lite when the map changes.
+ *   - Serves queued path requests in tick() with time-sliced searches.
  *
  * Author: Tarun Trilokesh
  * Date:   2025-06-04
  ******************************************************************************/
 
 #include "MultiUnitCoordinator.h"
+#include "GoalAssignment.h"
+#include "CooperativeAStar.h"
+#include "Logger.h"
+#include <chrono>
 #include <limits>
-#include <iostream>
 #include <cmath>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
 
 /******************************************************************************
  * @brief Constructor for MultiUnitCoordinator.
@@ -26,10 +34,187 @@
  * @param mapRef Reference to the Map object that this coordinator will manage.
  */
 MultiUnitCoordinator::MultiUnitCoordinator(Map& mapRef)
-    : map(mapRef)
+    : map(mapRef),
+      pathfinder(createPathfinder(PathfinderType::AStar, mapRef)),
+      workerCount(ThreadPool::defaultThreadCount())
 {
 }
 
+/*******************************************************************************
+ * @brief Stops observing the map.
+ */
+MultiUnitCoordinator::~MultiUnitCoordinator()
+{
+    map.removeObserver(this);
+}
+
+/*******************************************************************************
+ * @brief Enables or disables incremental replanning in step().
+ * 
+ * @param enabled True to observe the map and repair broken paths.
+ */
+void MultiUnitCoordinator::setIncrementalReplanning(bool enabled)
+{
+    incrementalReplanning = enabled;
+    changedCells.clear();
+    replanners.clear();
+    if (enabled) {
+        map.addObserver(this);
+    } else {
+        map.removeObserver(this);
+    }
+}
+
+/*******************************************************************************
+ * @brief Records a passability change for the next step().
+ * 
+ * Existing replanners queue the affected vertices right away, while the map
+ * reflects the change; the actual repair waits until a path needs it.
+ * 
+ * @param r Row of the changed cell.
+ * @param c Column of the changed cell.
+ */
+void MultiUnitCoordinator::onCellChanged(int r, int c)
+{
+    changedCells.push_back({r, c});
+    for (DStarLite& planner : replanners) {
+        if (planner.isInitialized()) {
+            planner.notifyCellChanged(r, c);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Drops the repair state built for the previous grid.
+ * 
+ * The replanners and the recorded changes may refer to cells the new grid
+ * no longer has. Agents keep their positions and paths; after loading a
+ * different map, findStartsAndGoals() and planPaths() start over.
+ */
+void MultiUnitCoordinator::onMapReloaded()
+{
+    changedCells.clear();
+    replanners.clear();
+}
+
+/*******************************************************************************
+ * @brief Repairs the paths that cross a cell changed since the last step.
+ * 
+ * Only agents still travelling whose remaining path contains a changed cell
+ * are replanned. The first repair of an agent plans from scratch; later
+ * ones reuse the agent's D* Lite state and touch only the affected part.
+ */
+void MultiUnitCoordinator::repairPaths()
+{
+    if (replanners.size() != agents.size()) {
+        replanners.assign(agents.size(), DStarLite());
+    }
+
+    std::vector<uint8_t> changed(static_cast<size_t>(map.getWidth()) * map.getHeight(), 0);
+    for (const auto& cell : changedCells) {
+        changed[cell.first * map.getWidth() + cell.second] = 1;
+    }
+    changedCells.clear();
+
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.isTravelling(i)) {
+            continue;
+        }
+        bool crosses = false;
+        for (const auto& cell : agents.remainingPath(i)) {
+            if (changed[cell.first * map.getWidth() + cell.second] != 0) {
+                crosses = true;
+                break;
+            }
+        }
+        if (!crosses) {
+            continue;
+        }
+
+        DStarLite& planner = replanners[i];
+        if (!planner.isInitialized() ||
+            planner.getGoalRow() != agents.goalRow(i) || planner.getGoalCol() != agents.goalCol(i)) {
+            planner.initialize(map, agents.row(i), agents.col(i),
+                               agents.goalRow(i), agents.goalCol(i));
+        } else {
+            planner.updateStart(agents.row(i), agents.col(i));
+            planner.replan();
+        }
+
+        storePath(i, planner.extractPath());
+        if (!agents.hasPath(i)) {
+            RTS_LOG(Warning) << "Agent " << i << " => Path blocked, no repair found.\n";
+        } else {
+            RTS_LOG(Debug) << "Agent " << i
+                           << " repaired path length: " << agents.pathCellCount(i) << "\n";
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Selects the search engine used by planPaths().
+ * 
+ * @param type Engine to use for subsequent planning (A* by default).
+ */
+void MultiUnitCoordinator::setPathfinder(PathfinderType type)
+{
+    pathfinderType = type;
+    if (type == PathfinderType::AStar && landmarks) {
+        SearchOptions options;
+        options.landmarks = landmarks;
+        pathfinder = std::make_unique<AStarPathfinder>(options);
+    } else {
+        pathfinder = createPathfinder(type, map);
+    }
+    pathCache = nullptr;
+    if (pathCacheCapacity > 0) {
+        auto cache = std::make_unique<PathCache>(std::move(pathfinder), map, pathCacheCapacity);
+        pathCache = cache.get();
+        pathfinder = std::move(cache);
+    }
+}
+
+/*******************************************************************************
+ * @brief Sets the ALT landmark tables used by the A* engine.
+ * 
+ * The engine is recreated, so a path cache in front of it starts empty.
+ * 
+ * @param table Tables for this map, or nullptr to search without them.
+ */
+void MultiUnitCoordinator::setLandmarks(const LandmarkTable* table)
+{
+    landmarks = table;
+    setPathfinder(pathfinderType);
+}
+
+/*******************************************************************************
+ * @brief Enables (capacity > 0) or disables the path cache.
+ * 
+ * The current engine is recreated behind the cache, so earlier entries are
+ * dropped.
+ * 
+ * @param capacity Maximum number of cached paths; 0 disables caching.
+ */
+void MultiUnitCoordinator::setPathCache(size_t capacity)
+{
+    pathCacheCapacity = capacity;
+    setPathfinder(pathfinderType);
+}
+
+/*******************************************************************************
+ * @brief Sets the number of threads used by planPaths().
+ * 
+ * @param count Worker count; 0 selects the hardware concurrency and 1 plans
+ *              on the calling thread.
+ */
+void MultiUnitCoordinator::setWorkerCount(unsigned count)
+{
+    workerCount = count == 0 ? ThreadPool::defaultThreadCount() : count;
+    if (pool && pool->size() != workerCount) {
+        pool.reset();
+    }
+}
+
 /******************************************************************************
  * @brief Finds all agent start positions and goal positions in the map.
  * 
@@ -47,21 +232,13 @@ void MultiUnitCoordinator::findStartsAndGoals()
     // Potential goal values
     static const double GOAL_VALUES[]  = {8.1, 8.4, 8.13};
 
-    int agentIdCount = 0;
+    agents.reset(map.getWidth());
 
-    // Gather all agent starts
+    // Gather all agent starts; ids follow detection order
     for (double sv : START_VALUES) {
         auto positions = map.findCellsByValue(sv);
         for (auto &pos : positions) {
-            Agent ag;
-            ag.id = agentIdCount++;
-            ag.startVal = sv;     // store the start tile value
-            ag.row = pos.first;
-            ag.col = pos.second;
-            ag.goalRow = -1;
-            ag.goalCol = -1;
-            ag.pathIndex = 0;
-            agents.push_back(ag);
+            agents.add(sv, pos.first, pos.second);  // No goal yet
         }
     }
 
@@ -73,16 +250,28 @@ void MultiUnitCoordinator::findStartsAndGoals()
         }
     }
 
-    std::cout << "Found " << agents.size() << " agent(s) and "
-              << goalCells.size() << " goal(s).\n";
+    rebuildOccupancy();
+
+    RTS_LOG(Info) << "Found " << agents.size() << " agent(s) and "
+                  << goalCells.size() << " goal(s).\n";
 }
 
 /*******************************************************************************
- * @brief Assigns each agent the nearest goal.
+ * @brief Assigns goals to agents.
+ * 
+ * With equal agent and goal counts, every agent gets a distinct goal. Up to
+ * GoalAssignment::HUNGARIAN_LIMIT agents, the assignment minimizes the total
+ * distance exactly, which avoids the crossing paths an index-order pairing
+ * produces. Larger groups use a greedy nearest-free-goal pass: over a
+ * spatial index of the goals for Manhattan distances, over every pair for
+ * flow-field or search distances.
+ *
+ * Otherwise each agent is assigned its nearest goal, and the same goal can
+ * be assigned to multiple agents.
  * 
- * This function iterates through the list of agents and assigns each one
- * the nearest goal based on Manhattan distance. The same goal can be assigned
- * to multiple agents.
+ * Distances are Manhattan unless setAssignmentCost() selected flow-field
+ * or search distances. Either way, goals outside an agent's connected area are never
+ * assigned to it; the component labels of the map make that check O(1).
  * 
  * @note If no goals are available, the agent's goalRow and goalCol are set to -1.
  *       This indicates that the agent has no assigned goal.
@@ -90,89 +279,662 @@ void MultiUnitCoordinator::findStartsAndGoals()
 void MultiUnitCoordinator::assignGoals()
 {
     if (agents.empty() || goalCells.empty()) {
-        std::cout << "No agents or no goals to assign.\n";
+        RTS_LOG(Warning) << "No agents or no goals to assign.\n";
         return;
     }
 
-    // If the number of agents == number of goals, assign 1:1 in order
-    if (agents.size() == goalCells.size()) {
-        std::cout << "Assigning distinct goals because agent count = goal count.\n";
-        size_t n = agents.size();
-        // For each agent i, assign goal i
-        for (size_t i = 0; i < n; ++i) {
-            auto &agent = agents[i];
-            auto &gcell = goalCells[i];
-            agent.goalRow = gcell.first;
-            agent.goalCol = gcell.second;
-            std::cout << "Agent " << agent.id
-                      << " assigned goal (" << agent.goalRow
-                      << "," << agent.goalCol << ")\n";
+    if (assignmentCost == AssignmentCost::FlowFieldDistance) {
+        refreshFlowFields(goalCells);
+    }
+
+    std::vector<std::pair<int,int>> positions;
+    positions.reserve(agents.size());
+    for (size_t i = 0; i < agents.size(); ++i) {
+        positions.push_back(agents.position(i));
+    }
+
+    const int agentCount = static_cast<int>(agents.size());
+    const int goalCount  = static_cast<int>(goalCells.size());
+    std::vector<int> choice;
+
+    // Search distances come as one batched matrix, the others pair by pair
+    std::vector<double> distances;
+    auto pairCost = [&](int i, int g) {
+        if (assignmentCost != AssignmentCost::SearchDistance) {
+            return assignmentDistance(i, goalCells[g]);
+        }
+        if (distances.empty()) {
+            distances = searchDistances();
+        }
+        return distances[static_cast<size_t>(i) * goalCount + g];
+    };
+
+    if (agentCount == goalCount) {
+        RTS_LOG(Info) << "Assigning distinct goals because agent count = goal count.\n";
+        if (agentCount <= GoalAssignment::HUNGARIAN_LIMIT) {
+            // Optimal total distance
+            std::vector<double> costs(static_cast<size_t>(agentCount) * goalCount);
+            for (int i = 0; i < agentCount; ++i) {
+                for (int g = 0; g < goalCount; ++g) {
+                    costs[i * goalCount + g] = pairCost(i, g);
+                }
+            }
+            choice = GoalAssignment::hungarian(costs, agentCount, goalCount);
+            // The matrix prices unreachable pairs; drop any that were forced
+            for (int i = 0; i < agentCount; ++i) {
+                if (choice[i] >= 0 && !map.areConnected(agents.row(i), agents.col(i),
+                                                        goalCells[choice[i]].first,
+                                                        goalCells[choice[i]].second)) {
+                    choice[i] = -1;
+                }
+            }
+        } else if (assignmentCost == AssignmentCost::Manhattan) {
+            // Too large for O(n^3): nearest free goal, closest agents first
+            choice = assignWithinComponents(positions, GoalAssignment::greedyNearest);
+        } else {
+            // Same greedy order on the true distances, one lookup per pair
+            choice = GoalAssignment::greedyCheapest(agentCount, goalCount, pairCost);
         }
     }
     else {
         // Otherwise, use nearest goal logic
-        std::cout << "Assigning goals by nearest-distance (some goals may be shared).\n";
-
-        // Each agent picks the single nearest goal
-        for (auto &agent : agents) {
-            double bestDist = std::numeric_limits<double>::infinity();
-            int bestGoalIdx = -1;
-
-            for (int i = 0; i < (int)goalCells.size(); ++i) {
-                auto &gcell = goalCells[i];
-                double dist = computeDistance(agent.row, agent.col,
-                                              gcell.first, gcell.second);
-                if (dist < bestDist) {
-                    bestDist = dist;
-                    bestGoalIdx = i;
+        RTS_LOG(Info) << "Assigning goals by nearest-distance (some goals may be shared).\n";
+        if (assignmentCost == AssignmentCost::Manhattan) {
+            choice = assignWithinComponents(positions, GoalAssignment::nearestGoals);
+        } else {
+            // True distances are O(1) per goal once the fields or the matrix exist
+            choice.assign(agentCount, -1);
+            for (int i = 0; i < agentCount; ++i) {
+                double bestDist = GoalAssignment::UNREACHABLE_COST;
+                for (int g = 0; g < goalCount; ++g) {
+                    double dist = pairCost(i, g);
+                    if (dist < bestDist) {
+                        bestDist = dist;
+                        choice[i] = g;
+                    }
                 }
             }
+        }
+    }
 
-            if (bestGoalIdx >= 0) {
-                auto &gcell = goalCells[bestGoalIdx];
-                agent.goalRow = gcell.first;
-                agent.goalCol = gcell.second;
-                std::cout << "Agent " << agent.id
-                          << " assigned goal ("
-                          << agent.goalRow << "," << agent.goalCol << ")\n";
-            } else {
-                agent.goalRow = -1;
-                agent.goalCol = -1;
-                std::cout << "Agent " << agent.id
-                          << " found no available goal.\n";
+    for (int i = 0; i < agentCount; ++i) {
+        if (choice[i] >= 0) {
+            const auto &gcell = goalCells[choice[i]];
+            agents.setGoal(i, gcell.first, gcell.second);
+            RTS_LOG(Debug) << "Agent " << i
+                           << " assigned goal ("
+                           << gcell.first << "," << gcell.second << ")\n";
+        } else {
+            agents.setGoal(i, -1, -1);
+            RTS_LOG(Warning) << "Agent " << i
+                             << " found no available goal.\n";
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Selects the distance used by assignGoals().
+ * 
+ * @param cost Manhattan (default), FlowFieldDistance or SearchDistance.
+ */
+void MultiUnitCoordinator::setAssignmentCost(AssignmentCost cost)
+{
+    assignmentCost = cost;
+}
+
+/*******************************************************************************
+ * @brief Runs a Manhattan assignment separately inside each connected area.
+ * 
+ * Agents and goals are grouped by Map::getComponent; the assignment sees one
+ * group at a time and its goal indices are mapped back to goalCells. With a
+ * single area this is the plain assignment.
+ * 
+ * @param positions Agent cells, in agent order.
+ * @param assign    GoalAssignment::greedyNearest or GoalAssignment::nearestGoals.
+ * @return          Goal index (into goalCells) for each agent, or -1.
+ */
+std::vector<int> MultiUnitCoordinator::assignWithinComponents(
+    const std::vector<std::pair<int,int>>& positions,
+    const std::function<std::vector<int>(const std::vector<std::pair<int,int>>&,
+                                         const std::vector<std::pair<int,int>>&)>& assign) const
+{
+    // Member indices of each area, in first-seen order
+    std::unordered_map<int, std::pair<std::vector<int>, std::vector<int>>> groups;
+    for (int g = 0; g < static_cast<int>(goalCells.size()); ++g) {
+        int component = map.getComponent(goalCells[g].first, goalCells[g].second);
+        if (component >= 0) {
+            groups[component].second.push_back(g);
+        }
+    }
+    std::vector<int> choice(positions.size(), -1);
+    for (int i = 0; i < static_cast<int>(positions.size()); ++i) {
+        int component = map.getComponent(positions[i].first, positions[i].second);
+        if (component >= 0) {
+            groups[component].first.push_back(i);
+        }
+    }
+
+    std::vector<std::pair<int,int>> groupAgents, groupGoals;
+    for (const auto &entry : groups) {
+        const std::vector<int>& agentIds = entry.second.first;
+        const std::vector<int>& goalIds = entry.second.second;
+        if (agentIds.empty() || goalIds.empty()) {
+            continue;
+        }
+        groupAgents.clear();
+        groupGoals.clear();
+        for (int i : agentIds) {
+            groupAgents.push_back(positions[i]);
+        }
+        for (int g : goalIds) {
+            groupGoals.push_back(goalCells[g]);
+        }
+        std::vector<int> groupChoice = assign(groupAgents, groupGoals);
+        for (size_t k = 0; k < agentIds.size(); ++k) {
+            if (groupChoice[k] >= 0) {
+                choice[agentIds[k]] = goalIds[groupChoice[k]];
+            }
+        }
+    }
+    return choice;
+}
+
+/*******************************************************************************
+ * @brief Distance between an agent and a goal under the selected AssignmentCost.
+ * 
+ * Flow-field distances require refreshFlowFields() to have covered the goal;
+ * unreachable pairs cost GoalAssignment::UNREACHABLE_COST. Pairs in different
+ * connected areas are priced that way without looking at any field.
+ */
+double MultiUnitCoordinator::assignmentDistance(size_t agent,
+                                                const std::pair<int,int>& goal) const
+{
+    const int row = agents.row(agent);
+    const int col = agents.col(agent);
+    if (!map.areConnected(row, col, goal.first, goal.second)) {
+        return GoalAssignment::UNREACHABLE_COST;
+    }
+    if (assignmentCost == AssignmentCost::Manhattan) {
+        return computeDistance(row, col, goal.first, goal.second);
+    }
+    const FlowField* field = getFlowField(goal.first, goal.second);
+    if (!field || !field->isReachable(row, col)) {
+        return GoalAssignment::UNREACHABLE_COST;
+    }
+    return field->distance(row, col);
+}
+
+/*******************************************************************************
+ * @brief Agents x goals matrix of true path costs for SearchDistance.
+ * 
+ * One early-terminating search per member of the smaller side (backward
+ * from the goals if there are fewer goals), spread over the thread pool.
+ * Unreachable pairs cost GoalAssignment::UNREACHABLE_COST.
+ * 
+ * @return Row-major matrix; entry [i * goalCells.size() + g] is agent i to goal g.
+ */
+std::vector<double> MultiUnitCoordinator::searchDistances()
+{
+    std::vector<std::pair<int,int>> positions;
+    positions.reserve(agents.size());
+    for (size_t i = 0; i < agents.size(); ++i) {
+        positions.push_back(agents.position(i));
+    }
+    const size_t goalCount = goalCells.size();
+    std::vector<double> matrix(positions.size() * goalCount);
+
+    if (positions.size() <= goalCount) {
+        runTasks(positions.size(), [&](size_t i, SearchContext& context) {
+            Pathfinding::distancesFrom(map, context, positions[i].first, positions[i].second,
+                                       goalCells, matrix.data() + i * goalCount);
+        });
+    } else {
+        std::vector<double> columns(goalCount * positions.size());
+        runTasks(goalCount, [&](size_t g, SearchContext& context) {
+            Pathfinding::distancesFrom(map, context, goalCells[g].first, goalCells[g].second,
+                                       positions, columns.data() + g * positions.size(), true);
+        });
+        for (size_t g = 0; g < goalCount; ++g) {
+            for (size_t i = 0; i < positions.size(); ++i) {
+                matrix[i * goalCount + g] = columns[g * positions.size() + i];
             }
         }
     }
+    for (double& cost : matrix) {
+        cost = std::min(cost, GoalAssignment::UNREACHABLE_COST);
+    }
+    return matrix;
 }
 
+/*******************************************************************************
+ * @brief Selects how planPaths() computes paths.
+ * 
+ * @param mode PerAgentSearch (default), FlowFields, Cooperative or ConflictBased.
+ */
+void MultiUnitCoordinator::setPlanningMode(PlanningMode mode)
+{
+    planningMode = mode;
+    if (mode != PlanningMode::PerAgentSearch) {
+        clearPathRequests();
+    }
+}
+
+/*******************************************************************************
+ * @brief Configures the cooperative planning window.
+ * 
+ * @param window         Planning depth, in ticks (at least 1).
+ * @param replanInterval Ticks between replans, clamped to 1..window.
+ */
+void MultiUnitCoordinator::setCooperativeWindow(int window, int replanInterval)
+{
+    cooperativeWindow = std::max(1, window);
+    cooperativeInterval = std::min(std::max(1, replanInterval), cooperativeWindow);
+}
+
+/*******************************************************************************
+ * @brief Configures the conflict-based planning mode.
+ * 
+ * @param options Suboptimality, node budget and deadline of each solve.
+ */
+void MultiUnitCoordinator::setConflictBasedOptions(const ConflictBasedSearch::Options& options)
+{
+    conflictBasedOptions = options;
+}
+
+/*******************************************************************************
+ * @brief Plans all agents jointly with ConflictBasedSearch.
+ * 
+ * Agents without a goal, or whose goal is unreachable, take part with their
+ * own cell as the goal, so the others plan around them. Budget or deadline
+ * exhaustion still yields the solver's best-effort paths.
+ */
+void MultiUnitCoordinator::planConflictBased()
+{
+    ConflictBasedSearch::Squad squad;
+    std::vector<uint8_t> travelling(agents.size(), 0);
+    for (size_t i = 0; i < agents.size(); ++i) {
+        travelling[i] = map.areConnected(agents.row(i), agents.col(i),
+                                         agents.goalRow(i), agents.goalCol(i));
+        squad.starts.push_back(agents.position(i));
+        squad.goals.push_back(travelling[i] ? std::make_pair(agents.goalRow(i), agents.goalCol(i))
+                                            : agents.position(i));
+    }
+
+    ConflictBasedSearch::Result result = ConflictBasedSearch::solve(map, squad,
+                                                                    conflictBasedOptions);
+    {
+        LogLine line(LogLevel::Info);
+        line.stream() << "Conflict-based search: " << ConflictBasedSearch::statusName(result.status)
+                      << ", cost " << result.cost << " (lower bound " << result.lowerBound
+                      << "), " << result.nodesExpanded << " node(s) expanded";
+        if (result.conflicts > 0) {
+            line.stream() << ", " << result.conflicts << " conflict(s) left";
+        }
+        line.stream() << "\n";
+    }
+
+    for (size_t i = 0; i < agents.size(); ++i) {
+        agents.clearPath(i);
+        if (travelling[i] && i < result.paths.size()) {
+            agents.setPath(i, result.paths[i]);
+        }
+        if (!agents.hasGoal(i)) {
+            continue;
+        }
+        if (!agents.hasPath(i)) {
+            RTS_LOG(Warning) << "Agent " << i << " => No path found.\n";
+        } else {
+            RTS_LOG(Debug) << "Agent " << i
+                           << " path length: " << agents.pathCellCount(i) << "\n";
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Plans every agent for the next window (WHCA*).
+ * 
+ * Reservations are rebuilt from scratch. Agents that are not travelling
+ * (no goal, or the goal is unreachable) hold their cell for the whole
+ * window; the others are planned one at a time around the reservations of
+ * the agents before them, in an order that rotates every replan so no agent
+ * is always last.
+ */
+void MultiUnitCoordinator::planCooperative()
+{
+    std::vector<std::pair<int,int>> assignedGoals;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (agents.hasGoal(i)) {
+            assignedGoals.push_back({agents.goalRow(i), agents.goalCol(i)});
+        }
+    }
+    refreshFlowFields(assignedGoals);
+
+    reservations.clear();
+    ticksSincePlan = 0;
+    cooperativeReplanNeeded = false;
+
+    auto reservePlan = [&](size_t agent, const std::vector<std::pair<int,int>>& plan) {
+        for (int t = 0; t <= cooperativeWindow; ++t) {
+            const auto& cell = plan[std::min<size_t>(t, plan.size() - 1)];
+            reservations.reserve(map.paddedIndex(cell.first, cell.second), t,
+                                 static_cast<int>(agent));
+        }
+    };
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        const FlowField* field = agents.goalRow(i) >= 0
+                                     ? getFlowField(agents.goalRow(i), agents.goalCol(i))
+                                     : nullptr;
+        if (!field || !field->isReachable(agents.row(i), agents.col(i))) {
+            agents.clearPath(i);
+            reservePlan(i, {agents.position(i)});
+        } else {
+            order.push_back(i);
+        }
+    }
+    if (!order.empty()) {
+        std::rotate(order.begin(), order.begin() + cooperativeRound % order.size(), order.end());
+    }
+    ++cooperativeRound;
+
+    for (size_t i : order) {
+        std::vector<std::pair<int,int>> plan =
+            CooperativeAStar::findPath(map, reservations,
+                                       *getFlowField(agents.goalRow(i), agents.goalCol(i)),
+                                       static_cast<int>(i), agents.row(i), agents.col(i),
+                                       cooperativeWindow);
+        agents.setPath(i, plan);
+        reservePlan(i, plan);
+    }
+}
+
+/*******************************************************************************
+ * @brief Advances the cooperative plans by one tick.
+ * 
+ * Moves are applied simultaneously. Normally the reservations already rule
+ * out conflicts; if the map changed under a plan, or an earlier blocked move
+ * left plans out of sync, the affected agents wait and everyone is replanned
+ * on the next tick.
+ */
+void MultiUnitCoordinator::stepCooperative()
+{
+    if (ticksSincePlan >= cooperativeInterval || cooperativeReplanNeeded) {
+        planCooperative();
+    }
+    if (!advanceSimultaneously()) {
+        cooperativeReplanNeeded = true;
+    }
+    ++ticksSincePlan;
+}
 
 /*******************************************************************************
- * @brief Plans paths for each agent using A* algorithm.
+ * @brief Moves every agent one step along its time-indexed path at once.
+ * 
+ * Agents whose next cell turned impassable, stays occupied, is swapped into
+ * or is claimed by an earlier mover wait instead (without advancing their
+ * path index). Failures cascade back along following chains through a
+ * worklist of stopped agents, in O(agents) per tick. Movers leave their
+ * cells before anyone arrives, so following chains work.
+ * 
+ * @return False if any agent had to wait against its plan.
+ */
+bool MultiUnitCoordinator::advanceSimultaneously()
+{
+    bool onPlan = true;
+    size_t count = agents.size();
+    std::vector<std::pair<int,int>> target(count);
+    std::vector<uint8_t> moving(count, 0);
+    std::vector<uint8_t> advancing(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        target[i] = agents.position(i);
+        if (agents.isTravelling(i)) {
+            advancing[i] = 1;
+            target[i] = agents.nextCell(i);
+            moving[i] = target[i] != agents.position(i);
+            if (moving[i] && !map.isPassable(target[i].first, target[i].second)) {
+                moving[i] = advancing[i] = 0;
+                target[i] = agents.position(i);
+                onPlan = false;
+            }
+        }
+    }
+
+    // Agents that stop in place; each one is popped once to stop the mover
+    // claiming its cell, so blocking resolves in O(agents) overall
+    std::vector<size_t> stopped;
+    auto stop = [&](size_t i) {
+        moving[i] = advancing[i] = 0;
+        onPlan = false;
+        stopped.push_back(i);
+    };
+
+    // Each target cell goes to its lowest-numbered mover; the others wait
+    for (size_t i = 0; i < count; ++i) {
+        if (!moving[i]) {
+            continue;
+        }
+        if (moveClaims.isOccupied(target[i].first, target[i].second)) {
+            stop(i);
+        } else {
+            moveClaims.place(static_cast<int32_t>(i), target[i].first, target[i].second);
+        }
+    }
+    // A move fails if its target stays occupied or is swapped into
+    for (size_t i = 0; i < count; ++i) {
+        if (!moving[i]) {
+            continue;
+        }
+        int32_t occupant = occupancy.at(target[i].first, target[i].second);
+        if (occupant != OccupancyGrid::EMPTY && occupant != static_cast<int32_t>(i) &&
+            (!moving[occupant] || target[occupant] == agents.position(i))) {
+            stop(i);
+        }
+    }
+    // A stopped agent keeps its cell, which blocks the mover claiming it
+    while (!stopped.empty()) {
+        size_t agent = stopped.back();
+        stopped.pop_back();
+        int32_t claimant = moveClaims.at(agents.row(agent), agents.col(agent));
+        if (claimant != OccupancyGrid::EMPTY && moving[claimant]) {
+            stop(static_cast<size_t>(claimant));
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (target[i] != agents.position(i)) {
+            moveClaims.remove(static_cast<int32_t>(i), target[i].first, target[i].second);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (moving[i]) {
+            occupancy.remove(static_cast<int32_t>(i), agents.row(i), agents.col(i));
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (moving[i]) {
+            agents.setPosition(i, target[i].first, target[i].second);
+            occupancy.place(static_cast<int32_t>(i), target[i].first, target[i].second);
+        }
+        if (advancing[i]) {
+            agents.advance(i);
+        }
+    }
+    return onPlan;
+}
+
+/*******************************************************************************
+ * @brief Returns the cached flow field toward a goal.
+ * 
+ * @param goalRow Row index of the goal cell.
+ * @param goalCol Column index of the goal cell.
+ * @return The field, or nullptr if none was built for that goal.
+ */
+const FlowField* MultiUnitCoordinator::getFlowField(int goalRow, int goalCol) const
+{
+    auto it = flowFields.find(goalRow * map.getWidth() + goalCol);
+    return it == flowFields.end() ? nullptr : &it->second;
+}
+
+/*******************************************************************************
+ * @brief Runs task(i, context) for every i in [0, count).
+ * 
+ * Uses the thread pool (created on first use) when more than one worker is
+ * configured, handing each task its worker's SearchContext; otherwise runs
+ * serially with the coordinator's own context.
+ */
+void MultiUnitCoordinator::runTasks(size_t count,
+                                    const std::function<void(size_t, SearchContext&)>& task)
+{
+    if (workerCount > 1 && count > 1) {
+        if (!pool) {
+            pool = std::make_unique<ThreadPool>(workerCount);
+            workerContexts.resize(pool->size());
+        }
+        pool->parallelFor(count, [&](size_t i, unsigned worker) {
+            task(i, workerContexts[worker]);
+        });
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            task(i, searchContext);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Builds missing or outdated flow fields for the given goal cells.
+ * 
+ * A field stays valid until Map::getVersion() changes. Distinct goals are
+ * built in parallel; each build writes only its own field.
+ *
+ * @param goals Goal cells; invalid cells (negative coordinates) are skipped.
+ */
+void MultiUnitCoordinator::refreshFlowFields(const std::vector<std::pair<int,int>>& goals)
+{
+    // Distinct goal cells whose field is missing or outdated
+    std::vector<int> staleGoals;
+    for (const auto &goal : goals) {
+        if (goal.first < 0 || goal.second < 0) {
+            continue;
+        }
+        int key = goal.first * map.getWidth() + goal.second;
+        if (!flowFields[key].isCurrent(map)) {
+            staleGoals.push_back(key);
+        }
+    }
+    std::sort(staleGoals.begin(), staleGoals.end());
+    staleGoals.erase(std::unique(staleGoals.begin(), staleGoals.end()), staleGoals.end());
+
+    // The entries exist already, so building them does not touch the container
+    runTasks(staleGoals.size(), [&](size_t i, SearchContext&) {
+        int key = staleGoals[i];
+        flowFields.find(key)->second.build(map, key / map.getWidth(), key % map.getWidth());
+    });
+}
+
+/*******************************************************************************
+ * @brief Plans paths for each agent using the selected search engine.
  * 
  * This function iterates through the list of agents and attempts to find a
  * path from each agent's current position to its assigned goal using the
- * A* algorithm. If a path is found, it is stored in the agent's path member.
+ * current Pathfinder (A* unless changed via setPathfinder()).
+ * If a path is found, it is stored in the agent's path member.
  * If no path is found, the agent's path remains empty.
+ *
+ * With more than one worker the searches run on the thread pool. Each search
+ * only reads the map, uses its worker's SearchContext and writes its own
+ * agent, so no locking is needed. Results are reported afterwards in agent
+ * order, keeping console output off the planning threads.
+ *
+ * In FlowFields mode, one field per distinct goal is (re)built first and
+ * each agent's path is read off its goal's field without any search.
+ *
+ * In Cooperative mode, agents get reserved plans for the next window only;
+ * the reported length is that of the unobstructed path to the goal.
+ *
+ * In ConflictBased mode, all agents are solved jointly; paths include the
+ * waits needed to stay clear of each other.
  */
 void MultiUnitCoordinator::planPaths()
 {
-    for (auto &agent : agents) {
-        if (agent.goalRow < 0 || agent.goalCol < 0) {
+    // Length of the path found for each agent this round (0 = none)
+    std::vector<size_t> planned(agents.size(), 0);
+
+    // Fresh paths make earlier repair state and requests obsolete
+    replanners.clear();
+    changedCells.clear();
+    clearPathRequests();
+
+    if (planningMode == PlanningMode::Cooperative) {
+        cooperativeRound = 0;
+        planCooperative();
+        for (size_t i = 0; i < agents.size(); ++i) {
+            if (!agents.hasGoal(i)) {
+                continue;
+            }
+            if (!agents.hasPath(i)) {
+                RTS_LOG(Warning) << "Agent " << i << " => No path found.\n";
+            } else {
+                const FlowField* field = getFlowField(agents.goalRow(i), agents.goalCol(i));
+                RTS_LOG(Debug) << "Agent " << i << " path cost: "
+                               << field->distance(agents.row(i), agents.col(i)) << "\n";
+            }
+        }
+        return;
+    }
+    if (planningMode == PlanningMode::ConflictBased) {
+        planConflictBased();
+        return;
+    }
+
+    // Workers only fill their agents' slots; the shared path arena is
+    // written afterwards on this thread
+    std::vector<std::vector<std::pair<int, int>>> paths(agents.size());
+    auto planAgent = [&](size_t i, SearchContext& context) {
+        if (!agents.hasGoal(i)) {
             // No goal => skip
-            continue;
+            return;
+        }
+
+        // Goals in another connected area fail at once, without a search
+        const int row = agents.row(i), col = agents.col(i);
+        if (!map.areConnected(row, col, agents.goalRow(i), agents.goalCol(i))) {
+            return;
         }
 
-        // Attempt A* path
-        auto path = Pathfinding::aStar(map,
-                                       agent.row, agent.col,
-                                       agent.goalRow, agent.goalCol);
-        if (path.empty()) {
-            std::cout << "Agent " << agent.id << " => No path found.\n";
+        if (planningMode == PlanningMode::FlowFields) {
+            // Follow the shared field toward this agent's goal
+            const FlowField* field = getFlowField(agents.goalRow(i), agents.goalCol(i));
+            paths[i] = field->extractPath(row, col);
         } else {
-            agent.path = path;
-            agent.pathIndex = 0;
-            std::cout << "Agent " << agent.id
-                      << " path length: " << path.size() << "\n";
+            // Attempt a path with the selected engine
+            paths[i] = pathfinder->findPath(map, context, row, col,
+                                            agents.goalRow(i), agents.goalCol(i));
+        }
+        planned[i] = paths[i].size();
+    };
+
+    if (planningMode == PlanningMode::FlowFields) {
+        std::vector<std::pair<int,int>> assignedGoals;
+        for (size_t i = 0; i < agents.size(); ++i) {
+            assignedGoals.push_back({agents.goalRow(i), agents.goalCol(i)});
+        }
+        refreshFlowFields(assignedGoals);
+    }
+    runTasks(agents.size(), planAgent);
+
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (planned[i] > 0) {
+            storePath(i, paths[i]);
+        }
+        if (!agents.hasGoal(i)) {
+            continue;
+        }
+        if (planned[i] == 0) {
+            RTS_LOG(Warning) << "Agent " << i << " => No path found.\n";
+        } else {
+            RTS_LOG(Debug) << "Agent " << i
+                           << " path length: " << planned[i] << "\n";
         }
     }
 }
@@ -188,17 +950,17 @@ void MultiUnitCoordinator::markPathsOnMap()
 {
     // Overwrite each agent's path cells with its startVal
     // Agents that found no path => skip
-    for (auto &agent : agents) {
-        if (agent.path.empty()) {
+    for (size_t id = 0; id < agents.size(); ++id) {
+        if (!agents.hasPath(id)) {
             continue;
         }
         // Mark the entire path
-        for (size_t i = 0; i < agent.path.size() - 1; ++i) {
-            auto &cell = agent.path[i];
-            map.setCell(cell.first, cell.second, agent.startVal);
+        std::vector<std::pair<int,int>> cells = agents.path(id);
+        for (size_t i = 0; i < cells.size() - 1; ++i) {
+            map.setCell(cells[i].first, cells[i].second, agents.startVal(id));
         }
     }
-    std::cout << "Marked each agent's path in the map.\n";
+    RTS_LOG(Info) << "Marked each agent's path in the map.\n";
 }
 
 /*******************************************************************************
@@ -207,23 +969,38 @@ void MultiUnitCoordinator::markPathsOnMap()
  * This function iterates through the list of agents and checks if the next
  * cell in their path is occupied. If it is free, the agent moves to that cell.
  * If the path is empty or the agent has reached its goal, it does not move.
+ * The occupancy grid is updated as agents move, so each check is O(1) and a
+ * full tick is O(N).
  */
 void MultiUnitCoordinator::step()
 {
+    if (planningMode == PlanningMode::Cooperative) {
+        stepCooperative();
+        return;
+    }
+    if (planningMode == PlanningMode::ConflictBased) {
+        // Joint plans are time-indexed, so waits stay part of the path
+        advanceSimultaneously();
+        return;
+    }
+    if (incrementalReplanning && !changedCells.empty()) {
+        repairPaths();
+    }
+
     // Move each agent 1 step if the next cell is free
-    for (auto &agent : agents) {
-        if (agent.path.empty() || agent.pathIndex >= (int)agent.path.size() - 1) {
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.isTravelling(i)) {
             // No path or done traveling
             continue;
         }
         // Next step
-        auto [nr, nc] = agent.path[agent.pathIndex + 1];
+        auto [nr, nc] = agents.nextCell(i);
         // Check if occupied
         if (!isOccupied(nr, nc)) {
             // Move agent
-            agent.row = nr;
-            agent.col = nc;
-            agent.pathIndex++;
+            occupancy.move(static_cast<int32_t>(i), agents.row(i), agents.col(i), nr, nc);
+            agents.setPosition(i, nr, nc);
+            agents.advance(i);
         }
         // else wait this turn
     }
@@ -240,40 +1017,326 @@ void MultiUnitCoordinator::step()
  */
 bool MultiUnitCoordinator::allArrived() const
 {
-    for (auto &agent : agents) {
-        // If path not empty and we haven't reached the last cell
-        if (!agent.path.empty() &&
-            agent.pathIndex < (int)agent.path.size() - 1) {
-            return false;
+    if (planningMode == PlanningMode::Cooperative) {
+        // Windowed plans end short of the goal; only the position counts
+        for (size_t i = 0; i < agents.size(); ++i) {
+            if (agents.hasPath(i) &&
+                (agents.row(i) != agents.goalRow(i) || agents.col(i) != agents.goalCol(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // No agent with a path short of its last cell
+    return agents.allPathsFinished();
+}
+
+namespace {
+// Serving order of path requests: higher priority first, then request order
+template <class Request>
+bool servedBefore(const Request& a, const Request& b)
+{
+    return a.priority != b.priority ? a.priority > b.priority : a.sequence < b.sequence;
+}
+}
+
+/*******************************************************************************
+ * @brief Queues a path request for tick().
+ * 
+ * @param agentId  Agent id (index in detection order).
+ * @param priority Higher values are served first.
+ * @return         False if the agent does not exist, has no goal, or the
+ *                 planning mode is not PerAgentSearch.
+ */
+bool MultiUnitCoordinator::requestPath(int agentId, int priority)
+{
+    if (agentId < 0 || agentId >= (int)agents.size()) {
+        RTS_LOG(Error) << "Error: No agent with id " << agentId << "\n";
+        return false;
+    }
+    if (planningMode != PlanningMode::PerAgentSearch) {
+        RTS_LOG(Error) << "Error: Path requests need PerAgentSearch planning\n";
+        return false;
+    }
+    if (!agents.hasGoal(agentId)) {
+        return false;
+    }
+
+    // A pending request only gains priority; a changed goal is picked up
+    // when its search is next resumed
+    for (auto* requests : {&queuedRequests, &activeRequests}) {
+        for (auto& request : *requests) {
+            if (request.agent == agentId) {
+                request.priority = std::max(request.priority, priority);
+                return true;
+            }
         }
     }
+    queuedRequests.push_back(PathRequest{agentId, priority, requestSequence++, nullptr, {}});
     return true;
 }
 
+/*******************************************************************************
+ * @brief Queues a path request for every agent that has a goal.
+ */
+void MultiUnitCoordinator::requestAllPaths(int priority)
+{
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (agents.hasGoal(i)) {
+            requestPath(static_cast<int>(i), priority);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Sets the planning budget of one tick().
+ * 
+ * @param microseconds Wall-clock budget; 0 = unlimited.
+ * @param expansions   Node expansions; 0 = unlimited.
+ */
+void MultiUnitCoordinator::setPlanningBudget(double microseconds, size_t expansions)
+{
+    budgetMicroseconds = std::max(0.0, microseconds);
+    budgetExpansions = expansions;
+}
+
+/*******************************************************************************
+ * @brief Sets how many requests may be searched at once.
+ * 
+ * @param count Concurrent searches (at least 1).
+ */
+void MultiUnitCoordinator::setMaxActiveSearches(size_t count)
+{
+    maxActiveSearches = std::max<size_t>(1, count);
+}
+
+/*******************************************************************************
+ * @brief Enables or disables line-of-sight smoothing of stored paths.
+ * 
+ * @param enabled True to store searched paths as PathSmoothing waypoints.
+ */
+void MultiUnitCoordinator::setPathSmoothing(bool enabled)
+{
+    pathSmoothing = enabled;
+}
+
+/*******************************************************************************
+ * @brief Stores a searched path for an agent, smoothed if enabled.
+ * 
+ * @param agent Id of the agent.
+ * @param cells Consecutive cells, as returned by the search engines.
+ */
+void MultiUnitCoordinator::storePath(size_t agent, const std::vector<std::pair<int,int>>& cells)
+{
+    const bool diagonal = PathSmoothing::hasDiagonalMoves(cells);
+    if (pathSmoothing) {
+        agents.setPath(agent, PathSmoothing::smooth(map, cells, diagonal), diagonal);
+    } else {
+        agents.setPath(agent, cells, diagonal);
+    }
+}
+
+/*******************************************************************************
+ * @brief Drops every request, keeping their searches for reuse.
+ */
+void MultiUnitCoordinator::clearPathRequests()
+{
+    for (auto& request : activeRequests) {
+        spareSearches.push_back(std::move(request.search));
+    }
+    activeRequests.clear();
+    queuedRequests.clear();
+}
+
+/*******************************************************************************
+ * @brief Gives an agent the route of its search.
+ * 
+ * The route begins where the search started, which the agent may have left
+ * since; walking the trail back joins the two. Where the route retraces
+ * the trail, the loop in between is cut, so the agent turns around at the
+ * cell where its new route leaves the walked one.
+ * 
+ * @param agent Id of the agent, standing at trail.back().
+ * @param trail Cells walked since the search began (starting at its start).
+ * @param route Search result from the start.
+ */
+void MultiUnitCoordinator::adoptRoute(size_t agent,
+                                      const std::vector<std::pair<int,int>>& trail,
+                                      const std::vector<std::pair<int,int>>& route)
+{
+    std::vector<std::pair<int,int>> joined(trail.rbegin(), trail.rend());
+    joined.insert(joined.end(), route.begin() + 1, route.end());
+
+    std::vector<std::pair<int,int>> path;
+    std::unordered_map<int, size_t> position;  // Cell -> index in path
+    const int width = map.getWidth();
+    for (const auto& cell : joined) {
+        auto found = position.find(cell.first * width + cell.second);
+        if (found != position.end()) {
+            // Back at an earlier cell: drop the loop
+            for (size_t k = found->second + 1; k < path.size(); ++k) {
+                position.erase(path[k].first * width + path[k].second);
+            }
+            path.resize(found->second + 1);
+            continue;
+        }
+        position[cell.first * width + cell.second] = path.size();
+        path.push_back(cell);
+    }
+    storePath(agent, path);
+}
+
+/*******************************************************************************
+ * @brief Serves path requests within the per-tick planning budget.
+ * 
+ * Queued requests fill the free search slots in priority order; then the
+ * active searches resume in priority order until the budget is spent. The
+ * first one always runs, so requests advance even on a tiny budget.
+ * Requests whose agent lost its goal are dropped; a changed goal restarts
+ * the search from the agent's current cell.
+ */
+void MultiUnitCoordinator::servePathRequests()
+{
+    SearchOptions options;
+    options.landmarks = landmarks;
+
+    auto startSearch = [&](PathRequest& request) {
+        const int agent = request.agent;
+        request.search->start(map, agents.row(agent), agents.col(agent),
+                              agents.goalRow(agent), agents.goalCol(agent), options);
+        request.trail.assign(1, agents.position(agent));
+    };
+
+    while (activeRequests.size() < maxActiveSearches && !queuedRequests.empty()) {
+        auto next = std::min_element(queuedRequests.begin(), queuedRequests.end(),
+                                     servedBefore<PathRequest>);
+        PathRequest request = std::move(*next);
+        queuedRequests.erase(next);
+        if (spareSearches.empty()) {
+            request.search = std::make_unique<ResumableSearch>();
+        } else {
+            request.search = std::move(spareSearches.back());
+            spareSearches.pop_back();
+        }
+        startSearch(request);
+        activeRequests.push_back(std::move(request));
+    }
+    std::sort(activeRequests.begin(), activeRequests.end(), servedBefore<PathRequest>);
+
+    using Clock = ResumableSearch::Clock;
+    const Clock::time_point deadline =
+        budgetMicroseconds > 0
+            ? Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double, std::micro>(budgetMicroseconds))
+            : Clock::time_point::max();
+    size_t expansionsLeft = budgetExpansions;
+
+    std::vector<PathRequest> stillActive;
+    for (size_t i = 0; i < activeRequests.size(); ++i) {
+        PathRequest& request = activeRequests[i];
+        const int agent = request.agent;
+        ResumableSearch& search = *request.search;
+        bool outOfBudget = (budgetExpansions > 0 && expansionsLeft == 0) ||
+                           (budgetMicroseconds > 0 && Clock::now() >= deadline);
+        if (!agents.hasGoal(agent)) {
+            spareSearches.push_back(std::move(request.search));
+            continue;
+        }
+        if (i > 0 && outOfBudget) {
+            stillActive.push_back(std::move(request));
+            continue;
+        }
+        if (search.getGoalRow() != agents.goalRow(agent) ||
+            search.getGoalCol() != agents.goalCol(agent)) {
+            startSearch(request);
+        }
+
+        size_t before = search.getExpansions();
+        ResumableSearch::Status status = search.resume(expansionsLeft, deadline);
+        if (budgetExpansions > 0) {
+            // A restart (map changed) resets the count
+            size_t used = search.getExpansions() >= before ? search.getExpansions() - before
+                                                           : search.getExpansions();
+            expansionsLeft -= std::min(used, expansionsLeft);
+        }
+
+        if (status == ResumableSearch::Status::Running) {
+            // An idle agent heads toward the best cell found so far
+            if (!agents.isTravelling(agent)) {
+                std::vector<std::pair<int,int>> partial = search.path();
+                if (partial.size() > 1) {
+                    adoptRoute(agent, request.trail, partial);
+                }
+            }
+            stillActive.push_back(std::move(request));
+            continue;
+        }
+        if (status == ResumableSearch::Status::Found) {
+            adoptRoute(agent, request.trail, search.path());
+            RTS_LOG(Debug) << "Agent " << agent
+                           << " path length: " << agents.pathCellCount(agent) << "\n";
+        } else {
+            RTS_LOG(Warning) << "Agent " << agent << " => No path found.\n";
+        }
+        spareSearches.push_back(std::move(request.search));
+    }
+    activeRequests.swap(stillActive);
+}
+
+/*******************************************************************************
+ * @brief Runs one frame of the simulation.
+ * 
+ * @return False if no request is pending and no agent moved.
+ */
+bool MultiUnitCoordinator::tick()
+{
+    if (planningMode == PlanningMode::PerAgentSearch) {
+        servePathRequests();
+    }
+
+    std::vector<std::pair<int,int>> before;
+    before.reserve(agents.size());
+    for (size_t i = 0; i < agents.size(); ++i) {
+        before.push_back(agents.position(i));
+    }
+    step();
+
+    bool moved = false;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        moved = moved || before[i] != agents.position(i);
+    }
+    for (auto& request : activeRequests) {
+        if (request.trail.back() != agents.position(request.agent)) {
+            request.trail.push_back(agents.position(request.agent));
+        }
+    }
+    return moved || getPendingRequestCount() > 0;
+}
+
 /*******************************************************************************
  * @brief Prints the current state of all agents.
  * 
  * This function iterates through the list of agents and prints their
  * current position, assigned goal (if any), and path index.
  *
- * @param agents A vector of Agent objects representing the agents.
  */
 void MultiUnitCoordinator::printAgents() const
 {
-    for (auto &agent : agents) {
-        std::cout << "Agent " << agent.id
-                  << " startVal=" << agent.startVal
-                  << " at (" << agent.row << "," << agent.col << ")";
-        if (agent.goalRow >= 0) {
-            std::cout << " => Goal(" << agent.goalRow
-                      << "," << agent.goalCol << ")";
+    LogLine line(LogLevel::Info);
+    for (size_t i = 0; i < agents.size(); ++i) {
+        line.stream() << "Agent " << i
+                      << " startVal=" << agents.startVal(i)
+                      << " at (" << agents.row(i) << "," << agents.col(i) << ")";
+        if (agents.goalRow(i) >= 0) {
+            line.stream() << " => Goal(" << agents.goalRow(i)
+                          << "," << agents.goalCol(i) << ")";
         } else {
-            std::cout << " => NoGoal";
+            line.stream() << " => NoGoal";
         }
-        std::cout << " [pathIndex=" << agent.pathIndex
-                  << "/" << (agent.path.size() - 1) << "]\n";
+        line.stream() << " [pathIndex=" << agents.pathIndex(i)
+                      << "/" << (agents.pathLength(i) - 1) << "]\n";
     }
-    std::cout << std::endl;
+    line.stream() << "\n";
 }
 
 /*******************************************************************************
@@ -289,7 +1352,7 @@ void MultiUnitCoordinator::printAgents() const
  * @param c2 Column index of the second cell.
  * @return The Manhattan distance between the two cells.
  */
-double MultiUnitCoordinator::computeDistance(int r1, int c1, int r2, int c2)
+double MultiUnitCoordinator::computeDistance(int r1, int c1, int r2, int c2) const
 {
     // Simple Manhattan distance
     return std::abs(r1 - r2) + std::abs(c1 - c2);
@@ -298,8 +1361,8 @@ double MultiUnitCoordinator::computeDistance(int r1, int c1, int r2, int c2)
 /*******************************************************************************
  * @brief Checks if a cell is occupied by any agent.
  * 
- * This function iterates through the list of agents and checks if any agent
- * is currently occupying the specified cell (row, col).
+ * This function reads the occupancy grid to check if any agent is currently
+ * occupying the specified cell (row, col).
  * 
  * @param row Row index of the cell to check.
  * @param col Column index of the cell to check.
@@ -307,10 +1370,17 @@ double MultiUnitCoordinator::computeDistance(int r1, int c1, int r2, int c2)
  */
 bool MultiUnitCoordinator::isOccupied(int row, int col) const
 {
-    for (auto &agent : agents) {
-        if (agent.row == row && agent.col == col) {
-            return true;
-        }
+    return occupancy.isOccupied(row, col);
+}
+
+/*******************************************************************************
+ * @brief Re-records every agent's current cell in the occupancy grid.
+ */
+void MultiUnitCoordinator::rebuildOccupancy()
+{
+    occupancy.reset(map.getWidth(), map.getHeight());
+    moveClaims.reset(map.getWidth(), map.getHeight());
+    for (size_t i = 0; i < agents.size(); ++i) {
+        occupancy.place(static_cast<int32_t>(i), agents.row(i), agents.col(i));
     }
-    return false;
 }
\ No newline at end of file
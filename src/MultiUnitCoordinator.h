@@ -15,37 +15,47 @@
 
 #include "Map.h"
 #include "Pathfinding.h"
+#include "Pathfinder.h"
+#include "ThreadPool.h"
+#include "FlowField.h"
+#include "OccupancyGrid.h"
+#include "PathCache.h"
+#include "DStarLite.h"
+#include "ReservationTable.h"
+#include "ConflictBasedSearch.h"
+#include "LandmarkTable.h"
+#include "ResumableSearch.h"
+#include "AgentStore.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 /**
- * @struct Agent
- * @brief Represents an agent in the multi-unit coordination system.
- * 
- * This structure holds the agent's ID, current position, assigned goal,
- * and the path it will follow to reach that goal.
- * 
- * @var id Unique identifier for the agent (0, 1, or 2).
- * @var startVal Unique start value of the agent (0.5, 0.6, or 0.9).
- * @var row Current row position of the agent.
- * @var col Current column position of the agent.
- * @var goalRow Row position of the agent's assigned goal.
- * @var goalCol Column position of the agent's assigned goal.
- * @var path Full path from start to goal, computed using A*.
- * @var pathIndex Current index in the path, indicating the agent's position.
+ * @enum PlanningMode
+ * @brief How planPaths() computes agent paths.
  */
-struct Agent {
-    int id;
-    double startVal;                      // The agent's unique start value
-    int row, col;                         // Current position
-    int goalRow, goalCol;                 // Assigned goal
-    std::vector<std::pair<int,int>> path; // A* path, if found
-    int pathIndex = 0;
+enum class PlanningMode {
+    PerAgentSearch,  ///< One Pathfinder query per agent (default)
+    FlowFields,      ///< One shared FlowField per distinct goal
+    Cooperative,     ///< Windowed cooperative A* (WHCA*) over a reservation table
+    ConflictBased    ///< Joint collision-free plans from ConflictBasedSearch (ECBS)
 };
 
+/**
+ * @enum AssignmentCost
+ * @brief Distance measure used by assignGoals().
+ */
+enum class AssignmentCost {
+    Manhattan,         ///< Straight grid distance (default)
+    FlowFieldDistance, ///< True path cost, read from per-goal flow fields
+    SearchDistance     ///< True path cost from Pathfinding::distancesFrom, one
+                       ///< early-terminating search per agent or goal
+};
 
-
-class MultiUnitCoordinator {
+class MultiUnitCoordinator : private MapObserver {
 public:
     /**
      * Constructor referencing the map. The map is used to:
@@ -53,6 +63,10 @@ public:
      *  - Check collisions and run pathfinding
      */
     explicit MultiUnitCoordinator(Map& mapRef);
+    ~MultiUnitCoordinator() override;
+
+    MultiUnitCoordinator(const MultiUnitCoordinator&) = delete;
+    MultiUnitCoordinator& operator=(const MultiUnitCoordinator&) = delete;
 
     /**
      * 1) Finds all starts in the map with values {0.5, 0.6, 0.9}
@@ -62,19 +76,104 @@ public:
     void findStartsAndGoals();
 
     /**
-     * Assigns each agent the single nearest goal.
+     * Assigns goals to agents.
      * 
-     * Agents do NOT exclusively claim goals, so multiple agents
-     * can share the same target.
+     * If agent count == goal count, each agent gets a distinct goal, chosen
+     * to minimize the total distance (Hungarian algorithm for up to
+     * GoalAssignment::HUNGARIAN_LIMIT agents, greedy nearest-free-goal
+     * beyond that, under the distance selected by setAssignmentCost()).
+     * Otherwise each agent takes its single nearest goal, so
+     * multiple agents can share the same target.
+     *
+     * Only goals in the agent's connected area (Map::areConnected) are
+     * considered; an agent with none left gets no goal.
      */
     void assignGoals();
 
+    /**
+     * Selects the distance used by assignGoals(). FlowFieldDistance builds
+     * (and caches) one flow field per goal to get true path costs.
+     * SearchDistance computes an agents x goals cost matrix each time, with
+     * searches that stop once every goal (or agent) is settled; it is the
+     * cheaper choice when goals change often or lie close to the agents,
+     * and honors terrain costs.
+     */
+    void setAssignmentCost(AssignmentCost cost);
+
+    /**
+     * Selects the search engine used by planPaths(). Defaults to A*.
+     */
+    void setPathfinder(PathfinderType type);
+
+    /**
+     * Gives the A* engine precomputed ALT landmark tables (e.g. loaded with
+     * BinaryMap::load). The table must outlive the coordinator or be reset
+     * with nullptr; it is ignored while not current for the map.
+     */
+    void setLandmarks(const LandmarkTable* table);
+
+    /**
+     * Puts an LRU PathCache of the given capacity in front of the search
+     * engine (also across later setPathfinder calls). 0 disables it, which
+     * is the default.
+     */
+    void setPathCache(size_t capacity);
+
+    /**
+     * @return The active path cache (for its hit/miss counters), or nullptr.
+     */
+    const PathCache* getPathCache() const { return pathCache; }
+
+    /**
+     * Sets the number of threads used by planPaths(). 0 selects the hardware
+     * concurrency (the default); 1 plans on the calling thread.
+     */
+    void setWorkerCount(unsigned count);
+
+    /**
+     * Selects how planPaths() computes paths. In FlowFields mode, one
+     * reverse search per distinct goal replaces the per-agent searches;
+     * fields are cached until the map changes.
+     */
+    void setPlanningMode(PlanningMode mode);
+
+    /**
+     * Configures PlanningMode::Cooperative: each plan looks window steps
+     * ahead and step() replans every replanInterval ticks (clamped to
+     * 1..window). Defaults are 16 and 8.
+     */
+    void setCooperativeWindow(int window, int replanInterval);
+
+    /**
+     * Configures PlanningMode::ConflictBased: suboptimality bound, node
+     * budget and deadline of the joint search run by planPaths().
+     */
+    void setConflictBasedOptions(const ConflictBasedSearch::Options& options);
+
+    /**
+     * @return The cached flow field toward (goalRow, goalCol), or nullptr if
+     *         none was built. Agents can read their next step from it in O(1)
+     *         via FlowField::nextStep().
+     */
+    const FlowField* getFlowField(int goalRow, int goalCol) const;
+
     /**
      * Plans an A* path for each agent that has a valid goal.
      * If no path is found, the agent's path remains empty.
+     *
+     * With more than one worker, agents are split across a thread pool; each
+     * worker owns its SearchContext and writes only the agents it planned.
      */
     void planPaths();
 
+    /**
+     * Enables incremental replanning. The coordinator then observes the map;
+     * when setCell changes passability, the next step() repairs the path of
+     * every agent whose remaining path crosses a changed cell, using a
+     * per-agent DStarLite planner kept across repairs. Off by default.
+     */
+    void setIncrementalReplanning(bool enabled);
+
     /**
      * Overwrites each agent's path cells in the map with the agent's startVal.
      * Only applies to agents that actually have a path (path not empty).
@@ -84,7 +183,16 @@ public:
     /**
      * Moves each agent forward by one cell on its path if the next cell
      * is not occupied by another agent. If collision would occur, the agent
-     * waits this turn.
+     * waits this turn. With incremental replanning, paths broken by map
+     * changes since the last step are repaired first.
+     *
+     * In Cooperative mode, agents follow their reserved space-time plans
+     * (so they neither collide nor swap), and all agents are replanned
+     * together every replanInterval ticks with rotating priorities.
+     *
+     * In ConflictBased mode, agents follow their joint plans in lockstep;
+     * an agent whose move would collide (possible only with best-effort
+     * plans) waits a tick instead.
      */
     void step();
 
@@ -94,6 +202,79 @@ public:
      */
     bool allArrived() const;
 
+    /**
+     * Queues a path request for an agent, to be served by tick() with a
+     * time-sliced ResumableSearch from the agent's current cell. Requests
+     * of higher priority are served first, equal ones in request order.
+     * Requesting again raises the priority of a pending request; if the
+     * agent's goal changed, its search starts over.
+     * Only used in PerAgentSearch mode, always with the A* engine.
+     *
+     * @return False if the agent does not exist or has no goal.
+     */
+    bool requestPath(int agentId, int priority = 0);
+
+    /**
+     * Queues a path request for every agent that has a goal.
+     */
+    void requestAllPaths(int priority = 0);
+
+    /**
+     * Sets the planning budget of one tick(), shared by all searches of that
+     * tick: wall-clock microseconds and node expansions; 0 disables a limit.
+     * Searches always make some progress, so requests are served even when
+     * the budget is tiny. Defaults are 2000 us and no expansion limit.
+     */
+    void setPlanningBudget(double microseconds, size_t expansions);
+
+    /**
+     * Sets how many requests may be searched at once (each search holds
+     * map-sized buffers). Further requests wait in the queue. Default 4.
+     */
+    void setMaxActiveSearches(size_t count);
+
+    /**
+     * Stores the paths found by per-agent searches, flow fields, repairs and
+     * path requests as line-of-sight waypoints (see PathSmoothing); step()
+     * walks each straight segment cell by cell. Paths get no longer, but
+     * follow straight lines across open ground and take a fraction of the
+     * memory. Time-indexed Cooperative and ConflictBased plans are never
+     * smoothed. Off by default; applies to paths stored afterwards.
+     */
+    void setPathSmoothing(bool enabled);
+
+    /**
+     * @return Requests queued or being searched.
+     */
+    size_t getPendingRequestCount() const {
+        return queuedRequests.size() + activeRequests.size();
+    }
+
+    /**
+     * Advances the simulation by one frame: spends the planning budget on
+     * pending requests, then moves the agents with step().
+     *
+     * An agent keeps following its previous path while its search runs; an
+     * agent with nowhere left to go follows the partial route toward the
+     * cell its search got closest to the goal. A finished path is spliced
+     * onto the cells walked since the search began, so the switch is seamless.
+     *
+     * @return False once nothing happens any more: no request is pending and
+     *         no agent moved (all arrived, or the rest are stuck waiting).
+     */
+    bool tick();
+
+    /**
+     * @return The agent occupancy grid, kept current by step(). Useful for
+     *         local-avoidance queries via OccupancyGrid::forEachInRect().
+     */
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
+
+    /**
+     * @return The agents: positions, goals and paths, indexed by agent id.
+     */
+    const AgentStore& getAgents() const { return agents; }
+
     /**
      * Utility method for debugging: prints agent positions, goals, and path states.
      */
@@ -101,12 +282,110 @@ public:
 
 private:
     Map& map;
-    std::vector<Agent> agents;                // Our agent list
+    AgentStore agents;                        // Our agents, structure-of-arrays
     std::vector<std::pair<int,int>> goalCells; // Discovered goal cells
+    SearchContext searchContext;              // Scratch buffers for serial planPaths()
+    PathfinderType pathfinderType = PathfinderType::AStar;
+    std::unique_ptr<Pathfinder> pathfinder;   // Search engine used by planPaths()
+    const LandmarkTable* landmarks = nullptr; // ALT tables for the A* engine, if any
+    size_t pathCacheCapacity = 0;             // 0 = no cache
+    PathCache* pathCache = nullptr;           // Owned by pathfinder when enabled
+    unsigned workerCount;                     // Planning threads (1 = serial)
+    std::unique_ptr<ThreadPool> pool;         // Created on first parallel plan
+    std::vector<SearchContext> workerContexts; // One context per pool worker
+    PlanningMode planningMode = PlanningMode::PerAgentSearch;
+    AssignmentCost assignmentCost = AssignmentCost::Manhattan;
+    std::unordered_map<int, FlowField> flowFields; // Keyed by goal cell (row*width+col)
+    OccupancyGrid occupancy;                  // Agent id per cell, updated by step()
+    OccupancyGrid moveClaims;                 // Mover per target cell in advanceSimultaneously()
+    ReservationTable reservations;            // Cooperative mode: (cell, time) -> agent
+    int cooperativeWindow = 16;               // Cooperative planning depth, in ticks
+    int cooperativeInterval = 8;              // Ticks between cooperative replans
+    int ticksSincePlan = 0;                   // Ticks executed from the current plans
+    size_t cooperativeRound = 0;              // Rotates agent priorities between replans
+    bool cooperativeReplanNeeded = false;     // Plans went out of sync (blocked move)
+    ConflictBasedSearch::Options conflictBasedOptions; // ConflictBased mode settings
+    bool incrementalReplanning = false;       // Observe the map and repair paths in step()
+    std::vector<DStarLite> replanners;        // Per agent; initialized on first repair
+    std::vector<std::pair<int,int>> changedCells; // Passability changes since the last step()
+
+    // A path request served by tick()
+    struct PathRequest {
+        int agent;
+        int priority;
+        uint64_t sequence;                        // Request order among equal priorities
+        std::unique_ptr<ResumableSearch> search;  // Set once the request is active
+        std::vector<std::pair<int,int>> trail;    // Cells walked since the search began
+    };
+    std::vector<PathRequest> queuedRequests;  // Waiting for a free search
+    std::vector<PathRequest> activeRequests;  // Being searched, by priority
+    std::vector<std::unique_ptr<ResumableSearch>> spareSearches; // Reused by new requests
+    uint64_t requestSequence = 0;
+    double budgetMicroseconds = 2000.0;       // Per tick; 0 = unlimited
+    size_t budgetExpansions = 0;              // Per tick; 0 = unlimited
+    size_t maxActiveSearches = 4;
+    bool pathSmoothing = false;               // Store searched paths as waypoints
+
+    // Promotes queued requests and runs the active searches within the budget
+    void servePathRequests();
+
+    // Gives the agent the route of its search, spliced onto the walked trail
+    void adoptRoute(size_t agent, const std::vector<std::pair<int,int>>& trail,
+                    const std::vector<std::pair<int,int>>& route);
+
+    // Gives an agent a searched path, as waypoints if smoothing is on
+    void storePath(size_t agent, const std::vector<std::pair<int,int>>& cells);
+
+    // Drops every request, keeping their searches for reuse
+    void clearPathRequests();
+
+    // MapObserver: records the change and forwards it to the live replanners
+    void onCellChanged(int r, int c) override;
+
+    // MapObserver: drops the repair state built for the previous grid
+    void onMapReloaded() override;
+
+    // Repairs the paths crossing changedCells (called by step())
+    void repairPaths();
+
+    // Plans every agent for the next window in priority order (Cooperative mode)
+    void planCooperative();
+
+    // step() for Cooperative mode
+    void stepCooperative();
+
+    // Plans all agents as one squad with ConflictBasedSearch and reports it
+    void planConflictBased();
+
+    // Moves every agent one path step at once; false if any had to wait
+    bool advanceSimultaneously();
+
+    // Runs task(i, context) for i in [0, count), on the pool if enabled
+    void runTasks(size_t count, const std::function<void(size_t, SearchContext&)>& task);
+
+    // Builds missing or outdated flow fields for the given goal cells
+    void refreshFlowFields(const std::vector<std::pair<int,int>>& goals);
+
+    // Distance between an agent and a goal under the selected AssignmentCost
+    // (Manhattan or FlowFieldDistance)
+    double assignmentDistance(size_t agent, const std::pair<int,int>& goal) const;
+
+    // Agents x goals matrix of SearchDistance costs, searched in parallel
+    std::vector<double> searchDistances();
+
+    // Runs a Manhattan assignment (greedyNearest or nearestGoals) separately
+    // inside each connected area, so no agent gets a goal it cannot reach
+    std::vector<int> assignWithinComponents(
+        const std::vector<std::pair<int,int>>& positions,
+        const std::function<std::vector<int>(const std::vector<std::pair<int,int>>&,
+                                             const std::vector<std::pair<int,int>>&)>& assign) const;
 
     // For measuring distance in 'assignGoals()' (Manhattan or Euclidean)
-    double computeDistance(int r1, int c1, int r2, int c2);
+    double computeDistance(int r1, int c1, int r2, int c2) const;
 
-    // Checks if the given cell is currently occupied by an agent
+    // Checks if the given cell is currently occupied by an agent (O(1))
     bool isOccupied(int row, int col) const;
+
+    // Re-records every agent's current cell in the occupancy grid
+    void rebuildOccupancy();
 };
\ No newline at end of file
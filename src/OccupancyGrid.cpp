@@ -0,0 +1,40 @@
+/******************************************************************************
+ * File:    OccupancyGrid.cpp
+ *
+ * Overview:
+ *   Implementation of the OccupancyGrid class. The per-cell accessors are
+ *   inlined in the header because MultiUnitCoordinator::step() calls them
+ *   for every agent on every tick.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "OccupancyGrid.h"
+
+/**
+ * @brief Clears the grid and sizes it for a width x height map.
+ *
+ * @param w Map width (columns).
+ * @param h Map height (rows).
+ */
+void OccupancyGrid::reset(int w, int h)
+{
+    width = w;
+    height = h;
+    cells.assign(static_cast<size_t>(w) * h, EMPTY);
+}
+
+/**
+ * @brief Collects the ids of all agents in [r0, r1] x [c0, c1] (inclusive).
+ *
+ * @return Agent ids in row-major order of their cells.
+ */
+std::vector<int32_t> OccupancyGrid::agentsInRect(int r0, int c0, int r1, int c1) const
+{
+    std::vector<int32_t> ids;
+    forEachInRect(r0, c0, r1, c1, [&](int32_t id, int, int) {
+        ids.push_back(id);
+    });
+    return ids;
+}
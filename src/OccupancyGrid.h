@@ -0,0 +1,103 @@
+#pragma once
+
+/******************************************************************************
+ * File:    OccupancyGrid.h
+ *
+ * Overview:
+ *   This header declares the OccupancyGrid class, a dense per-cell record of
+ *   which agent stands where. It replaces linear scans over all agents:
+ *   "is this cell occupied?" is a single array read, and neighborhood
+ *   queries for local avoidance only touch the cells of the query rectangle.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class OccupancyGrid
+ *
+ * @brief Agent id per cell, or EMPTY.
+ *
+ * Holds at most one agent per cell; the caller is responsible for keeping
+ * agents from sharing cells (MultiUnitCoordinator::step() does).
+ */
+class OccupancyGrid {
+public:
+    /// Value of a cell that holds no agent
+    static constexpr int32_t EMPTY = -1;
+
+    /**
+     * @brief Clears the grid and sizes it for a width x height map.
+     */
+    void reset(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    /**
+     * @return The agent id at (r, c), or EMPTY. No bounds checks.
+     */
+    int32_t at(int r, int c) const { return cells[r * width + c]; }
+
+    /**
+     * @return True if an agent stands on (r, c). No bounds checks.
+     */
+    bool isOccupied(int r, int c) const { return at(r, c) != EMPTY; }
+
+    /**
+     * @brief Records agent id at (r, c).
+     */
+    void place(int32_t id, int r, int c) { cells[r * width + c] = id; }
+
+    /**
+     * @brief Clears (r, c) if it is held by the given agent.
+     */
+    void remove(int32_t id, int r, int c) {
+        int32_t& cell = cells[r * width + c];
+        if (cell == id) {
+            cell = EMPTY;
+        }
+    }
+
+    /**
+     * @brief Moves an agent from one cell to another.
+     */
+    void move(int32_t id, int fromR, int fromC, int toR, int toC) {
+        remove(id, fromR, fromC);
+        place(id, toR, toC);
+    }
+
+    /**
+     * @brief Calls fn(id, r, c) for every occupied cell in the rectangle
+     *        [r0, r1] x [c0, c1] (inclusive), clamped to the grid.
+     */
+    template <typename Fn>
+    void forEachInRect(int r0, int c0, int r1, int c1, Fn fn) const {
+        if (r0 < 0) r0 = 0;
+        if (c0 < 0) c0 = 0;
+        if (r1 >= height) r1 = height - 1;
+        if (c1 >= width)  c1 = width - 1;
+        for (int r = r0; r <= r1; ++r) {
+            const int32_t* row = cells.data() + r * width;
+            for (int c = c0; c <= c1; ++c) {
+                if (row[c] != EMPTY) {
+                    fn(row[c], r, c);
+                }
+            }
+        }
+    }
+
+    /**
+     * @return The ids of all agents in [r0, r1] x [c0, c1] (inclusive).
+     */
+    std::vector<int32_t> agentsInRect(int r0, int c0, int r1, int c1) const;
+
+private:
+    int width = 0;
+    int height = 0;
+    std::vector<int32_t> cells;  ///< Agent id per cell (row-major)
+};
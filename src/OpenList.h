@@ -0,0 +1,184 @@
+#pragma once
+
+/******************************************************************************
+ * File:    OpenList.h
+ *
+ * Overview:
+ *   This header defines the compact open lists used by the integer-cost
+ *   variant of Pathfinding::aStar, which takes the list type as a template
+ *   parameter:
+ *
+ *   - PackedNode is the 8-byte entry both lists store: a 32-bit padded cell
+ *     index and the 32-bit cost from the start. Coordinates are derived
+ *     from the index when a node is expanded, and f is implied by where the
+ *     entry sits, so nothing else needs to be kept per entry.
+ *   - BucketOpenList is a bucket queue keyed on the integer f. Buckets form
+ *     a ring that covers the live key range, which stays narrow for grid
+ *     searches with a consistent heuristic (a child's f exceeds its
+ *     parent's by at most twice the step cost), so push and pop are O(1).
+ *     Entries of one bucket are popped last-in first-out, which prefers the
+ *     deeper of equally promising nodes.
+ *   - PackedHeapOpenList is a binary min-heap of 12-byte (f, node) entries,
+ *     for key ranges too wide for buckets.
+ *
+ *   Both keep superseded entries instead of doing a decrease-key: a stale
+ *   entry costs eight bytes and one comparison when popped, while a real
+ *   decrease-key would need a back-pointer per cell written on every push.
+ *   Storage is kept between searches (see SearchContext).
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct PackedNode
+ * @brief Open-list entry of integer-cost searches.
+ */
+struct PackedNode {
+    uint32_t cell;   ///< Padded cell index
+    uint32_t gCost;  ///< Cost from the start
+};
+
+/**
+ * @class BucketOpenList
+ *
+ * @brief Bucket queue over integer keys, stored as a ring of buckets.
+ *
+ * Keys may be pushed in any order; the ring grows whenever the live key
+ * range outgrows it.
+ */
+class BucketOpenList {
+public:
+    /**
+     * @brief Removes all entries, keeping the bucket storage.
+     */
+    void clear() {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    size_t size() const { return count; }
+
+    /**
+     * @brief Adds an entry under key f.
+     */
+    void push(uint32_t f, PackedNode node) {
+        if (count == 0) {
+            lowest = highest = f;
+            if (buckets.empty()) {
+                buckets.resize(INITIAL_BUCKETS);
+            }
+        } else if (f < lowest || f > highest) {
+            uint32_t newLowest = std::min(lowest, f);
+            uint32_t newHighest = std::max(highest, f);
+            if (newHighest - newLowest >= buckets.size()) {
+                grow(newLowest, newHighest);
+            }
+            lowest = newLowest;
+            highest = newHighest;
+        }
+        buckets[f & (buckets.size() - 1)].push_back(node);
+        ++count;
+    }
+
+    /**
+     * @return The smallest key present. The list must not be empty.
+     */
+    uint32_t minKey() {
+        while (buckets[lowest & (buckets.size() - 1)].empty()) {
+            ++lowest;
+        }
+        return lowest;
+    }
+
+    /**
+     * @brief Removes and returns an entry with the smallest key.
+     */
+    PackedNode pop() {
+        std::vector<PackedNode>& bucket = buckets[minKey() & (buckets.size() - 1)];
+        PackedNode node = bucket.back();
+        bucket.pop_back();
+        --count;
+        return node;
+    }
+
+private:
+    static constexpr size_t INITIAL_BUCKETS = 64;  // Power of two
+
+    // Re-buckets every entry into a ring covering [newLowest, newHighest]
+    void grow(uint32_t newLowest, uint32_t newHighest) {
+        size_t size = buckets.size();
+        while (newHighest - newLowest >= size) {
+            size *= 2;
+        }
+        std::vector<std::vector<PackedNode>> resized(size);
+        for (uint64_t key = lowest; key <= highest; ++key) {
+            std::vector<PackedNode>& bucket = buckets[key & (buckets.size() - 1)];
+            resized[key & (size - 1)].swap(bucket);
+        }
+        buckets.swap(resized);
+    }
+
+    std::vector<std::vector<PackedNode>> buckets;  ///< Ring; size is a power of two
+    uint32_t lowest = 0;   ///< No entry has a smaller key
+    uint32_t highest = 0;  ///< No entry has a larger key
+    size_t count = 0;
+};
+
+/**
+ * @class PackedHeapOpenList
+ *
+ * @brief Binary min-heap of packed entries.
+ */
+class PackedHeapOpenList {
+public:
+    void clear() { heap.clear(); }
+
+    bool empty() const { return heap.empty(); }
+
+    size_t size() const { return heap.size(); }
+
+    /**
+     * @brief Adds an entry under key f.
+     */
+    void push(uint32_t f, PackedNode node) {
+        heap.push_back(Entry{f, node});
+        std::push_heap(heap.begin(), heap.end(), Greater());
+    }
+
+    /**
+     * @return The smallest key present. The list must not be empty.
+     */
+    uint32_t minKey() const { return heap.front().f; }
+
+    /**
+     * @brief Removes and returns an entry with the smallest key.
+     */
+    PackedNode pop() {
+        std::pop_heap(heap.begin(), heap.end(), Greater());
+        PackedNode node = heap.back().node;
+        heap.pop_back();
+        return node;
+    }
+
+private:
+    struct Entry {
+        uint32_t f;
+        PackedNode node;
+    };
+
+    struct Greater {
+        bool operator()(const Entry& a, const Entry& b) const { return a.f > b.f; }
+    };
+
+    std::vector<Entry> heap;
+};
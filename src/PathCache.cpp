@@ -0,0 +1,244 @@
+/******************************************************************************
+ * File:    PathCache.cpp
+ *
+ * Overview:
+ *   Implementation of the PathCache class. Entries live in a std::list
+ *   ordered by recency, with a hash index on (start, goal) and, when
+ *   sub-path reuse is on, a second index from every (goal, cell on the
+ *   path) to the entry and position, so suffix lookups are O(1).
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "PathCache.h"
+#include <algorithm>
+
+/**
+ * @brief Wraps an engine with an LRU cache bound to one map.
+ *
+ * @param engine        Engine answering cache misses.
+ * @param map           Map the cache is valid for.
+ * @param capacity      Maximum number of cached paths.
+ * @param reuseSubPaths Answer queries from suffixes of cached paths.
+ */
+PathCache::PathCache(std::unique_ptr<Pathfinder> engine, const Map& map,
+                     size_t capacity, bool reuseSubPaths)
+    : engine(std::move(engine)), map(map), capacity(capacity),
+      reuseSubPaths(reuseSubPaths)
+{
+}
+
+/**
+ * @brief Returns a cached path if one is still valid, else asks the engine.
+ *
+ * @param map       Reference to the Map object.
+ * @param context   Scratch buffers for the wrapped engine.
+ * @param startRow  Row index of the start cell.
+ * @param startCol  Column index of the start cell.
+ * @param goalRow   Row index of the goal cell.
+ * @param goalCol   Column index of the goal cell.
+ * @return          A vector of (row, column) pairs from start to goal.
+ *                  Empty if no path is found.
+ */
+std::vector<std::pair<int,int>> PathCache::findPath(const Map& map,
+                                                     SearchContext& context,
+                                                     int startRow, int startCol,
+                                                     int goalRow, int goalCol) const
+{
+    int width  = this->map.getWidth();
+    int height = this->map.getHeight();
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < height && c >= 0 && c < width;
+    };
+    if (&map != &this->map || capacity == 0 ||
+        !inBounds(startRow, startCol) || !inBounds(goalRow, goalCol)) {
+        return engine->findPath(map, context, startRow, startCol, goalRow, goalCol);
+    }
+
+    int start = startRow * width + startCol;
+    int goal  = goalRow * width + goalCol;
+    uint64_t key = (uint64_t(uint32_t(start)) << 32) | uint32_t(goal);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Exact match
+        auto found = index.find(key);
+        if (found != index.end()) {
+            EntryList::iterator it = found->second;
+            if (isValid(*it)) {
+                entries.splice(entries.begin(), entries, it);
+                ++stats.hits;
+                return it->path;
+            }
+            erase(it);
+            ++stats.invalidations;
+        }
+
+        // The start lies on a cached path to the same goal: reuse its suffix
+        if (reuseSubPaths) {
+            auto through = throughIndex.find(throughKey(goal, start));
+            if (through != throughIndex.end()) {
+                EntryList::iterator it = through->second.first;
+                size_t position = through->second.second;
+                if (isValid(*it)) {
+                    entries.splice(entries.begin(), entries, it);
+                    ++stats.suffixHits;
+                    return std::vector<std::pair<int,int>>(it->path.begin() + position,
+                                                           it->path.end());
+                }
+                erase(it);
+                ++stats.invalidations;
+            }
+        }
+
+        ++stats.misses;
+    }
+
+    // Search outside the lock; other threads may use the cache meanwhile
+    uint64_t versionBefore = map.getVersion();
+    std::vector<std::pair<int,int>> path =
+        engine->findPath(map, context, startRow, startCol, goalRow, goalCol);
+
+    Entry entry;
+    entry.key = key;
+    entry.goal = goal;
+    entry.path = path;
+    entry.mapVersion = versionBefore;
+    std::vector<int> regionIds;
+    for (const auto& cell : path) {
+        int region = map.regionOf(cell.first, cell.second);
+        if (regionIds.empty() || regionIds.back() != region) {
+            regionIds.push_back(region);
+        }
+    }
+    std::sort(regionIds.begin(), regionIds.end());
+    regionIds.erase(std::unique(regionIds.begin(), regionIds.end()), regionIds.end());
+    for (int region : regionIds) {
+        entry.regions.push_back({region, map.getRegionVersion(region)});
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    insert(std::move(entry));
+    return path;
+}
+
+/**
+ * @brief Checks an entry against the current region (or global) versions.
+ */
+bool PathCache::isValid(const Entry& entry) const
+{
+    if (entry.path.empty()) {
+        return entry.mapVersion == map.getVersion();
+    }
+    for (const auto& region : entry.regions) {
+        if (map.getRegionVersion(region.first) != region.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Removes an entry and every index slot pointing at it.
+ */
+void PathCache::erase(EntryList::iterator it) const
+{
+    for (const auto& cell : it->path) {
+        auto through = throughIndex.find(throughKey(it->goal, cell.first * map.getWidth() + cell.second));
+        if (through != throughIndex.end() && through->second.first == it) {
+            throughIndex.erase(through);
+        }
+    }
+    index.erase(it->key);
+    entries.erase(it);
+}
+
+/**
+ * @brief Adds (or replaces) an entry as the most recently used one.
+ */
+void PathCache::insert(Entry entry) const
+{
+    auto existing = index.find(entry.key);
+    if (existing != index.end()) {
+        erase(existing->second);
+    }
+
+    entries.push_front(std::move(entry));
+    EntryList::iterator it = entries.begin();
+    index[it->key] = it;
+
+    // Every cell but the goal can start a suffix query
+    if (reuseSubPaths && it->path.size() > 1) {
+        int width = map.getWidth();
+        for (size_t i = 0; i + 1 < it->path.size(); ++i) {
+            const auto& cell = it->path[i];
+            throughIndex[throughKey(it->goal, cell.first * width + cell.second)] = {it, i};
+        }
+    }
+    trim();
+}
+
+/**
+ * @brief Evicts least recently used entries beyond the capacity.
+ */
+void PathCache::trim() const
+{
+    while (entries.size() > capacity) {
+        erase(std::prev(entries.end()));
+        ++stats.evictions;
+    }
+}
+
+/**
+ * @brief Changes the capacity, evicting the oldest entries if needed.
+ */
+void PathCache::setCapacity(size_t newCapacity)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = newCapacity;
+    trim();
+}
+
+/**
+ * @brief Enables or disables answering from suffixes of cached paths.
+ */
+void PathCache::setSubPathReuse(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    reuseSubPaths = enabled;
+    if (!enabled) {
+        throughIndex.clear();
+    }
+}
+
+/**
+ * @brief Drops every entry and resets the counters.
+ */
+void PathCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    throughIndex.clear();
+    stats = Stats();
+}
+
+/**
+ * @return Number of cached paths.
+ */
+size_t PathCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+/**
+ * @return A snapshot of the counters.
+ */
+PathCache::Stats PathCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+/******************************************************************************
+ * File:    PathCache.h
+ *
+ * Overview:
+ *   This header declares the PathCache class, a Pathfinder that wraps
+ *   another engine and remembers its answers in a least-recently-used
+ *   cache keyed by (start cell, goal cell).
+ *
+ *   Invalidation is per region (see Map::REGION_SIZE): an entry records the
+ *   version of every region its path crosses and is dropped on lookup once
+ *   any of them changed. "No path" results depend on the whole map and are
+ *   tied to the global Map::getVersion() instead.
+ *
+ *   With sub-path reuse enabled, a query whose start lies on a cached path
+ *   to the same goal is answered with the suffix of that path.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "Pathfinder.h"
+#include "SearchContext.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PathCache
+ *
+ * @brief LRU cache decorator around a Pathfinder.
+ *
+ * Lookups are serialized by an internal mutex; the wrapped engine runs
+ * outside of it, so concurrent planners only contend on the cache itself.
+ */
+class PathCache : public Pathfinder {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    /**
+     * @brief Hit/miss counters since construction or the last clear().
+     */
+    struct Stats {
+        size_t hits = 0;           ///< Exact (start, goal) matches
+        size_t suffixHits = 0;     ///< Answered by the suffix of another path
+        size_t misses = 0;         ///< Forwarded to the wrapped engine
+        size_t invalidations = 0;  ///< Entries dropped because the map changed
+        size_t evictions = 0;      ///< Entries dropped to respect the capacity
+    };
+
+    /**
+     * @param engine        Engine answering cache misses.
+     * @param map           Map the cache is valid for; must outlive it.
+     * @param capacity      Maximum number of cached paths.
+     * @param reuseSubPaths Answer queries from suffixes of cached paths.
+     */
+    PathCache(std::unique_ptr<Pathfinder> engine, const Map& map,
+              size_t capacity = DEFAULT_CAPACITY, bool reuseSubPaths = true);
+
+    /**
+     * @brief Returns a cached path if one is still valid, else asks the engine.
+     *
+     * Queries on a different map than the one passed to the constructor
+     * bypass the cache.
+     */
+    std::vector<std::pair<int, int>> findPath(const Map& map,
+                                              SearchContext& context,
+                                              int startRow, int startCol,
+                                              int goalRow, int goalCol) const override;
+
+    const char* name() const override { return engine->name(); }
+
+    /**
+     * @brief Changes the capacity, evicting the oldest entries if needed.
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const { return capacity; }
+
+    /**
+     * @brief Enables or disables answering from suffixes of cached paths.
+     */
+    void setSubPathReuse(bool enabled);
+
+    /**
+     * @brief Drops every entry and resets the counters.
+     */
+    void clear();
+
+    /**
+     * @return Number of cached paths.
+     */
+    size_t size() const;
+
+    /**
+     * @return A snapshot of the counters.
+     */
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        uint64_t key;                                   // (start << 32) | goal
+        int goal;                                       // Flat goal index
+        std::vector<std::pair<int, int>> path;          // Cached answer
+        std::vector<std::pair<int, uint64_t>> regions;  // Regions crossed, with their versions
+        uint64_t mapVersion;                            // Global version (for empty paths)
+    };
+    using EntryList = std::list<Entry>;
+
+    // Key of the through-index: a cell on a cached path toward a goal
+    static uint64_t throughKey(int goal, int cell) {
+        return (uint64_t(uint32_t(goal)) << 32) | uint32_t(cell);
+    }
+
+    bool isValid(const Entry& entry) const;
+    void erase(EntryList::iterator it) const;
+    void insert(Entry entry) const;
+    void trim() const;
+
+    std::unique_ptr<Pathfinder> engine;
+    const Map& map;
+    size_t capacity;
+    bool reuseSubPaths;
+
+    mutable std::mutex mutex;
+    mutable EntryList entries;  // Most recently used first
+    mutable std::unordered_map<uint64_t, EntryList::iterator> index;
+    // Cell on a cached path -> (entry, position of the cell in its path)
+    mutable std::unordered_map<uint64_t, std::pair<EntryList::iterator, size_t>> throughIndex;
+    mutable Stats stats;
+};
@@ -0,0 +1,395 @@
+/******************************************************************************
+ * File:    PathService.cpp
+ *
+ * Overview:
+ *   Implementation of the PathService class.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "PathService.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <functional>
+
+namespace {
+// Longest sleep of an idle worker. Submitters notify without taking the
+// idle lock, so a wakeup can be missed; the timeout bounds what that costs
+const std::chrono::milliseconds IDLE_RECHECK(1);
+
+// Empty result of cancelled requests
+const PathService::Path NO_PATH;
+
+// Bits of RequestKey::flags
+const uint8_t FLAG_BIDIRECTIONAL = 1;
+const uint8_t FLAG_PARTIAL = 2;
+const uint8_t FLAG_DIAGONAL = 4;
+}
+
+/**
+ * @return The request's current status.
+ */
+PathService::Status PathService::Ticket::status() const
+{
+    if (!request) {
+        return Status::Cancelled;
+    }
+    return static_cast<Status>(request->status.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief Blocks until the request is Done or Cancelled.
+ */
+void PathService::Ticket::wait() const
+{
+    if (!request) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(request->mutex);
+    request->done.wait(lock, [this] { return ready(); });
+}
+
+/**
+ * @brief Waits for the request and returns its path.
+ */
+const PathService::Path& PathService::Ticket::get() const
+{
+    wait();
+    if (status() != Status::Done) {
+        return NO_PATH;
+    }
+    return *request->path;
+}
+
+/**
+ * @brief Withdraws the request if it was not delivered yet.
+ *
+ * @return True if this call cancelled it.
+ */
+bool PathService::Ticket::cancel()
+{
+    // A resolved request may have outlived its service
+    if (status() != Status::Pending) {
+        return false;
+    }
+    return request->service->resolve(*request, Status::Cancelled, nullptr);
+}
+
+bool PathService::RequestKey::operator==(const RequestKey& other) const
+{
+    return startIndex == other.startIndex && goalIndex == other.goalIndex &&
+           weight == other.weight && maxExpansions == other.maxExpansions &&
+           landmarks == other.landmarks && mapVersion == other.mapVersion &&
+           flags == other.flags;
+}
+
+size_t PathService::RequestKeyHash::operator()(const RequestKey& key) const
+{
+    size_t h = std::hash<int>()(key.startIndex);
+    auto mix = [&h](size_t value) { h ^= value + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2); };
+    mix(std::hash<int>()(key.goalIndex));
+    mix(std::hash<double>()(key.weight));
+    mix(std::hash<size_t>()(key.maxExpansions));
+    mix(std::hash<const void*>()(key.landmarks));
+    mix(std::hash<uint64_t>()(key.mapVersion));
+    mix(key.flags);
+    return h;
+}
+
+/**
+ * @brief Starts the workers.
+ *
+ * @param mapRef      Map to search; must outlive the service.
+ * @param threadCount Number of workers; 0 means hardware concurrency.
+ */
+PathService::PathService(const Map& mapRef, unsigned threadCount)
+    : map(mapRef)
+{
+    if (threadCount == 0) {
+        threadCount = ThreadPool::defaultThreadCount();
+    }
+    contexts.resize(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&PathService::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Stops the workers, then cancels whatever is still pending.
+ */
+PathService::~PathService()
+{
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        stopping.store(true, std::memory_order_release);
+    }
+    idle.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::shared_ptr<Request> request;
+    while (submissions.pop(request)) {
+        resolve(*request, Status::Cancelled, nullptr);
+    }
+    for (auto& entry : inFlight) {
+        for (auto& subscriber : entry.second->subscribers) {
+            resolve(*subscriber, Status::Cancelled, nullptr);
+        }
+    }
+}
+
+/**
+ * @brief Queues a path query; lock-free.
+ *
+ * @return Ticket of the request.
+ */
+PathService::Ticket PathService::submit(int startRow, int startCol, int goalRow, int goalCol,
+                                        const SearchOptions& options, Callback callback)
+{
+    auto request = std::make_shared<Request>();
+    request->service = this;
+    request->startRow = startRow;
+    request->startCol = startCol;
+    request->goalRow = goalRow;
+    request->goalCol = goalCol;
+    request->options = options;
+    request->callback = std::move(callback);
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    submittedCount.fetch_add(1, std::memory_order_relaxed);
+    queuedSubmissions.fetch_add(1, std::memory_order_release);
+    submissions.push(request);
+    idle.notify_one();
+    return Ticket(std::move(request));
+}
+
+/**
+ * @return Counters since construction.
+ */
+PathService::Stats PathService::getStats() const
+{
+    Stats stats;
+    stats.submitted = submittedCount.load(std::memory_order_relaxed);
+    stats.searches = searchCount.load(std::memory_order_relaxed);
+    stats.deduplicated = deduplicatedCount.load(std::memory_order_relaxed);
+    stats.cancelled = cancelledCount.load(std::memory_order_relaxed);
+    stats.steals = stealCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief Main loop of each worker: take a job, else sleep until work arrives.
+ *
+ * @param worker Index of this worker.
+ */
+void PathService::workerLoop(unsigned worker)
+{
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (queuedSubmissions.load(std::memory_order_acquire) > 0) {
+            drainSubmissions(worker);
+        }
+        std::shared_ptr<Job> job = takeJob(worker);
+        if (job) {
+            runJob(*job, contexts[worker]);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idleMutex);
+        idle.wait_for(lock, IDLE_RECHECK, [this] {
+            return stopping.load(std::memory_order_acquire) ||
+                   queuedSubmissions.load(std::memory_order_acquire) > 0 ||
+                   queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+/**
+ * @brief Moves queued submissions into the worker's deque.
+ *
+ * Cancelled requests are dropped, and a request identical to one in flight
+ * joins its job instead of creating another search. Only one worker drains
+ * at a time, which makes it the queue's single consumer.
+ *
+ * @param worker Index of the draining worker.
+ */
+void PathService::drainSubmissions(unsigned worker)
+{
+    if (draining.test_and_set(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<Job>> created;
+    std::shared_ptr<Request> request;
+    while (submissions.pop(request)) {
+        queuedSubmissions.fetch_sub(1, std::memory_order_relaxed);
+        if (static_cast<Status>(request->status.load(std::memory_order_acquire)) != Status::Pending) {
+            continue;
+        }
+
+        RequestKey key{-1, -1, request->options.weight, request->options.maxExpansions,
+                       request->options.landmarks, map.getVersion(), 0};
+        if (request->startRow >= 0 && request->startRow < map.getHeight() &&
+            request->startCol >= 0 && request->startCol < map.getWidth()) {
+            key.startIndex = map.paddedIndex(request->startRow, request->startCol);
+        }
+        if (request->goalRow >= 0 && request->goalRow < map.getHeight() &&
+            request->goalCol >= 0 && request->goalCol < map.getWidth()) {
+            key.goalIndex = map.paddedIndex(request->goalRow, request->goalCol);
+        }
+        key.flags = (request->options.bidirectional ? FLAG_BIDIRECTIONAL : 0) |
+                    (request->options.partialOnBudget ? FLAG_PARTIAL : 0) |
+                    (request->options.diagonal ? FLAG_DIAGONAL : 0);
+
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        auto found = inFlight.find(key);
+        if (found != inFlight.end()) {
+            found->second->subscribers.push_back(std::move(request));
+            deduplicatedCount.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        auto job = std::make_shared<Job>();
+        job->key = key;
+        job->subscribers.push_back(std::move(request));
+        inFlight.emplace(key, job);
+        created.push_back(std::move(job));
+    }
+    draining.clear(std::memory_order_release);
+
+    if (created.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+        for (auto& job : created) {
+            queues[worker]->jobs.push_back(std::move(job));
+        }
+    }
+    queuedJobs.fetch_add(created.size(), std::memory_order_release);
+    if (created.size() > 1) {
+        idle.notify_all();  // Let the others steal
+    }
+}
+
+/**
+ * @return The newest job of the worker's deque, else the oldest job of
+ *         another worker's deque, else nullptr.
+ */
+std::shared_ptr<PathService::Job> PathService::takeJob(unsigned worker)
+{
+    std::shared_ptr<Job> job;
+    {
+        WorkerQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+    for (size_t k = 1; !job && k < queues.size(); ++k) {
+        WorkerQueue& victim = *queues[(worker + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            stealCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (job) {
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+/**
+ * @brief Runs a job's search and delivers the path to its subscribers.
+ *
+ * The job stays in flight during the search, so duplicates submitted
+ * meanwhile still join it. If every subscriber is cancelled by the time the
+ * job starts, no search runs at all.
+ *
+ * @param job     The job; removed from inFlight here.
+ * @param context Scratch buffers of the calling worker.
+ */
+void PathService::runJob(Job& job, SearchContext& context)
+{
+    // Counted before the liveness check, so isIdle() cannot see a gap
+    runningJobs.fetch_add(1, std::memory_order_acq_rel);
+    const Request* live = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        for (const auto& subscriber : job.subscribers) {
+            if (static_cast<Status>(subscriber->status.load(std::memory_order_acquire)) ==
+                Status::Pending) {
+                live = subscriber.get();
+                break;
+            }
+        }
+        if (!live) {
+            inFlight.erase(job.key);
+            runningJobs.fetch_sub(1, std::memory_order_acq_rel);
+            return;
+        }
+    }
+
+    std::shared_ptr<const Path> path;
+    if (job.key.startIndex < 0 || job.key.goalIndex < 0) {
+        path = std::make_shared<const Path>();  // Off the map: no path
+    } else {
+        path = std::make_shared<const Path>(
+            Pathfinding::aStar(map, context, live->startRow, live->startCol,
+                               live->goalRow, live->goalCol, live->options));
+        searchCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<std::shared_ptr<Request>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        inFlight.erase(job.key);
+        subscribers.swap(job.subscribers);
+    }
+    for (auto& subscriber : subscribers) {
+        resolve(*subscriber, Status::Done, path);
+    }
+    runningJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Resolves a pending request exactly once.
+ *
+ * Done requests get their path and callback; in both cases waiting
+ * threads are woken and the request stops counting as pending.
+ *
+ * @return False if the request was already resolved.
+ */
+bool PathService::resolve(Request& request, Status status, std::shared_ptr<const Path> path)
+{
+    if (status == Status::Done) {
+        // Published to readers by the release exchange below
+        request.path = std::move(path);
+    }
+    int expected = static_cast<int>(Status::Pending);
+    {
+        std::lock_guard<std::mutex> lock(request.mutex);
+        if (!request.status.compare_exchange_strong(expected, static_cast<int>(status),
+                                                    std::memory_order_acq_rel)) {
+            return false;
+        }
+    }
+    request.done.notify_all();
+
+    if (status == Status::Done) {
+        if (request.callback) {
+            request.callback(*request.path);
+        }
+    } else {
+        cancelledCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+/******************************************************************************
+ * File:    PathService.h
+ *
+ * Overview:
+ *   This header declares the PathService class, which answers path queries
+ *   asynchronously so game-server threads never block on a search.
+ *
+ *   - submit() takes (start, goal, SearchOptions) and returns at once with
+ *     a Ticket; the path arrives through the ticket (wait()/get(), like a
+ *     future) and, if one is given, a callback run on the worker thread.
+ *     Submissions go through a lock-free MPSC queue (see MpscQueue.h).
+ *   - Workers take turns draining the queue into their own job deque and
+ *     run Pathfinding::aStar with a SearchContext of their own. An idle
+ *     worker steals the oldest job of another worker's deque, while owners
+ *     take their newest, so a burst drained by one worker spreads across
+ *     the pool.
+ *   - Identical requests (same cells, options and map version) that are in
+ *     flight together share one search; every ticket receives the path.
+ *   - Ticket::cancel() withdraws a request whose unit got new orders. A
+ *     search runs only if one of its tickets is still live, but a search
+ *     already running is not interrupted; its result is just not delivered
+ *     to cancelled tickets.
+ *
+ *   The map is read concurrently by the workers: change it only while the
+ *   service is idle (see isIdle()), e.g. between ticks.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "MpscQueue.h"
+#include "Pathfinding.h"
+#include "SearchContext.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PathService
+ *
+ * @brief Asynchronous A* queries on a worker pool.
+ */
+class PathService {
+public:
+    using Path = std::vector<std::pair<int, int>>;
+
+    /// Called on a worker thread with the path (empty if none was found)
+    using Callback = std::function<void(const Path&)>;
+
+    enum class Status {
+        Pending,   ///< Queued or being searched
+        Done,      ///< The path is available
+        Cancelled  ///< Withdrawn by cancel() or by the service shutting down
+    };
+
+    /**
+     * @brief Counters since construction.
+     */
+    struct Stats {
+        size_t submitted = 0;     ///< Calls to submit()
+        size_t searches = 0;      ///< Searches actually run
+        size_t deduplicated = 0;  ///< Requests that joined an identical one
+        size_t cancelled = 0;     ///< Requests withdrawn before delivery
+        size_t steals = 0;        ///< Jobs taken from another worker's deque
+    };
+
+private:
+    struct Request;
+
+public:
+    /**
+     * @class Ticket
+     * @brief Handle to one submitted request; cheap to copy.
+     */
+    class Ticket {
+    public:
+        Ticket() = default;
+
+        /**
+         * @return True if the ticket refers to a request.
+         */
+        bool valid() const { return request != nullptr; }
+
+        /**
+         * @return The request's current status.
+         */
+        Status status() const;
+
+        /**
+         * @return True once the request is Done or Cancelled.
+         */
+        bool ready() const { return status() != Status::Pending; }
+
+        /**
+         * @brief Blocks until the request is Done or Cancelled.
+         */
+        void wait() const;
+
+        /**
+         * @brief Waits for the request and returns its path.
+         *
+         * @return The path; empty if none was found or the request was
+         *         cancelled. Stays valid while a copy of the ticket exists.
+         */
+        const Path& get() const;
+
+        /**
+         * @brief Withdraws the request if it was not delivered yet.
+         *
+         * @return True if it was cancelled; false if it is already Done (its
+         *         callback may have run) or was cancelled before.
+         */
+        bool cancel();
+
+    private:
+        friend class PathService;
+        explicit Ticket(std::shared_ptr<Request> r) : request(std::move(r)) {}
+
+        std::shared_ptr<Request> request;
+    };
+
+    /**
+     * @brief Starts the workers.
+     *
+     * @param map         Map to search; must outlive the service.
+     * @param threadCount Number of workers; 0 means hardware concurrency.
+     */
+    explicit PathService(const Map& map, unsigned threadCount = 0);
+
+    /**
+     * @brief Stops the workers; requests still pending are cancelled.
+     */
+    ~PathService();
+
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    /**
+     * @brief Queues a path query. Never blocks.
+     *
+     * @param options  Search trade-offs, as for Pathfinding::aStar.
+     * @param callback Optional; run on a worker thread once the path is
+     *                 found (or proven not to exist), unless the ticket was
+     *                 cancelled first. It must not block for long.
+     * @return         Ticket of the request.
+     */
+    Ticket submit(int startRow, int startCol, int goalRow, int goalCol,
+                  const SearchOptions& options, Callback callback = nullptr);
+
+    /**
+     * @brief Queues a query with default search options.
+     */
+    Ticket submit(int startRow, int startCol, int goalRow, int goalCol) {
+        return submit(startRow, startCol, goalRow, goalCol, SearchOptions());
+    }
+
+    /**
+     * @return Requests submitted but neither delivered nor cancelled yet.
+     */
+    size_t getPendingCount() const { return pending.load(std::memory_order_acquire); }
+
+    /**
+     * @return True if no request is pending and no search is running, even
+     *         for cancelled requests; the map may then be changed.
+     */
+    bool isIdle() const {
+        return pending.load(std::memory_order_acquire) == 0 &&
+               runningJobs.load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * @return Counters since construction.
+     */
+    Stats getStats() const;
+
+    /**
+     * @return Number of worker threads.
+     */
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+private:
+    // Identity of a query, for de-duplication
+    struct RequestKey {
+        int startIndex, goalIndex;  // Padded cells
+        double weight;
+        size_t maxExpansions;
+        const LandmarkTable* landmarks;
+        uint64_t mapVersion;
+        uint8_t flags;              // bidirectional, partialOnBudget, diagonal
+
+        bool operator==(const RequestKey& other) const;
+    };
+
+    struct RequestKeyHash {
+        size_t operator()(const RequestKey& key) const;
+    };
+
+    // One submission; shared by its tickets and, until delivery, the service
+    struct Request {
+        PathService* service;
+        int startRow, startCol, goalRow, goalCol;
+        SearchOptions options;
+        Callback callback;
+        std::atomic<int> status{static_cast<int>(Status::Pending)};
+        std::shared_ptr<const Path> path;  // Set before status becomes Done
+        std::mutex mutex;                  // Guards waiting on done
+        std::condition_variable done;
+    };
+
+    // One search, shared by identical requests
+    struct Job {
+        RequestKey key;
+        std::vector<std::shared_ptr<Request>> subscribers;  // Guarded by jobsMutex
+    };
+
+    // Job deque of one worker; the owner uses the back, thieves the front
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Job>> jobs;
+    };
+
+    // Main loop of each worker thread
+    void workerLoop(unsigned worker);
+
+    // Moves queued submissions into the worker's deque, merging duplicates;
+    // does nothing if another worker is draining
+    void drainSubmissions(unsigned worker);
+
+    // Newest job of the worker's own deque, else the oldest of another's
+    std::shared_ptr<Job> takeJob(unsigned worker);
+
+    // Runs the search of a job (unless all its requests were cancelled) and
+    // delivers the path to every live subscriber
+    void runJob(Job& job, SearchContext& context);
+
+    // Marks a request Done or Cancelled, runs its callback and wakes waiters
+    // (false if it was already resolved)
+    bool resolve(Request& request, Status status, std::shared_ptr<const Path> path);
+
+    const Map& map;
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // One per worker
+    std::vector<SearchContext> contexts;               // One per worker
+
+    MpscQueue<std::shared_ptr<Request>> submissions;
+    std::atomic_flag draining = ATOMIC_FLAG_INIT;  // Held by the consumer of submissions
+    std::atomic<size_t> queuedSubmissions{0};     // In submissions
+    std::atomic<size_t> queuedJobs{0};            // In the worker deques
+
+    std::mutex jobsMutex;  // Guards inFlight and Job::subscribers
+    std::unordered_map<RequestKey, std::shared_ptr<Job>, RequestKeyHash> inFlight;
+
+    std::mutex idleMutex;
+    std::condition_variable idle;  // Wakes workers for new work or shutdown
+    std::atomic<bool> stopping{false};
+
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> runningJobs{0};          // Jobs inside runJob()
+    std::atomic<size_t> submittedCount{0};
+    std::atomic<size_t> searchCount{0};
+    std::atomic<size_t> deduplicatedCount{0};
+    std::atomic<size_t> cancelledCount{0};
+    std::atomic<size_t> stealCount{0};
+};
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * File:    PathSmoothing.cpp
+ *
+ * Overview:
+ *   Implementation of the PathSmoothing class: greedy string pulling over
+ *   the digital line walk of nextOnSegment().
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "PathSmoothing.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const double SQRT2 = 1.4142135623730951;
+
+// Slack for comparing sums of float step costs
+const double COST_EPSILON = 1e-9;
+
+int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+// Cost of one move, as Pathfinding::aStar charges it; IMPASSABLE if the
+// cell is blocked or a diagonal move cuts a blocked corner
+double moveCost(const Map& map, std::pair<int, int> from, std::pair<int, int> to)
+{
+    int idx = map.paddedIndex(to.first, to.second);
+    if (!map.passable(idx)) {
+        return Map::IMPASSABLE;
+    }
+    if (from.first != to.first && from.second != to.second) {
+        if (!map.passable(map.paddedIndex(from.first, to.second)) ||
+            !map.passable(map.paddedIndex(to.first, from.second))) {
+            return Map::IMPASSABLE;
+        }
+        return SQRT2 * map.stepCost(idx);
+    }
+    return map.stepCost(idx);
+}
+
+} // namespace
+
+/**
+ * @brief Next cell of the walk from one waypoint to the next.
+ *
+ * 4-way walks step along whichever axis keeps the cell closer to the
+ * segment (rows first on ties). 8-way walks always step along the longer
+ * axis and add the shorter one when that is closer, like Bresenham's line.
+ */
+std::pair<int, int> PathSmoothing::nextOnSegment(std::pair<int, int> from, std::pair<int, int> to,
+                                                 std::pair<int, int> current, bool diagonal)
+{
+    const long long dr = to.first - from.first;
+    const long long dc = to.second - from.second;
+    const int sr = sign(static_cast<int>(dr));
+    const int sc = sign(static_cast<int>(dc));
+    // Twice the area between the segment and a cell center, in cell units
+    auto error = [&](int r, int c) {
+        return std::llabs((r - from.first) * dc - (c - from.second) * dr);
+    };
+    const int r = current.first;
+    const int c = current.second;
+    const int rowsLeft = std::abs(to.first - r);
+    const int colsLeft = std::abs(to.second - c);
+
+    if (diagonal) {
+        if (rowsLeft == 0 || colsLeft == 0) {
+            return {r + sr * (rowsLeft > 0), c + sc * (colsLeft > 0)};
+        }
+        if (std::llabs(dr) >= std::llabs(dc)) {
+            bool withCol = colsLeft >= rowsLeft || error(r + sr, c + sc) < error(r + sr, c);
+            return {r + sr, withCol ? c + sc : c};
+        }
+        bool withRow = rowsLeft >= colsLeft || error(r + sr, c + sc) < error(r, c + sc);
+        return {withRow ? r + sr : r, c + sc};
+    }
+    if (rowsLeft > 0 && (colsLeft == 0 || error(r + sr, c) <= error(r, c + sc))) {
+        return {r + sr, c};
+    }
+    return {r, c + sc};
+}
+
+/**
+ * @return Moves of the walk between two cells.
+ */
+size_t PathSmoothing::segmentSteps(std::pair<int, int> from, std::pair<int, int> to, bool diagonal)
+{
+    size_t rows = std::abs(to.first - from.first);
+    size_t cols = std::abs(to.second - from.second);
+    return diagonal ? std::max(rows, cols) : rows + cols;
+}
+
+/**
+ * @brief Checks whether a unit can walk the segment between two cells.
+ */
+bool PathSmoothing::isWalkable(const Map& map, std::pair<int, int> from, std::pair<int, int> to,
+                               bool diagonal, double maxCost)
+{
+    double cost = 0.0;
+    for (std::pair<int, int> cell = from; cell != to;) {
+        std::pair<int, int> next = nextOnSegment(from, to, cell, diagonal);
+        cost += moveCost(map, cell, next);
+        if (cost > maxCost) {
+            return false;
+        }
+        cell = next;
+    }
+    return true;
+}
+
+/**
+ * @return True if two consecutive cells of the path are diagonal neighbors.
+ */
+bool PathSmoothing::hasDiagonalMoves(const Path& path)
+{
+    for (size_t k = 1; k < path.size(); ++k) {
+        if (path[k].first != path[k - 1].first && path[k].second != path[k - 1].second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Reduces a path to line-of-sight waypoints.
+ *
+ * From each waypoint, the path is followed as far as a walkable segment
+ * reaches (stopping at the first cell that cannot be reached, or after
+ * MAX_SEGMENT_CELLS cells); that cell becomes the next waypoint.
+ */
+PathSmoothing::Path PathSmoothing::smooth(const Map& map, const Path& path, bool diagonal)
+{
+    if (path.size() <= 2) {
+        return path;
+    }
+
+    // Cost of the path up to each cell
+    std::vector<double> prefix(path.size(), 0.0);
+    for (size_t k = 1; k < path.size(); ++k) {
+        prefix[k] = prefix[k - 1] + moveCost(map, path[k - 1], path[k]);
+    }
+
+    Path waypoints{path.front()};
+    size_t anchor = 0;
+    while (anchor + 1 < path.size()) {
+        size_t next = anchor + 1;
+        size_t last = std::min(path.size() - 1, anchor + MAX_SEGMENT_CELLS);
+        for (size_t j = anchor + 2; j <= last; ++j) {
+            if (!isWalkable(map, path[anchor], path[j], diagonal,
+                            prefix[j] - prefix[anchor] + COST_EPSILON)) {
+                break;
+            }
+            next = j;
+        }
+        waypoints.push_back(path[next]);
+        anchor = next;
+    }
+    return waypoints;
+}
+
+/**
+ * @brief Re-creates the per-cell path of a list of waypoints.
+ */
+PathSmoothing::Path PathSmoothing::expand(const Path& waypoints, bool diagonal)
+{
+    Path cells;
+    if (waypoints.empty()) {
+        return cells;
+    }
+    cells.push_back(waypoints.front());
+    for (size_t k = 1; k < waypoints.size(); ++k) {
+        if (waypoints[k] == waypoints[k - 1]) {
+            cells.push_back(waypoints[k]);  // A wait
+            continue;
+        }
+        for (std::pair<int, int> cell = waypoints[k - 1]; cell != waypoints[k];) {
+            cell = nextOnSegment(waypoints[k - 1], waypoints[k], cell, diagonal);
+            cells.push_back(cell);
+        }
+    }
+    return cells;
+}
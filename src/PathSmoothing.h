@@ -0,0 +1,93 @@
+#pragma once
+
+/******************************************************************************
+ * File:    PathSmoothing.h
+ *
+ * Overview:
+ *   This header declares the PathSmoothing class, which turns the per-cell
+ *   paths of the search engines into a few waypoints by line-of-sight
+ *   string pulling.
+ *
+ *   Between two waypoints a unit walks a digital line: the grid moves
+ *   (4-way, or 8-way for diagonal paths) that stay closest to the straight
+ *   segment. nextOnSegment() defines that walk once, so smoothing checks
+ *   exactly the cells units later step through. A segment is only taken if
+ *   its cells are passable (no cut corners on diagonal steps) and walking
+ *   it costs no more than the stretch of path it replaces, so smoothing
+ *   never makes a path longer or more expensive; on 4-way paths it turns
+ *   staircases along one side of an open area into straight-looking lines.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PathSmoothing
+ * @brief Static helpers for waypoint paths.
+ */
+class PathSmoothing {
+public:
+    using Path = std::vector<std::pair<int, int>>;
+
+    /// Path cells a single segment may replace, which bounds the work of
+    /// smooth() at O(path length * MAX_SEGMENT_CELLS)
+    static constexpr size_t MAX_SEGMENT_CELLS = 256;
+
+    /**
+     * @brief Reduces a path to line-of-sight waypoints.
+     *
+     * @param map      Map the path was planned on.
+     * @param path     Consecutive cells, as returned by the search engines.
+     * @param diagonal True if the path may move diagonally (see
+     *                 hasDiagonalMoves()); segments are then walked 8-way.
+     * @return         Waypoints, starting and ending like path; paths of
+     *                 up to two cells are returned unchanged.
+     */
+    static Path smooth(const Map& map, const Path& path, bool diagonal);
+
+    /**
+     * @return True if two consecutive cells of the path are diagonal
+     *         neighbors.
+     */
+    static bool hasDiagonalMoves(const Path& path);
+
+    /**
+     * @brief Checks whether a unit can walk the segment between two cells.
+     *
+     * @param maxCost Highest acceptable cost of the walk (terrain cost of
+     *                each cell entered, sqrt(2) times that diagonally).
+     * @return        True if every cell of the walk is passable, no
+     *                diagonal step cuts a blocked corner and the cost stays
+     *                within maxCost.
+     */
+    static bool isWalkable(const Map& map, std::pair<int, int> from, std::pair<int, int> to,
+                           bool diagonal, double maxCost);
+
+    /**
+     * @brief Next cell of the walk from one waypoint to the next.
+     *
+     * @param from    Segment start.
+     * @param to      Segment end.
+     * @param current A cell of the walk other than to (from included).
+     * @return        The cell the walk enters after current.
+     */
+    static std::pair<int, int> nextOnSegment(std::pair<int, int> from, std::pair<int, int> to,
+                                             std::pair<int, int> current, bool diagonal);
+
+    /**
+     * @return Moves of the walk between two cells.
+     */
+    static size_t segmentSteps(std::pair<int, int> from, std::pair<int, int> to, bool diagonal);
+
+    /**
+     * @brief Re-creates the per-cell path of a list of waypoints.
+     *
+     * Repeated waypoints (waits) stay repeated.
+     */
+    static Path expand(const Path& waypoints, bool diagonal);
+};
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * File:    Pathfinder.cpp
+ *
+ * Overview:
+ *   Implementation of the Pathfinder adapters and the engine factory. The
+ *   adapters simply forward to the static search routines.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Pathfinder.h"
+#include "Pathfinding.h"
+#include "JumpPointSearch.h"
+#include "HierarchicalPathfinder.h"
+#include "Logger.h"
+
+/**
+ * @brief Finds a path with 4-connected A*.
+ */
+std::vector<std::pair<int,int>> AStarPathfinder::findPath(const Map& map,
+                                                           SearchContext& context,
+                                                           int startRow, int startCol,
+                                                           int goalRow, int goalCol) const
+{
+    return Pathfinding::aStar(map, context, startRow, startCol, goalRow, goalCol, options);
+}
+
+/**
+ * @brief Finds a path with 8-connected Jump Point Search.
+ */
+std::vector<std::pair<int,int>> JumpPointPathfinder::findPath(const Map& map,
+                                                               SearchContext& context,
+                                                               int startRow, int startCol,
+                                                               int goalRow, int goalCol) const
+{
+    return JumpPointSearch::findPath(map, context, startRow, startCol, goalRow, goalCol);
+}
+
+/**
+ * @brief Creates the search engine of the given type.
+ *
+ * JPS and HPA* count every step as one cell, so on maps with differing
+ * terrain costs their paths may be more expensive than A*'s; a warning says
+ * so.
+ *
+ * @param type Engine to create.
+ * @param map  Map the engine will search.
+ * @return     A new Pathfinder instance.
+ */
+std::unique_ptr<Pathfinder> createPathfinder(PathfinderType type, const Map& map)
+{
+    if (type != PathfinderType::AStar && map.getMinStepCost() != map.getMaxStepCost()) {
+        RTS_LOG(Warning) << "The " << (type == PathfinderType::JumpPoint ? "jps" : "hpa")
+                         << " engine ignores terrain costs; use astar for cheapest paths.\n";
+    }
+    switch (type) {
+    case PathfinderType::JumpPoint:
+        return std::make_unique<JumpPointPathfinder>();
+    case PathfinderType::Hierarchical:
+        return std::make_unique<HierarchicalPathfinder>(map);
+    case PathfinderType::AStar:
+    default:
+        return std::make_unique<AStarPathfinder>();
+    }
+}
+
+/**
+ * @brief Parses an engine name ("astar", "jps" or "hpa").
+ *
+ * @param name Engine name, as returned by Pathfinder::name().
+ * @param type Receives the parsed type on success.
+ * @return     True if the name was recognized.
+ */
+bool parsePathfinderType(const std::string& name, PathfinderType& type)
+{
+    if (name == "astar") {
+        type = PathfinderType::AStar;
+        return true;
+    }
+    if (name == "jps") {
+        type = PathfinderType::JumpPoint;
+        return true;
+    }
+    if (name == "hpa") {
+        type = PathfinderType::Hierarchical;
+        return true;
+    }
+    return false;
+}
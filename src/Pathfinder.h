@@ -0,0 +1,129 @@
+#pragma once
+
+/******************************************************************************
+ * File:    Pathfinder.h
+ *
+ * Overview:
+ *   This header declares the Pathfinder interface, a common front for the
+ *   grid search engines (A*, Jump Point Search and hierarchical HPA*). Callers such as
+ *   MultiUnitCoordinator hold a Pathfinder and stay agnostic of which
+ *   engine produced the path; every engine returns the same
+ *   std::vector<std::pair<int,int>> cell list.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "Pathfinding.h"
+#include "SearchContext.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @enum PathfinderType
+ * @brief Available search engines.
+ */
+enum class PathfinderType {
+    AStar,      ///< 4-connected A* with terrain costs (Pathfinding::aStar)
+    JumpPoint,  ///< 8-connected Jump Point Search, unit cost (JumpPointSearch::findPath)
+    Hierarchical ///< 4-connected HPA* over cluster abstraction, unit cost (HierarchicalPathfinder)
+};
+
+/**
+ * @class Pathfinder
+ *
+ * @brief Interface implemented by every search engine.
+ *
+ * Implementations hold no per-query state, so one instance can be shared by
+ * several threads as long as each thread passes its own SearchContext.
+ * Engines with precomputed data (HierarchicalPathfinder) are bound to the
+ * Map they were created for.
+ */
+class Pathfinder {
+public:
+    virtual ~Pathfinder() = default;
+
+    /**
+     * @brief Finds a path from (startRow, startCol) to (goalRow, goalCol).
+     *
+     * @param map       Reference to the Map object.
+     * @param context   Scratch buffers reused between searches.
+     * @param startRow  Row index of the start cell.
+     * @param startCol  Column index of the start cell.
+     * @param goalRow   Row index of the goal cell.
+     * @param goalCol   Column index of the goal cell.
+     * @return          A vector of (row, column) pairs from start to goal.
+     *                  Empty if no path is found.
+     */
+    virtual std::vector<std::pair<int, int>> findPath(const Map& map,
+                                                      SearchContext& context,
+                                                      int startRow,
+                                                      int startCol,
+                                                      int goalRow,
+                                                      int goalCol) const = 0;
+
+    /**
+     * @return A short human-readable name of the engine.
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @class AStarPathfinder
+ * @brief Pathfinder backed by Pathfinding::aStar.
+ *
+ * The SearchOptions given at construction apply to every query, e.g. to
+ * search with LandmarkTable bounds.
+ */
+class AStarPathfinder : public Pathfinder {
+public:
+    AStarPathfinder() = default;
+    explicit AStarPathfinder(const SearchOptions& options) : options(options) {}
+
+    std::vector<std::pair<int, int>> findPath(const Map& map,
+                                              SearchContext& context,
+                                              int startRow, int startCol,
+                                              int goalRow, int goalCol) const override;
+    const char* name() const override { return "astar"; }
+
+private:
+    SearchOptions options;
+};
+
+/**
+ * @class JumpPointPathfinder
+ * @brief Pathfinder backed by JumpPointSearch::findPath.
+ */
+class JumpPointPathfinder : public Pathfinder {
+public:
+    std::vector<std::pair<int, int>> findPath(const Map& map,
+                                              SearchContext& context,
+                                              int startRow, int startCol,
+                                              int goalRow, int goalCol) const override;
+    const char* name() const override { return "jps"; }
+};
+
+/**
+ * @brief Creates the search engine of the given type.
+ *
+ * Only A* honors terrain costs; asking for another engine on a map whose
+ * costs differ logs a warning.
+ *
+ * @param type Engine to create.
+ * @param map  Map the engine will search; engines that precompute data
+ *             bind to it, so it must outlive the engine.
+ * @return     A new Pathfinder instance.
+ */
+std::unique_ptr<Pathfinder> createPathfinder(PathfinderType type, const Map& map);
+
+/**
+ * @brief Parses an engine name ("astar", "jps" or "hpa").
+ *
+ * @param name Engine name, as returned by Pathfinder::name().
+ * @param type Receives the parsed type on success.
+ * @return     True if the name was recognized.
+ */
+bool parsePathfinderType(const std::string& name, PathfinderType& type);
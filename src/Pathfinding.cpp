@@ -6,41 +6,40 @@
  *   the A* algorithm to find a path on a Map from a given start cell to a goal cell.
  * 
  *   Highlights:
- *   - The priority queue (openSet) is ordered by fCost (gCost + hCost).
- *   - gCosts are stored in a vector, indexed by row * width + col.
- *   - cameFrom stores the predecessor of each cell to reconstruct the path.
- *   - We skip out-of-bounds and "blocked" cells to avoid invalid paths.
+ *   - The open list is a binary heap ordered by fCost (gCost + hCost).
+ *   - gCosts and parent links live in a reusable SearchContext, indexed by
+ *     the map's padded cell index and generation-stamped so no per-search
+ *     clearing is needed.
+ *   - Stale open-list entries (superseded by a cheaper push) are skipped.
+ *   - Endpoints are bounds-checked once; neighbors are tested against the
+ *     padded passability bitset, whose blocked border replaces per-neighbor
+ *     bounds checks.
+ *   - SearchOptions select weighted A*, bidirectional A* (both directions
+ *     share one SearchContext), 8-way movement and an expansion budget with
+ *     partial paths, and can supply LandmarkTable bounds to tighten the
+ *     heuristic.
+ *   - Steps cost the terrain cost of the cell entered, read from the map's
+ *     dense per-cell cost array; heuristics are scaled by the cheapest
+ *     terrain so they stay admissible.
+ *   - distanceMatrix answers many-to-many cost queries with one
+ *     early-terminating Dijkstra search per point of the smaller set.
+ *   - spaceTimeAStar adds time as a search dimension for multi-agent
+ *     solvers: waits, time constraints and an optional focal list.
  * 
  * Author:  Tarun Trilokesh
  * Date:    2025-06-04
  ******************************************************************************/
 
 #include "Pathfinding.h"
-#include <queue>
-#include <unordered_map>
+#include "LandmarkTable.h"
+#include "Statistics.h"
 #include <cmath>
 #include <limits>
 #include <algorithm>
 #include <iostream>
-
-// Internal structure to represent each node in our search space
-struct Node {
-    int row, col;
-    double gCost;  // Cost from the start node to this node
-    double hCost;  // Heuristic estimate from this node to the goal
-
-    // fCost is simply gCost + hCost
-    double fCost() const {
-        return gCost + hCost;
-    }
-};
-
-// Comparator to ensure the priority_queue is a min-heap based on fCost
-struct NodeComparator {
-    bool operator()(const Node& a, const Node& b) const {
-        return a.fCost() > b.fCost();
-    }
-};
+#include <set>
+#include <tuple>
+#include <unordered_set>
 
 /**
  * @brief Heuristic function used in the A* algorithm (Manhattan distance).
@@ -56,8 +55,30 @@ double Pathfinding::heuristic(int r1, int c1, int r2, int c2) {
     return std::abs(r1 - r2) + std::abs(c1 - c2);
 }
 
+namespace {
+const double SQRT2 = 1.4142135623730951;
+}
+
+/**
+ * @brief Octile distance, the heuristic of 8-connected searches.
+ * 
+ * @param r1 Row index of the first cell.
+ * @param c1 Column index of the first cell.
+ * @param r2 Row index of the second cell.
+ * @param c2 Column index of the second cell.
+ * @return   Cost of the cheapest obstacle-free 8-way path at unit terrain cost.
+ */
+double Pathfinding::octileHeuristic(int r1, int c1, int r2, int c2) {
+    int dr = std::abs(r1 - r2);
+    int dc = std::abs(c1 - c2);
+    return (dr + dc) + (SQRT2 - 2.0) * std::min(dr, dc);
+}
+
 /**
  * @brief Main A* routine to find a path from (startRow, startCol) to (goalRow, goalCol) on the map.
+ *
+ * Convenience overload that runs the search with a temporary SearchContext.
+ * Callers issuing many queries should keep a context and use the other overload.
  * 
  * @param map       Reference to the Map object containing the grid data.
  * @param startRow  Row index of the start cell.
@@ -72,50 +93,204 @@ std::vector<std::pair<int,int>> Pathfinding::aStar(const Map& map,
                                                     int startRow, int startCol,
                                                     int goalRow, int goalCol)
 {
-    // Dimensions of the map
+    SearchContext context;
+    return aStar(map, context, startRow, startCol, goalRow, goalCol);
+}
+
+/**
+ * @brief Main A* routine, using the caller's SearchContext for all scratch data.
+ * 
+ * @param map       Reference to the Map object containing the grid data.
+ * @param context   Scratch buffers reused between searches.
+ * @param startRow  Row index of the start cell.
+ * @param startCol  Column index of the start cell.
+ * @param goalRow   Row index of the goal cell.
+ * @param goalCol   Column index of the goal cell.
+ * 
+ * @return A vector of (row, column) pairs that represents the path from start to goal.
+ *         Returns an empty vector if no path is found.
+ */
+std::vector<std::pair<int,int>> Pathfinding::aStar(const Map& map,
+                                                    SearchContext& context,
+                                                    int startRow, int startCol,
+                                                    int goalRow, int goalCol)
+{
+    return aStar(map, context, startRow, startCol, goalRow, goalCol, SearchOptions());
+}
+
+/**
+ * @brief Validates the endpoints of a query.
+ * 
+ * Checks the bounds once, so the padded border then keeps every neighbor
+ * access in range. Goals in another connected area are rejected without a
+ * search; a blocked start may still step onto its neighbors, so only
+ * passable starts are checked.
+ * 
+ * @return False if no path can exist.
+ */
+bool Pathfinding::acceptEndpoints(const Map& map,
+                                  int startRow, int startCol,
+                                  int goalRow, int goalCol)
+{
     int width  = map.getWidth();
     int height = map.getHeight();
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < height && c >= 0 && c < width;
+    };
+    if (!inBounds(startRow, startCol) || !inBounds(goalRow, goalCol)) {
+        return false;
+    }
+    if (startRow == goalRow && startCol == goalCol) {
+        return true;
+    }
+    const uint32_t goalComponent = map.componentOf(map.paddedIndex(goalRow, goalCol));
+    const uint32_t startComponent = map.componentOf(map.paddedIndex(startRow, startCol));
+    return goalComponent != ConnectivityIndex::NONE &&
+           (startComponent == ConnectivityIndex::NONE || startComponent == goalComponent);
+}
+
+/**
+ * @brief Checks whether a query can run on integer costs.
+ * 
+ * True for unidirectional 4-way searches with a whole-number weight on a
+ * map whose terrain costs are whole numbers, as long as every path cost
+ * fits 32 bits.
+ */
+bool Pathfinding::usesIntegerCosts(const Map& map, const SearchOptions& options)
+{
+    const double weight = std::max(1.0, options.weight);
+    return !options.diagonal && !options.bidirectional &&
+           weight == std::floor(weight) && map.hasIntegerCosts() &&
+           double(map.getPaddedCellCount()) * map.getMaxStepCost() * (weight + 1.0) < 4.0e9;
+}
+
+/**
+ * @brief A* routine with per-query options.
+ * 
+ * Weighted A* scales the heuristic by options.weight; stale-entry skipping
+ * stays valid because a node is only re-pushed with a lower g. Queries on
+ * whole-number costs (see usesIntegerCosts()) run the integer variant with
+ * a BucketOpenList; the rest use a heap of full nodes. When the
+ * expansion budget runs out, the path to the expanded node with the lowest
+ * heuristic (closest to the goal) is returned instead.
+ * 
+ * @param map       Reference to the Map object containing the grid data.
+ * @param context   Scratch buffers reused between searches.
+ * @param startRow  Row index of the start cell.
+ * @param startCol  Column index of the start cell.
+ * @param goalRow   Row index of the goal cell.
+ * @param goalCol   Column index of the goal cell.
+ * @param options   Weight, direction and budget of the search.
+ * @param stats     Optional expansion count and partial-path flag.
+ * 
+ * @return A vector of (row, column) pairs that represents the path from start
+ *         to goal (or toward it, if partial). Empty if no path is found.
+ */
+std::vector<std::pair<int,int>> Pathfinding::aStar(const Map& map,
+                                                    SearchContext& context,
+                                                    int startRow, int startCol,
+                                                    int goalRow, int goalCol,
+                                                    const SearchOptions& options,
+                                                    SearchStats* stats)
+{
+    SearchRecord record(stats);
+    if (stats) {
+        *stats = SearchStats();
+    }
+    std::vector<std::pair<int, int>> path;
+    if (!acceptEndpoints(map, startRow, startCol, goalRow, goalCol)) {
+        return path;
+    }
+    if (options.bidirectional) {
+        return bidirectionalAStar(map, context, startRow, startCol, goalRow, goalCol,
+                                  options, stats);
+    }
+    if (usesIntegerCosts(map, options)) {
+        return integerAStar<BucketOpenList>(map, context, startRow, startCol,
+                                            goalRow, goalCol, options, stats);
+    }
+
+    // Every step costs at least the cheapest terrain, which scales the bounds
+    const double weight = std::max(1.0, options.weight) * map.getMinStepCost();
+    const LandmarkTable* landmarks =
+        options.landmarks && !options.diagonal && options.landmarks->isCurrent(map)
+            ? options.landmarks : nullptr;
+    const int goalIndex = map.paddedIndex(goalRow, goalCol);
+
+    // Weighted estimate to the goal; with landmarks, the tighter of both bounds
+    auto estimate = [&](int r, int c, int idx) {
+        double h = options.diagonal ? octileHeuristic(r, c, goalRow, goalCol)
+                                    : heuristic(r, c, goalRow, goalCol);
+        if (landmarks) {
+            h = std::max(h, static_cast<double>(landmarks->lowerBound(idx, goalIndex)));
+        }
+        return weight * h;
+    };
 
     // Helper lambda to convert (row, col) to a unique index for our arrays
+    // (indices are in the map's padded layout)
     auto index = [&](int r, int c) {
-        return r * width + c;
+        return map.paddedIndex(r, c);
     };
+    const int stride = map.getStride();
 
-    // Priority queue storing the nodes to explore, ordered by fCost (lowest first)
-    std::priority_queue<Node, std::vector<Node>, NodeComparator> openSet;
+    // Invalidate the previous search's data (O(1) unless the map grew)
+    context.reset(map.getPaddedCellCount());
 
-    // Initialize gCosts (cost from start to each cell) to "infinity"
-    std::vector<double> gCosts(width * height, std::numeric_limits<double>::infinity());
-
-    // Map from current node to its predecessor (for path reconstruction)
-    std::unordered_map<int, int> cameFrom;
+    // Open list stored as a min-heap on fCost (lowest first)
+    using Node = SearchContext::Node;
+    std::vector<Node>& openSet = context.openList();
+    SearchContext::NodeComparator compare;
 
     // Initialize the start node and push it to our open set
     Node start {
         startRow,
         startCol,
         0.0, // gCost for start is 0
-        heuristic(startRow, startCol, goalRow, goalCol) // Estimate to goal
+        estimate(startRow, startCol, index(startRow, startCol)) // Estimate to goal
     };
-    openSet.push(start);
-    gCosts[index(startRow, startCol)] = 0.0;
-
-    // Directions for exploring orthogonal neighbors (up, down, left, right)
-    int directions[4][2] = {
-        { 0,  1},  // Right
-        { 1,  0},  // Down
-        { 0, -1},  // Left
-        {-1,  0}   // Up
+    openSet.push_back(start);
+    context.update(index(startRow, startCol), 0.0, -1);
+
+    // Directions for exploring orthogonal neighbors (up, down, left, right),
+    // then the diagonals, with the matching offset in the padded index space
+    const int directions[8][3] = {
+        { 0,  1,           1},  // Right
+        { 1,  0,      stride},  // Down
+        { 0, -1,          -1},  // Left
+        {-1,  0,     -stride},  // Up
+        { 1,  1,  stride + 1},  // Down-right
+        { 1, -1,  stride - 1},  // Down-left
+        {-1,  1, -stride + 1},  // Up-right
+        {-1, -1, -stride - 1}   // Up-left
     };
+    const int directionCount = options.diagonal ? 8 : 4;
 
     // Flag to indicate if we found a path
     bool foundPath = false;
 
+    // Expansion budget, and the expanded node closest to the goal for a
+    // partial result
+    size_t expansions = 0;
+    size_t pushes = 1;
+    size_t peakOpenSize = 1;
+    bool outOfBudget = false;
+    int closestIndex = -1;
+    double closestH = std::numeric_limits<double>::infinity();
+
     // Core A* loop
     while(!openSet.empty()) {
         // Get the node with the smallest fCost
-        Node current = openSet.top();
-        openSet.pop();
+        std::pop_heap(openSet.begin(), openSet.end(), compare);
+        Node current = openSet.back();
+        openSet.pop_back();
+
+        int currentIndex = index(current.row, current.col);
+
+        // Skip entries that were superseded by a cheaper push
+        if (current.gCost > context.gCost(currentIndex)) {
+            continue;
+        }
 
         // Check if we've reached our goal
         if (current.row == goalRow && current.col == goalCol) {
@@ -123,59 +298,782 @@ std::vector<std::pair<int,int>> Pathfinding::aStar(const Map& map,
             break;
         }
 
-        // Explore all four adjacent cells
-        for (const auto& dir : directions) {
-            int newRow = current.row + dir[0];
-            int newCol = current.col + dir[1];
+        if (options.maxExpansions > 0 && expansions >= options.maxExpansions) {
+            outOfBudget = true;
+            break;
+        }
+        ++expansions;
+        if (current.hCost < closestH) {
+            closestH = current.hCost;
+            closestIndex = currentIndex;
+        }
+
+        // Explore the adjacent cells
+        for (int d = 0; d < directionCount; ++d) {
+            const int* dir = directions[d];
+            int neighborIndex = currentIndex + dir[2];
 
-            // Skip cells that are out of bounds
-            if (newRow < 0 || newRow >= height || newCol < 0 || newCol >= width) {
+            // Skip blocked cells (one bit read from the passability bitset).
+            // Out-of-bounds neighbors land on the blocked border.
+            if (!map.passable(neighborIndex)) {
                 continue;
             }
 
-            // Skip blocked cells
-            if (map.getCell(newRow, newCol) == 3.0) {
-                continue;
+            // No corner cutting: both orthogonal cells of a diagonal step must be open
+            double stepLength = 1.0;
+            if (d >= 4) {
+                if (!map.passable(currentIndex + dir[0] * stride) ||
+                    !map.passable(currentIndex + dir[1])) {
+                    continue;
+                }
+                stepLength = SQRT2;
             }
 
-            // Cost to move from current cell to this neighbor (assume uniform cost = 1)
-            double newGCost = gCosts[index(current.row, current.col)] + 1;
+            int newRow = current.row + dir[0];
+            int newCol = current.col + dir[1];
+
+            // Cost to move from current cell to this neighbor: the terrain
+            // cost of the cell entered (1 on default terrain)
+            double newGCost = current.gCost + stepLength * map.stepCost(neighborIndex);
 
             // If we found a cheaper path to this neighbor, update and push to openSet
-            if (newGCost < gCosts[index(newRow, newCol)]) {
-                gCosts[index(newRow, newCol)] = newGCost;
-                double hCost = heuristic(newRow, newCol, goalRow, goalCol);
+            if (newGCost < context.gCost(neighborIndex)) {
+                // Record our path: "neighbor came from current"
+                context.update(neighborIndex, newGCost, currentIndex);
+                double hCost = estimate(newRow, newCol, neighborIndex);
 
                 // Create neighbor node and push to openSet
-                Node neighbor { newRow, newCol, newGCost, hCost };
-                openSet.push(neighbor);
-
-                // Record our path: "neighbor came from current"
-                cameFrom[index(newRow, newCol)] = index(current.row, current.col);
+                openSet.push_back(Node{ newRow, newCol, newGCost, hCost });
+                std::push_heap(openSet.begin(), openSet.end(), compare);
+                ++pushes;
+                peakOpenSize = std::max(peakOpenSize, openSet.size());
             }
         }
     }
 
-    // If we found the goal, reconstruct the path by tracing back from the goal
-    std::vector<std::pair<int, int>> path;
-    if (foundPath) {
-        // Start from the goal
-        int currentIndex = index(goalRow, goalCol);
+    if (stats) {
+        stats->expansions = expansions;
+        stats->pushes = pushes;
+        stats->peakOpenSize = peakOpenSize;
+    }
 
-        // Trace our steps backward until we reach the start
-        while (cameFrom.find(currentIndex) != cameFrom.end()) {
-            int r = currentIndex / width;
-            int c = currentIndex % width;
-            path.push_back({r, c});
-            currentIndex = cameFrom[currentIndex];
+    // Out of budget: head for the closest node reached so far
+    int endIndex = index(goalRow, goalCol);
+    if (outOfBudget && options.partialOnBudget && closestIndex >= 0) {
+        foundPath = true;
+        endIndex = closestIndex;
+        if (stats) {
+            stats->partial = true;
         }
+    }
 
-        // Finally add the start cell
-        path.push_back({startRow, startCol});
+    // If we found the goal, reconstruct the path by tracing back from the goal
+    if (foundPath) {
+        // Trace our steps backward from the goal until we reach the start
+        for (int currentIndex = endIndex;
+             currentIndex != -1;
+             currentIndex = context.parent(currentIndex)) {
+            path.push_back({map.paddedRow(currentIndex), map.paddedCol(currentIndex)});
+        }
 
         // Reverse to have the path in correct order: start -> goal
         std::reverse(path.begin(), path.end());
     }
     // Return the path (empty if none was found)
     return path;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief A* on integer costs over a packed open list.
+ * 
+ * The public template validates the endpoints and falls back to the
+ * general search if the query does not qualify for integer costs.
+ */
+template <class OpenList>
+std::vector<std::pair<int,int>> Pathfinding::aStar(const Map& map,
+                                                    SearchContext& context,
+                                                    int startRow, int startCol,
+                                                    int goalRow, int goalCol,
+                                                    const SearchOptions& options,
+                                                    SearchStats* stats)
+{
+    if (!usesIntegerCosts(map, options)) {
+        return aStar(map, context, startRow, startCol, goalRow, goalCol, options, stats);
+    }
+    SearchRecord record(stats);
+    if (stats) {
+        *stats = SearchStats();
+    }
+    if (!acceptEndpoints(map, startRow, startCol, goalRow, goalCol)) {
+        return {};
+    }
+    return integerAStar<OpenList>(map, context, startRow, startCol, goalRow, goalCol,
+                                  options, stats);
+}
+
+/**
+ * @brief Integer-cost A* body; endpoints are already validated.
+ * 
+ * Same expansion order rules and budget handling as the general search,
+ * but nodes are 8-byte PackedNodes and keys are exact integers. Cell
+ * coordinates are kept in the padded layout and only derived (one
+ * division) when a node is expanded.
+ */
+template <class OpenList>
+std::vector<std::pair<int,int>> Pathfinding::integerAStar(const Map& map,
+                                                           SearchContext& context,
+                                                           int startRow, int startCol,
+                                                           int goalRow, int goalCol,
+                                                           const SearchOptions& options,
+                                                           SearchStats* stats)
+{
+    const uint32_t weight = static_cast<uint32_t>(std::max(1.0, options.weight));
+    const uint32_t scale = static_cast<uint32_t>(map.getMinStepCost());
+    const LandmarkTable* landmarks =
+        options.landmarks && options.landmarks->isCurrent(map) ? options.landmarks : nullptr;
+    const int stride = map.getStride();
+    const int goalIndex = map.paddedIndex(goalRow, goalCol);
+    const int goalR = goalRow + 1, goalC = goalCol + 1;  // Padded coordinates
+
+    // Admissible integer estimate, as in the general search
+    auto estimate = [&](int r, int c, int idx) {
+        uint32_t h = static_cast<uint32_t>(std::abs(r - goalR) + std::abs(c - goalC));
+        if (landmarks) {
+            h = std::max(h, static_cast<uint32_t>(landmarks->lowerBound(idx, goalIndex)));
+        }
+        return h * scale;
+    };
+
+    context.reset(map.getPaddedCellCount());
+    OpenList& open = context.template packedOpenList<OpenList>();
+    const int startIndex = map.paddedIndex(startRow, startCol);
+    context.update(startIndex, 0.0, -1);
+    open.push(weight * estimate(startRow + 1, startCol + 1, startIndex),
+              PackedNode{static_cast<uint32_t>(startIndex), 0});
+
+    // Right, down, left, up, as in the general search
+    const int offsets[4] = {1, stride, -1, -stride};
+    const int rowSteps[4] = {0, 1, 0, -1};
+    const int colSteps[4] = {1, 0, -1, 0};
+
+    bool foundPath = false;
+    size_t expansions = 0;
+    size_t pushes = 1;
+    size_t peakOpenSize = 1;
+    bool outOfBudget = false;
+    const bool trackClosest = options.maxExpansions > 0 && options.partialOnBudget;
+    int closestIndex = -1;
+    uint32_t closestH = UINT32_MAX;
+
+    while (!open.empty()) {
+        PackedNode current = open.pop();
+        const int currentIndex = static_cast<int>(current.cell);
+
+        // Skip entries that were superseded by a cheaper push
+        if (current.gCost > context.gCost(currentIndex)) {
+            continue;
+        }
+        if (currentIndex == goalIndex) {
+            foundPath = true;
+            break;
+        }
+        if (options.maxExpansions > 0 && expansions >= options.maxExpansions) {
+            outOfBudget = true;
+            break;
+        }
+        ++expansions;
+
+        const int r = currentIndex / stride;
+        const int c = currentIndex - r * stride;
+        if (trackClosest) {
+            uint32_t h = estimate(r, c, currentIndex);
+            if (h < closestH) {
+                closestH = h;
+                closestIndex = currentIndex;
+            }
+        }
+
+        for (int d = 0; d < 4; ++d) {
+            int neighborIndex = currentIndex + offsets[d];
+            if (!map.passable(neighborIndex)) {
+                continue;
+            }
+            uint32_t newGCost = current.gCost + static_cast<uint32_t>(map.stepCost(neighborIndex));
+            if (newGCost < context.gCost(neighborIndex)) {
+                context.update(neighborIndex, newGCost, currentIndex);
+                uint32_t h = estimate(r + rowSteps[d], c + colSteps[d], neighborIndex);
+                open.push(newGCost + weight * h,
+                          PackedNode{static_cast<uint32_t>(neighborIndex), newGCost});
+                ++pushes;
+                peakOpenSize = std::max(peakOpenSize, open.size());
+            }
+        }
+    }
+
+    if (stats) {
+        stats->expansions = expansions;
+        stats->pushes = pushes;
+        stats->peakOpenSize = peakOpenSize;
+    }
+    int endIndex = goalIndex;
+    if (outOfBudget && options.partialOnBudget && closestIndex >= 0) {
+        foundPath = true;
+        endIndex = closestIndex;
+        if (stats) {
+            stats->partial = true;
+        }
+    }
+
+    std::vector<std::pair<int, int>> path;
+    if (foundPath) {
+        for (int idx = endIndex; idx != -1; idx = context.parent(idx)) {
+            path.push_back({map.paddedRow(idx), map.paddedCol(idx)});
+        }
+        std::reverse(path.begin(), path.end());
+    }
+    return path;
+}
+
+// The open lists the integer search is built for
+template std::vector<std::pair<int,int>> Pathfinding::aStar<BucketOpenList>(
+    const Map&, SearchContext&, int, int, int, int, const SearchOptions&, SearchStats*);
+template std::vector<std::pair<int,int>> Pathfinding::aStar<PackedHeapOpenList>(
+    const Map&, SearchContext&, int, int, int, int, const SearchOptions&, SearchStats*);
+
+/**
+ * @brief Bidirectional A*: alternately expands a forward search from the
+ *        start and a backward search from the goal.
+ * 
+ * Both directions share the context: forward cells at their padded index,
+ * backward cells after them. Each relaxation that reaches a cell already
+ * reached by the other direction proposes a meeting point. The search stops
+ * once neither frontier can hold a cheaper connection (its smallest f is at
+ * least the best meeting cost), which keeps the result optimal for weight 1
+ * and within the weight otherwise. The smaller frontier is expanded first.
+ * 
+ * @return Path from start to goal, a partial forward path if the budget ran
+ *         out first, or an empty vector if no path exists.
+ */
+std::vector<std::pair<int,int>> Pathfinding::bidirectionalAStar(const Map& map,
+                                                                 SearchContext& context,
+                                                                 int startRow, int startCol,
+                                                                 int goalRow, int goalCol,
+                                                                 const SearchOptions& options,
+                                                                 SearchStats* stats)
+{
+    const double weight = std::max(1.0, options.weight) * map.getMinStepCost();
+    const int cells = map.getPaddedCellCount();
+    const int stride = map.getStride();
+    const int offsets[8] = {1, stride, -1, -stride,
+                            stride + 1, stride - 1, -stride + 1, -stride - 1};
+    const int offsetCount = options.diagonal ? 8 : 4;
+    const int startIndex = map.paddedIndex(startRow, startCol);
+    const int goalIndex = map.paddedIndex(goalRow, goalCol);
+    const LandmarkTable* landmarks =
+        options.landmarks && !options.diagonal && options.landmarks->isCurrent(map)
+            ? options.landmarks : nullptr;
+
+    // Weighted estimate from a cell to the end a direction searches toward
+    const int targetIndex[2] = {goalIndex, startIndex};
+    auto estimate = [&](int side, int idx) {
+        int r = map.paddedRow(idx), c = map.paddedCol(idx);
+        int tr = map.paddedRow(targetIndex[side]), tc = map.paddedCol(targetIndex[side]);
+        double h = options.diagonal ? octileHeuristic(r, c, tr, tc) : heuristic(r, c, tr, tc);
+        if (landmarks) {
+            h = std::max(h, static_cast<double>(landmarks->lowerBound(idx, targetIndex[side])));
+        }
+        return weight * h;
+    };
+
+    // Forward entries use [0, cells), backward entries [cells, 2 * cells)
+    context.reset(2 * cells);
+    using Node = SearchContext::Node;
+    SearchContext::NodeComparator compare;
+    std::vector<Node>* open[2] = {&context.openList(), &context.reverseOpenList()};
+
+    open[0]->push_back(Node{startRow, startCol, 0.0, estimate(0, startIndex)});
+    context.update(startIndex, 0.0, -1);
+    open[1]->push_back(Node{goalRow, goalCol, 0.0, estimate(1, goalIndex)});
+    context.update(cells + goalIndex, 0.0, -1);
+
+    double bestCost = std::numeric_limits<double>::infinity();
+    int meeting = -1;
+    if (startIndex == goalIndex) {
+        bestCost = 0.0;
+        meeting = startIndex;
+    }
+
+    size_t expansions = 0;
+    size_t pushes = 2;
+    size_t peakOpenSize = 2;
+    bool outOfBudget = false;
+    int closestIndex = -1;
+    double closestH = std::numeric_limits<double>::infinity();
+
+    // Pops superseded entries so front() is a live node
+    auto dropStale = [&](int side) {
+        std::vector<Node>& heap = *open[side];
+        while (!heap.empty() &&
+               heap.front().gCost > context.gCost(side * cells +
+                                                  map.paddedIndex(heap.front().row,
+                                                                  heap.front().col))) {
+            std::pop_heap(heap.begin(), heap.end(), compare);
+            heap.pop_back();
+        }
+    };
+
+    while (true) {
+        dropStale(0);
+        dropStale(1);
+        if (open[0]->empty() || open[1]->empty() ||
+            std::max(open[0]->front().fCost(), open[1]->front().fCost()) >= bestCost) {
+            break;
+        }
+        if (options.maxExpansions > 0 && expansions >= options.maxExpansions) {
+            outOfBudget = true;
+            break;
+        }
+
+        int side = open[0]->size() <= open[1]->size() ? 0 : 1;
+        std::vector<Node>& heap = *open[side];
+        std::pop_heap(heap.begin(), heap.end(), compare);
+        Node current = heap.back();
+        heap.pop_back();
+        ++expansions;
+
+        const int base = side * cells;
+        const int otherBase = (1 - side) * cells;
+        int currentIndex = map.paddedIndex(current.row, current.col);
+        if (side == 0 && current.hCost < closestH) {
+            closestH = current.hCost;
+            closestIndex = currentIndex;
+        }
+
+        for (int d = 0; d < offsetCount; ++d) {
+            int neighborIndex = currentIndex + offsets[d];
+            if (!map.passable(neighborIndex)) {
+                continue;
+            }
+            double stepLength = 1.0;
+            if (d >= 4) {
+                // The orthogonal cells of the diagonal (no corner cutting)
+                int dr = offsets[d] > 0 ? stride : -stride;
+                if (!map.passable(currentIndex + dr) ||
+                    !map.passable(currentIndex + offsets[d] - dr)) {
+                    continue;
+                }
+                stepLength = SQRT2;
+            }
+
+            // A step costs the terrain of the cell entered; walking backward,
+            // that is the cell being expanded
+            int entered = side == 0 ? neighborIndex : currentIndex;
+            double newGCost = current.gCost + stepLength * map.stepCost(entered);
+            if (newGCost >= context.gCost(base + neighborIndex)) {
+                continue;
+            }
+            context.update(base + neighborIndex, newGCost, currentIndex);
+            int newRow = map.paddedRow(neighborIndex);
+            int newCol = map.paddedCol(neighborIndex);
+            heap.push_back(Node{newRow, newCol, newGCost, estimate(side, neighborIndex)});
+            std::push_heap(heap.begin(), heap.end(), compare);
+            ++pushes;
+            peakOpenSize = std::max(peakOpenSize, open[0]->size() + open[1]->size());
+
+            // Reached by the other direction too: a candidate connection
+            if (context.isVisited(otherBase + neighborIndex)) {
+                double total = newGCost + context.gCost(otherBase + neighborIndex);
+                if (total < bestCost) {
+                    bestCost = total;
+                    meeting = neighborIndex;
+                }
+            }
+        }
+    }
+
+    if (stats) {
+        stats->expansions = expansions;
+        stats->pushes = pushes;
+        stats->peakOpenSize = peakOpenSize;
+    }
+
+    std::vector<std::pair<int, int>> path;
+    int forwardEnd = meeting;
+    if (meeting < 0) {
+        if (!outOfBudget || !options.partialOnBudget || closestIndex < 0) {
+            return path;
+        }
+        forwardEnd = closestIndex;
+        if (stats) {
+            stats->partial = true;
+        }
+    }
+
+    // Start -> meeting point along the forward links
+    for (int idx = forwardEnd; idx != -1; idx = context.parent(idx)) {
+        path.push_back({map.paddedRow(idx), map.paddedCol(idx)});
+    }
+    std::reverse(path.begin(), path.end());
+
+    // Meeting point -> goal along the backward links
+    if (meeting >= 0) {
+        for (int idx = context.parent(cells + meeting); idx != -1;
+             idx = context.parent(cells + idx)) {
+            path.push_back({map.paddedRow(idx), map.paddedCol(idx)});
+        }
+    }
+    return path;
+}
+
+namespace {
+
+// Integer Dijkstra frontier: keys are the costs themselves
+struct BucketFrontier {
+    BucketOpenList& list;
+    bool empty() const { return list.empty(); }
+    void push(double g, int cell) {
+        list.push(static_cast<uint32_t>(g), PackedNode{static_cast<uint32_t>(cell),
+                                                       static_cast<uint32_t>(g)});
+    }
+    void pop(double& g, int& cell) {
+        PackedNode node = list.pop();
+        g = node.gCost;
+        cell = static_cast<int>(node.cell);
+    }
+};
+
+// General Dijkstra frontier: the A* heap with a zero heuristic
+struct HeapFrontier {
+    const Map& map;
+    std::vector<SearchContext::Node>& heap;
+    bool empty() const { return heap.empty(); }
+    void push(double g, int cell) {
+        heap.push_back(SearchContext::Node{map.paddedRow(cell), map.paddedCol(cell), g, 0.0});
+        std::push_heap(heap.begin(), heap.end(), SearchContext::NodeComparator());
+    }
+    void pop(double& g, int& cell) {
+        std::pop_heap(heap.begin(), heap.end(), SearchContext::NodeComparator());
+        g = heap.back().gCost;
+        cell = map.paddedIndex(heap.back().row, heap.back().col);
+        heap.pop_back();
+    }
+};
+
+// Dijkstra from origin until the remaining marked cells are all settled.
+// Backward searches charge each step the cost of the cell being expanded,
+// which is the cell entered when walking the step forward.
+template <class Frontier>
+void settleMarked(const Map& map, SearchContext& context, Frontier frontier,
+                  int origin, size_t remaining, bool reverse, bool diagonal)
+{
+    const double SQRT2 = 1.4142135623730951;
+    const int stride = map.getStride();
+    const int offsets[8] = {1, stride, -1, -stride,
+                            stride + 1, stride - 1, -stride + 1, -stride - 1};
+    const int offsetCount = diagonal ? 8 : 4;
+
+    context.update(origin, 0.0, -1);
+    frontier.push(0.0, origin);
+    while (remaining > 0 && !frontier.empty()) {
+        double g;
+        int cell;
+        frontier.pop(g, cell);
+        if (g > context.gCost(cell)) {
+            continue;  // Superseded entry
+        }
+        if (context.isMarked(cell)) {
+            context.unmark(cell);
+            if (--remaining == 0) {
+                break;
+            }
+        }
+        for (int d = 0; d < offsetCount; ++d) {
+            int next = cell + offsets[d];
+            if (!map.passable(next)) {
+                continue;
+            }
+            double stepLength = 1.0;
+            if (d >= 4) {
+                int dr = offsets[d] > 0 ? stride : -stride;
+                if (!map.passable(cell + dr) || !map.passable(cell + offsets[d] - dr)) {
+                    continue;
+                }
+                stepLength = SQRT2;
+            }
+            double newCost = g + stepLength * map.stepCost(reverse ? cell : next);
+            if (newCost < context.gCost(next)) {
+                context.update(next, newCost, cell);
+                frontier.push(newCost, next);
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Costs between one origin and many cells from a single search.
+ * 
+ * Only passable cells in the origin's connected area are waited for, so a
+ * search never runs on looking for cells it cannot reach. Blocked cells
+ * are unreachable (except from themselves).
+ * 
+ * @param map        Reference to the Map object.
+ * @param context    Scratch buffers; its marks flag the cells still unsettled.
+ * @param originRow  Row index of the origin.
+ * @param originCol  Column index of the origin.
+ * @param cells      Cells to measure.
+ * @param out        Receives one cost per cell.
+ * @param reverse    True for costs toward the origin.
+ * @param diagonal   Allow 8-way moves.
+ */
+void Pathfinding::distancesFrom(const Map& map,
+                                SearchContext& context,
+                                int originRow, int originCol,
+                                const std::vector<std::pair<int, int>>& cells,
+                                double* out,
+                                bool reverse,
+                                bool diagonal)
+{
+    std::fill(out, out + cells.size(), UNREACHABLE_DISTANCE);
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < map.getHeight() && c >= 0 && c < map.getWidth();
+    };
+    if (!inBounds(originRow, originCol)) {
+        return;
+    }
+
+    const int origin = map.paddedIndex(originRow, originCol);
+    const uint32_t component = map.componentOf(origin);
+    context.reset(map.getPaddedCellCount());
+    size_t remaining = 0;
+    for (const auto& cell : cells) {
+        if (!inBounds(cell.first, cell.second)) {
+            continue;
+        }
+        int idx = map.paddedIndex(cell.first, cell.second);
+        if (idx != origin && component != ConnectivityIndex::NONE &&
+            map.componentOf(idx) == component && !context.isMarked(idx)) {
+            context.mark(idx);
+            ++remaining;
+        }
+    }
+
+    if (remaining > 0) {
+        if (!diagonal && map.hasIntegerCosts() &&
+            double(map.getPaddedCellCount()) * map.getMaxStepCost() < 4.0e9) {
+            settleMarked(map, context, BucketFrontier{context.packedOpenList<BucketOpenList>()},
+                         origin, remaining, reverse, diagonal);
+        } else {
+            settleMarked(map, context, HeapFrontier{map, context.openList()},
+                         origin, remaining, reverse, diagonal);
+        }
+    }
+
+    for (size_t j = 0; j < cells.size(); ++j) {
+        const auto& cell = cells[j];
+        if (!inBounds(cell.first, cell.second)) {
+            continue;
+        }
+        int idx = map.paddedIndex(cell.first, cell.second);
+        if (idx == origin) {
+            out[j] = 0.0;
+        } else if (component != ConnectivityIndex::NONE && map.componentOf(idx) == component) {
+            out[j] = context.gCost(idx);
+        }
+    }
+}
+
+/**
+ * @brief Shortest path costs between every source and every target.
+ * 
+ * Searches start from whichever set is smaller; backward searches fill the
+ * matrix column by column.
+ * 
+ * @return Row-major sources x targets matrix.
+ */
+std::vector<double> Pathfinding::distanceMatrix(const Map& map,
+                                                SearchContext& context,
+                                                const std::vector<std::pair<int, int>>& sources,
+                                                const std::vector<std::pair<int, int>>& targets,
+                                                bool diagonal)
+{
+    const size_t targetCount = targets.size();
+    std::vector<double> matrix(sources.size() * targetCount, UNREACHABLE_DISTANCE);
+    if (sources.size() <= targetCount) {
+        for (size_t i = 0; i < sources.size(); ++i) {
+            distancesFrom(map, context, sources[i].first, sources[i].second, targets,
+                          matrix.data() + i * targetCount, false, diagonal);
+        }
+        return matrix;
+    }
+
+    std::vector<double> column(sources.size());
+    for (size_t j = 0; j < targetCount; ++j) {
+        distancesFrom(map, context, targets[j].first, targets[j].second, sources,
+                      column.data(), true, diagonal);
+        for (size_t i = 0; i < sources.size(); ++i) {
+            matrix[i * targetCount + j] = column[i];
+        }
+    }
+    return matrix;
+}
+
+namespace {
+
+// (cell, time) key of a space-time state
+uint64_t spaceTimeKey(int cell, int time)
+{
+    return (uint64_t(uint32_t(time)) << 32) | uint32_t(cell);
+}
+
+// Key of a move between two padded cells starting at time
+uint64_t moveKey(int from, int to, int time)
+{
+    uint64_t key = spaceTimeKey(from, time);
+    return key ^ (uint64_t(uint32_t(to)) * 0x9E3779B97F4A7C15ull);
+}
+
+} // namespace
+
+/**
+ * @brief A* over (cell, time) with waits, time constraints and a focal list.
+ *
+ * @param map        Reference to the Map object.
+ * @param query      Endpoints, constraints and focal settings.
+ * @param lowerBound If given, receives the smallest open f at termination.
+ * @return           Cells for times 0..T; empty if no path is found.
+ */
+std::vector<std::pair<int,int>> Pathfinding::spaceTimeAStar(const Map& map,
+                                                             const SpaceTimeQuery& query,
+                                                             int* lowerBound)
+{
+    std::vector<std::pair<int, int>> path;
+    int width  = map.getWidth();
+    int height = map.getHeight();
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < height && c >= 0 && c < width;
+    };
+    if (!inBounds(query.startRow, query.startCol) || !inBounds(query.goalRow, query.goalCol)) {
+        return path;
+    }
+
+    const int stride = map.getStride();
+    const int moves[5] = {0, 1, stride, -1, -stride};  // Wait first
+    const int goal = map.paddedIndex(query.goalRow, query.goalCol);
+
+    // Index the constraints; the goal may only be final after its last one
+    std::unordered_set<uint64_t> vertexBans, moveBans;
+    int goalFreeFrom = 0;
+    int lastConstraint = 0;
+    for (const TimeConstraint& c : query.constraints) {
+        if (!inBounds(c.row, c.col)) {
+            continue;
+        }
+        int cell = map.paddedIndex(c.row, c.col);
+        lastConstraint = std::max(lastConstraint, c.time);
+        if (c.toRow < 0) {
+            vertexBans.insert(spaceTimeKey(cell, c.time));
+            if (cell == goal) {
+                goalFreeFrom = std::max(goalFreeFrom, c.time + 1);
+            }
+        } else if (inBounds(c.toRow, c.toCol)) {
+            moveBans.insert(moveKey(cell, map.paddedIndex(c.toRow, c.toCol), c.time));
+        }
+    }
+    // Past every constraint, waiting never helps, so this bounds the horizon
+    const int maxTime = lastConstraint + width * height;
+
+    struct StateNode {
+        int cell, time, f, conflicts, parent;
+    };
+    std::vector<StateNode> nodes;
+    // Open list by (f, deeper first, id); focal list by (conflicts, f, deeper first, id)
+    std::set<std::tuple<int, int, int>> open;
+    std::set<std::tuple<int, int, int, int>> focal;
+    std::unordered_set<uint64_t> generated;
+
+    auto h = [&](int cell) {
+        return static_cast<int>(heuristic(map.paddedRow(cell), map.paddedCol(cell),
+                                          query.goalRow, query.goalCol));
+    };
+    auto focalBound = [&](int fMin) {
+        return static_cast<int>(std::floor(fMin * std::max(1.0, query.focalWeight) + 1e-9));
+    };
+    auto push = [&](int cell, int time, int conflicts, int parent, int fMin) {
+        int id = static_cast<int>(nodes.size());
+        int f = time + h(cell);
+        nodes.push_back({cell, time, f, conflicts, parent});
+        open.insert({f, -time, id});
+        if (f <= focalBound(fMin)) {
+            focal.insert({conflicts, f, -time, id});
+        }
+    };
+
+    int start = map.paddedIndex(query.startRow, query.startCol);
+    if (vertexBans.count(spaceTimeKey(start, 0))) {
+        return path;
+    }
+    generated.insert(spaceTimeKey(start, 0));
+    int fMin = h(start);
+    push(start, 0, 0, -1, fMin);
+
+    int endNode = -1;
+    size_t expansions = 0;
+    while (!focal.empty() && expansions < query.maxExpansions) {
+        int id = std::get<3>(*focal.begin());
+        focal.erase(focal.begin());
+        StateNode node = nodes[id];
+        open.erase({node.f, -node.time, id});
+        ++expansions;
+
+        if (node.cell == goal && node.time >= goalFreeFrom) {
+            endNode = id;
+            break;
+        }
+
+        int nextTime = node.time + 1;
+        if (nextTime <= maxTime) {
+            for (int move : moves) {
+                int next = node.cell + move;
+                if (!map.passable(next) ||
+                    vertexBans.count(spaceTimeKey(next, nextTime)) ||
+                    (move != 0 && moveBans.count(moveKey(node.cell, next, node.time))) ||
+                    !generated.insert(spaceTimeKey(next, nextTime)).second) {
+                    continue;
+                }
+                int conflicts = node.conflicts;
+                if (query.conflictCount) {
+                    conflicts += query.conflictCount(map.paddedRow(next), map.paddedCol(next),
+                                                     map.paddedRow(node.cell), map.paddedCol(node.cell),
+                                                     nextTime);
+                }
+                push(next, nextTime, conflicts, id, fMin);
+            }
+        }
+
+        // The best f rose: admit the open nodes now inside the focal bound
+        if (!open.empty() && std::get<0>(*open.begin()) > fMin) {
+            int oldBound = focalBound(fMin);
+            fMin = std::get<0>(*open.begin());
+            int newBound = focalBound(fMin);
+            for (auto it = open.lower_bound({oldBound + 1, std::numeric_limits<int>::min(), 0});
+                 it != open.end() && std::get<0>(*it) <= newBound; ++it) {
+                const StateNode& n = nodes[std::get<2>(*it)];
+                focal.insert({n.conflicts, n.f, -n.time, std::get<2>(*it)});
+            }
+        }
+    }
+
+    if (lowerBound) {
+        *lowerBound = endNode >= 0 ? std::min(fMin, nodes[endNode].f) : fMin;
+    }
+    if (endNode < 0) {
+        return path;
+    }
+    for (int n = endNode; n >= 0; n = nodes[n].parent) {
+        path.push_back({map.paddedRow(nodes[n].cell), map.paddedCol(nodes[n].cell)});
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
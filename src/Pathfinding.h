@@ -13,9 +13,92 @@
  ******************************************************************************/
 
 #include "Map.h"
+#include "SearchContext.h"
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <vector>
 #include <utility>
 
+class LandmarkTable;
+
+/**
+ * @struct SearchOptions
+ * @brief Per-query trade-offs of Pathfinding::aStar.
+ */
+struct SearchOptions {
+    /// Heuristic weight epsilon >= 1 (f = g + epsilon * h). Paths are at most
+    /// epsilon times longer than optimal; values around 1.1-2 expand far
+    /// fewer nodes on open maps
+    double weight = 1.0;
+
+    /// Search from both ends and stop when the frontiers prove the best
+    /// meeting point; usually fewer expansions around dead ends
+    bool bidirectional = false;
+
+    /// Maximum number of node expansions; 0 = unlimited
+    size_t maxExpansions = 0;
+
+    /// When the budget runs out, return the path to the expanded node
+    /// closest to the goal (by heuristic) instead of an empty path
+    bool partialOnBudget = true;
+
+    /// Optional ALT tables; when current for the map, the heuristic is the
+    /// larger of Manhattan and the landmark bound (still admissible).
+    /// Ignored for diagonal searches, whose steps the tables do not model
+    const LandmarkTable* landmarks = nullptr;
+
+    /// Allow 8-way moves. A diagonal step costs sqrt(2) times the terrain
+    /// cost of the cell entered and may not cut a blocked corner; the
+    /// heuristic switches from Manhattan to octile distance
+    bool diagonal = false;
+};
+
+/**
+ * @struct SearchStats
+ * @brief Optional outcome details of Pathfinding::aStar.
+ */
+struct SearchStats {
+    size_t expansions = 0;    ///< Nodes expanded (stale entries excluded)
+    size_t pushes = 0;        ///< Open-list pushes, including the start
+    size_t peakOpenSize = 0;  ///< Largest open list during the search
+    bool partial = false;     ///< True if the path stops short of the goal
+};
+
+/**
+ * @struct TimeConstraint
+ * @brief Forbids an agent from being somewhere at a time step.
+ *
+ * A vertex constraint (toRow < 0) forbids standing on (row, col) at time.
+ * An edge constraint forbids moving from (row, col) to (toRow, toCol)
+ * between time and time + 1.
+ */
+struct TimeConstraint {
+    int row, col;
+    int time;
+    int toRow = -1, toCol = -1;
+};
+
+/**
+ * @struct SpaceTimeQuery
+ * @brief Input of Pathfinding::spaceTimeAStar.
+ */
+struct SpaceTimeQuery {
+    int startRow = 0, startCol = 0;
+    int goalRow = 0, goalCol = 0;
+    std::vector<TimeConstraint> constraints;  ///< Must all be respected
+
+    /// Focal weight (>= 1): any path within this factor of optimal may be
+    /// chosen, preferring those with a low conflictCount
+    double focalWeight = 1.0;
+
+    /// Optional secondary cost of stepping from (prevRow, prevCol) onto
+    /// (row, col) arriving at time, e.g. conflicts with other agents
+    std::function<int(int row, int col, int prevRow, int prevCol, int time)> conflictCount;
+
+    size_t maxExpansions = 200000;  ///< Search effort limit
+};
+
 /**
  * @class Pathfinding
  *
@@ -40,7 +123,157 @@ public:
                                                   int goalRow,
                                                   int goalCol);
 
-private:
+    /**
+     * @brief Run the A* algorithm using caller-owned scratch buffers.
+     *
+     * Reusing the same context across calls avoids per-search allocations.
+     * The context must not be shared between threads.
+     *
+     * @param map       Reference to the Map object.
+     * @param context   Scratch buffers reused between searches.
+     * @param startRow  Row index of the start cell.
+     * @param startCol  Column index of the start cell.
+     * @param goalRow   Row index of the goal cell.
+     * @param goalCol   Column index of the goal cell.
+     * @return          A vector of (row, column) pairs representing the path
+     *                  from start to goal. Empty if no path is found.
+     */
+    static std::vector<std::pair<int, int>> aStar(const Map& map,
+                                                  SearchContext& context,
+                                                  int startRow,
+                                                  int startCol,
+                                                  int goalRow,
+                                                  int goalCol);
+
+    /**
+     * @brief Run A* with per-query options (weighting, bidirectional search,
+     *        expansion budget).
+     *
+     * Each step costs the terrain cost of the cell entered (see
+     * Map::setTerrainCost), times sqrt(2) for diagonal steps.
+     *
+     * With default options this is identical to the overload above. Goals
+     * outside the start's connected area (see Map::areConnected) return an
+     * empty path at once, without a search.
+     *
+     * @param map       Reference to the Map object.
+     * @param context   Scratch buffers reused between searches.
+     * @param startRow  Row index of the start cell.
+     * @param startCol  Column index of the start cell.
+     * @param goalRow   Row index of the goal cell.
+     * @param goalCol   Column index of the goal cell.
+     * @param options   Search trade-offs; see SearchOptions.
+     * @param stats     If given, receives the expansion and push counts,
+     *                  the peak open-list size and whether the path is
+     *                  partial.
+     * @return          A vector of (row, column) pairs from the start. Ends
+     *                  at the goal unless the budget ran out (partial path).
+     *                  Empty if no path is found.
+     */
+    static std::vector<std::pair<int, int>> aStar(const Map& map,
+                                                  SearchContext& context,
+                                                  int startRow,
+                                                  int startCol,
+                                                  int goalRow,
+                                                  int goalCol,
+                                                  const SearchOptions& options,
+                                                  SearchStats* stats = nullptr);
+
+    /**
+     * @brief Run A* on integer costs, with the open list chosen at compile
+     *        time: BucketOpenList (bucket queue, O(1) push and pop) or
+     *        PackedHeapOpenList (binary heap). See OpenList.h.
+     *
+     * Queries that do not qualify (see usesIntegerCosts()) run the general
+     * search instead. The overload above already uses BucketOpenList for
+     * every qualifying query; this one exists to pin the list type.
+     */
+    template <class OpenList>
+    static std::vector<std::pair<int, int>> aStar(const Map& map,
+                                                  SearchContext& context,
+                                                  int startRow,
+                                                  int startCol,
+                                                  int goalRow,
+                                                  int goalCol,
+                                                  const SearchOptions& options,
+                                                  SearchStats* stats = nullptr);
+
+    /**
+     * @brief Checks whether a query can run on exact integer costs.
+     *
+     * True for 4-way, unidirectional searches with a whole-number weight
+     * when every terrain cost of the map is a whole number (the default
+     * unit costs included).
+     */
+    static bool usesIntegerCosts(const Map& map, const SearchOptions& options);
+
+    /// Entry of distanceMatrix() / distancesFrom() for unreachable pairs
+    static constexpr double UNREACHABLE_DISTANCE = std::numeric_limits<double>::infinity();
+
+    /**
+     * @brief Shortest path costs between every source and every target.
+     *
+     * Runs one Dijkstra search per point of the smaller set (backward
+     * searches if that is the targets), each stopping as soon as all of
+     * its reachable counterparts are settled. Costs follow aStar(): the
+     * terrain cost of each cell entered, sqrt(2) times that for diagonal
+     * steps. Unit and whole-number costs use a bucket queue.
+     *
+     * @param map      Reference to the Map object.
+     * @param context  Scratch buffers reused between the searches.
+     * @param sources  Source cells.
+     * @param targets  Target cells.
+     * @param diagonal Allow 8-way moves (no corner cutting).
+     * @return         Row-major sources x targets matrix; entry
+     *                 [i * targets.size() + j] is the cost from sources[i]
+     *                 to targets[j], or UNREACHABLE_DISTANCE.
+     */
+    static std::vector<double> distanceMatrix(const Map& map,
+                                              SearchContext& context,
+                                              const std::vector<std::pair<int, int>>& sources,
+                                              const std::vector<std::pair<int, int>>& targets,
+                                              bool diagonal = false);
+
+    /**
+     * @brief One row (or column) of distanceMatrix(): costs between one
+     *        origin and many cells, from a single early-terminating search.
+     *
+     * Lets callers spread the searches of a matrix over threads, one
+     * SearchContext per thread.
+     *
+     * @param out      Receives cells.size() costs (UNREACHABLE_DISTANCE
+     *                 where no path exists).
+     * @param reverse  False for costs from the origin to each cell, true
+     *                 for costs from each cell to the origin.
+     */
+    static void distancesFrom(const Map& map,
+                              SearchContext& context,
+                              int originRow, int originCol,
+                              const std::vector<std::pair<int, int>>& cells,
+                              double* out,
+                              bool reverse = false,
+                              bool diagonal = false);
+
+    /**
+     * @brief A* over (cell, time) with waits and time constraints.
+     *
+     * Moves are 4-connected or a wait, each costing one time step. The path
+     * ends once the agent reaches the goal and no later vertex constraint
+     * forbids staying there. With focalWeight > 1 this is the focal search
+     * of ECBS: among open nodes within focalWeight of the best f, the one
+     * with the fewest accumulated conflicts is expanded first.
+     *
+     * @param map        Reference to the Map object.
+     * @param query      Endpoints, constraints and focal settings.
+     * @param lowerBound If given, receives a lower bound on the cost of any
+     *                   valid path (the smallest open f at termination).
+     * @return           Cells for times 0..T (repeated cells are waits).
+     *                   Empty if no path is found within the budget.
+     */
+    static std::vector<std::pair<int, int>> spaceTimeAStar(const Map& map,
+                                                           const SpaceTimeQuery& query,
+                                                           int* lowerBound = nullptr);
+
     /**
      * @brief Heuristic function (e.g., Manhattan distance) used by A*.
      * 
@@ -51,4 +284,42 @@ private:
      * @return   The estimated cost (distance) between the two cells.
      */
     static double heuristic(int r1, int c1, int r2, int c2);
+
+    /**
+     * @brief Octile distance (straight steps 1, diagonal steps sqrt(2)),
+     *        the heuristic of diagonal searches.
+     */
+    static double octileHeuristic(int r1, int c1, int r2, int c2);
+
+    /**
+     * @brief Bounds check plus connected-area rejection shared by the
+     *        aStar() variants and JumpPointSearch.
+     *
+     * @return False if an endpoint is out of bounds or the goal cannot be
+     *         reached from the start; O(1).
+     */
+    static bool acceptEndpoints(const Map& map, int startRow, int startCol,
+                                int goalRow, int goalCol);
+
+private:
+    /**
+     * @brief Integer-cost part of aStar(); endpoints are already validated.
+     */
+    template <class OpenList>
+    static std::vector<std::pair<int, int>> integerAStar(const Map& map,
+                                                         SearchContext& context,
+                                                         int startRow, int startCol,
+                                                         int goalRow, int goalCol,
+                                                         const SearchOptions& options,
+                                                         SearchStats* stats);
+
+    /**
+     * @brief Bidirectional part of aStar(); endpoints are already validated.
+     */
+    static std::vector<std::pair<int, int>> bidirectionalAStar(const Map& map,
+                                                               SearchContext& context,
+                                                               int startRow, int startCol,
+                                                               int goalRow, int goalCol,
+                                                               const SearchOptions& options,
+                                                               SearchStats* stats);
 };
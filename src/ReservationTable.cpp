@@ -0,0 +1,108 @@
+/******************************************************************************
+ * File:    ReservationTable.cpp
+ *
+ * Overview:
+ *   Implementation of the ReservationTable class.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "ReservationTable.h"
+
+namespace {
+
+const size_t INITIAL_SLOTS = 1024;  // Power of two
+
+// splitmix64 finalizer; spreads neighboring cells and times over the table
+size_t mix(uint64_t key)
+{
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBull;
+    key ^= key >> 31;
+    return static_cast<size_t>(key);
+}
+
+} // namespace
+
+/**
+ * @brief Removes every reservation, keeping the allocated slots.
+ */
+void ReservationTable::clear()
+{
+    if (count > 0) {
+        for (Slot& slot : slots) {
+            slot.key = EMPTY_KEY;
+        }
+        count = 0;
+    }
+}
+
+/**
+ * @brief Linear probe for key.
+ *
+ * @return Index of the slot holding key, or of the empty slot ending the probe.
+ */
+size_t ReservationTable::find(uint64_t key) const
+{
+    size_t mask = slots.size() - 1;
+    size_t i = mix(key) & mask;
+    while (slots[i].key != EMPTY_KEY && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * @brief Doubles the slot count and reinserts every entry.
+ */
+void ReservationTable::grow()
+{
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(old.empty() ? INITIAL_SLOTS : old.size() * 2, Slot{EMPTY_KEY, NONE});
+    for (const Slot& slot : old) {
+        if (slot.key != EMPTY_KEY) {
+            slots[find(slot.key)] = slot;
+        }
+    }
+}
+
+/**
+ * @brief Reserves a cell at a time step for an agent.
+ *
+ * @param cell  Cell id (any consistent indexing, e.g. Map::paddedIndex).
+ * @param time  Time step.
+ * @param agent Agent id.
+ * @return False if another agent already holds (cell, time).
+ */
+bool ReservationTable::reserve(int cell, int time, int32_t agent)
+{
+    // Keep the load factor at or below 1/2
+    if ((count + 1) * 2 > slots.size()) {
+        grow();
+    }
+    uint64_t key = makeKey(cell, time);
+    Slot& slot = slots[find(key)];
+    if (slot.key == key) {
+        return slot.agent == agent;
+    }
+    slot.key = key;
+    slot.agent = agent;
+    ++count;
+    return true;
+}
+
+/**
+ * @return The agent holding (cell, time), or NONE.
+ */
+int32_t ReservationTable::owner(int cell, int time) const
+{
+    if (count == 0) {
+        return NONE;
+    }
+    const Slot& slot = slots[find(makeKey(cell, time))];
+    return slot.key == EMPTY_KEY ? NONE : slot.agent;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+/******************************************************************************
+ * File:    ReservationTable.h
+ *
+ * Overview:
+ *   This header declares the ReservationTable class, the space-time
+ *   reservation table used by cooperative pathfinding. Each entry says that
+ *   one agent occupies one cell at one time step.
+ *
+ *   Entries live in a single open-addressing hash table (linear probing,
+ *   16 bytes per slot, at most half full), so thousands of agents with a
+ *   window of a few dozen steps fit in a few MB and lookups touch one or
+ *   two cache lines.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ReservationTable
+ *
+ * @brief Hashed (cell, time) -> agent map.
+ */
+class ReservationTable {
+public:
+    /// Owner of a free (cell, time) pair
+    static constexpr int32_t NONE = -1;
+
+    /**
+     * @brief Removes every reservation, keeping the allocated slots.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves a cell at a time step for an agent.
+     *
+     * @return False if another agent already holds it.
+     */
+    bool reserve(int cell, int time, int32_t agent);
+
+    /**
+     * @return The agent holding (cell, time), or NONE.
+     */
+    int32_t owner(int cell, int time) const;
+
+    /**
+     * @return True if (cell, time) is free or already held by agent.
+     */
+    bool isFree(int cell, int time, int32_t agent) const {
+        int32_t holder = owner(cell, time);
+        return holder == NONE || holder == agent;
+    }
+
+    /**
+     * @return Number of reservations.
+     */
+    size_t size() const { return count; }
+
+private:
+    struct Slot {
+        uint64_t key;    // (time << 32) | cell, or EMPTY_KEY
+        int32_t agent;
+    };
+
+    static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);
+
+    static uint64_t makeKey(int cell, int time) {
+        return (uint64_t(uint32_t(time)) << 32) | uint32_t(cell);
+    }
+
+    // Slot where key is stored, or the empty slot where it would go
+    size_t find(uint64_t key) const;
+    void grow();
+
+    std::vector<Slot> slots;
+    size_t count = 0;
+};
@@ -0,0 +1,243 @@
+/******************************************************************************
+ * File:    ResumableSearch.cpp
+ *
+ * Overview:
+ *   Implementation of the ResumableSearch class. The main loop mirrors the
+ *   general search of Pathfinding::aStar; its locals are members here so a
+ *   slice can stop between any two expansions.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "ResumableSearch.h"
+#include "LandmarkTable.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const double SQRT2 = 1.4142135623730951;
+
+// Expansions between two reads of the clock
+const size_t CLOCK_INTERVAL = 64;
+}
+
+/**
+ * @brief Begins a new query.
+ */
+void ResumableSearch::start(const Map& searchMap, int sr, int sc, int gr, int gc,
+                            const SearchOptions& searchOptions)
+{
+    map = &searchMap;
+    options = searchOptions;
+    startRow = sr;
+    startCol = sc;
+    goalRow = gr;
+    goalCol = gc;
+    searchTime = Clock::duration();
+    restart();
+}
+
+/**
+ * @brief Resets the frontier to the start node for the map's current version.
+ *
+ * Endpoints outside the map or in different connected areas end the query
+ * at once with NoPath.
+ */
+void ResumableSearch::restart()
+{
+    mapVersion = map->getVersion();
+    expansions = 0;
+    pushes = 0;
+    peakOpenSize = 0;
+    closestIndex = -1;
+    closestH = std::numeric_limits<double>::infinity();
+    landmarks = options.landmarks && !options.diagonal && options.landmarks->isCurrent(*map)
+                    ? options.landmarks : nullptr;
+
+    auto inBounds = [&](int r, int c) {
+        return r >= 0 && r < map->getHeight() && c >= 0 && c < map->getWidth();
+    };
+    if (!inBounds(startRow, startCol) || !inBounds(goalRow, goalCol)) {
+        status = Status::NoPath;
+        return;
+    }
+    const int startIndex = map->paddedIndex(startRow, startCol);
+    const int goalIndex = map->paddedIndex(goalRow, goalCol);
+    const uint32_t startComponent = map->componentOf(startIndex);
+    const uint32_t goalComponent = map->componentOf(goalIndex);
+    if (startIndex != goalIndex &&
+        (goalComponent == ConnectivityIndex::NONE ||
+         (startComponent != ConnectivityIndex::NONE && startComponent != goalComponent))) {
+        status = Status::NoPath;
+        return;
+    }
+
+    context.reset(map->getPaddedCellCount());
+    context.update(startIndex, 0.0, -1);
+    context.openList().push_back(SearchContext::Node{startRow, startCol, 0.0, estimate(startIndex)});
+    pushes = 1;
+    peakOpenSize = 1;
+    status = Status::Running;
+}
+
+/**
+ * @brief Weighted, terrain-scaled estimate from a padded cell to the goal.
+ */
+double ResumableSearch::estimate(int idx) const
+{
+    int r = map->paddedRow(idx), c = map->paddedCol(idx);
+    double h = options.diagonal ? Pathfinding::octileHeuristic(r, c, goalRow, goalCol)
+                                : Pathfinding::heuristic(r, c, goalRow, goalCol);
+    if (landmarks) {
+        h = std::max(h, static_cast<double>(
+                            landmarks->lowerBound(idx, map->paddedIndex(goalRow, goalCol))));
+    }
+    return std::max(1.0, options.weight) * map->getMinStepCost() * h;
+}
+
+/**
+ * @brief Expands nodes until the search ends or a budget runs out.
+ *
+ * @param maxExpansions Expansions allowed in this slice; 0 = no limit.
+ * @param deadline      Time at which to suspend.
+ * @return              The status after the slice.
+ */
+ResumableSearch::Status ResumableSearch::resume(size_t maxExpansions, Clock::time_point deadline)
+{
+    if (status == Status::Idle) {
+        return status;
+    }
+    if (map->getVersion() != mapVersion) {
+        restart();  // Costs or passability changed under the frontier
+    }
+    if (status != Status::Running) {
+        return status;
+    }
+    const Clock::time_point sliceStart =
+        Statistics::COUNTERS_ENABLED ? Clock::now() : Clock::time_point();
+
+    using Node = SearchContext::Node;
+    std::vector<Node>& openSet = context.openList();
+    SearchContext::NodeComparator compare;
+    const int stride = map->getStride();
+    const int goalIndex = map->paddedIndex(goalRow, goalCol);
+    const int offsets[8] = {1, stride, -1, -stride,
+                            stride + 1, stride - 1, -stride + 1, -stride - 1};
+    const int offsetCount = options.diagonal ? 8 : 4;
+    const bool timed = deadline != Clock::time_point::max();
+
+    size_t sliceExpansions = 0;
+    while (!openSet.empty()) {
+        std::pop_heap(openSet.begin(), openSet.end(), compare);
+        Node current = openSet.back();
+        openSet.pop_back();
+
+        int currentIndex = map->paddedIndex(current.row, current.col);
+        if (current.gCost > context.gCost(currentIndex)) {
+            continue;  // Superseded by a cheaper push
+        }
+        if (currentIndex == goalIndex) {
+            return finish(Status::Found, sliceStart);
+        }
+
+        // Out of budget: put the node back and suspend
+        bool outOfBudget = maxExpansions > 0 && sliceExpansions >= maxExpansions;
+        if (!outOfBudget && timed && sliceExpansions > 0 &&
+            sliceExpansions % CLOCK_INTERVAL == 0) {
+            outOfBudget = Clock::now() >= deadline;
+        }
+        if (outOfBudget) {
+            openSet.push_back(current);
+            std::push_heap(openSet.begin(), openSet.end(), compare);
+            if (Statistics::COUNTERS_ENABLED) {
+                searchTime += Clock::now() - sliceStart;
+            }
+            return status;
+        }
+        ++sliceExpansions;
+        ++expansions;
+        if (current.hCost < closestH) {
+            closestH = current.hCost;
+            closestIndex = currentIndex;
+        }
+
+        for (int d = 0; d < offsetCount; ++d) {
+            int neighborIndex = currentIndex + offsets[d];
+            if (!map->passable(neighborIndex)) {
+                continue;
+            }
+            double stepLength = 1.0;
+            if (d >= 4) {
+                int dr = offsets[d] > 0 ? stride : -stride;
+                if (!map->passable(currentIndex + dr) ||
+                    !map->passable(currentIndex + offsets[d] - dr)) {
+                    continue;
+                }
+                stepLength = SQRT2;
+            }
+            double newGCost = current.gCost + stepLength * map->stepCost(neighborIndex);
+            if (newGCost < context.gCost(neighborIndex)) {
+                context.update(neighborIndex, newGCost, currentIndex);
+                openSet.push_back(Node{map->paddedRow(neighborIndex), map->paddedCol(neighborIndex),
+                                       newGCost, estimate(neighborIndex)});
+                std::push_heap(openSet.begin(), openSet.end(), compare);
+                ++pushes;
+                peakOpenSize = std::max(peakOpenSize, openSet.size());
+            }
+        }
+    }
+    return finish(Status::NoPath, sliceStart);
+}
+
+/**
+ * @brief Ends the query with the given status.
+ *
+ * With RTS_WITH_STATS the query is added to the Statistics counters, its
+ * time being the sum of its slices.
+ */
+ResumableSearch::Status ResumableSearch::finish(Status result, Clock::time_point sliceStart)
+{
+    status = result;
+    if (Statistics::COUNTERS_ENABLED) {
+        searchTime += Clock::now() - sliceStart;
+        Statistics::recordSearch(getStats(), static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(searchTime).count()));
+    }
+    return status;
+}
+
+/**
+ * @return Expansions, pushes and peak open-list size of the query.
+ */
+SearchStats ResumableSearch::getStats() const
+{
+    SearchStats stats;
+    stats.expansions = expansions;
+    stats.pushes = pushes;
+    stats.peakOpenSize = peakOpenSize;
+    return stats;
+}
+
+/**
+ * @brief Path to the goal, or toward it while the search is running.
+ */
+std::vector<std::pair<int, int>> ResumableSearch::path() const
+{
+    std::vector<std::pair<int, int>> cells;
+    int end;
+    if (status == Status::Found) {
+        end = map->paddedIndex(goalRow, goalCol);
+    } else if (status == Status::Running) {
+        end = closestIndex >= 0 ? closestIndex : map->paddedIndex(startRow, startCol);
+    } else {
+        return cells;
+    }
+    for (int idx = end; idx != -1; idx = context.parent(idx)) {
+        cells.push_back({map->paddedRow(idx), map->paddedCol(idx)});
+    }
+    std::reverse(cells.begin(), cells.end());
+    return cells;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+/******************************************************************************
+ * File:    ResumableSearch.h
+ *
+ * Overview:
+ *   This header declares the ResumableSearch class, an A* search that can
+ *   be suspended and resumed, so a frame-driven game can spread expensive
+ *   queries over several ticks.
+ *
+ *   The whole search state (open list, costs, parent links) lives in the
+ *   object's own SearchContext. resume() expands nodes until the goal is
+ *   settled, the frontier runs dry, or its expansion or wall-clock budget
+ *   runs out; the next call continues exactly where it stopped. While the
+ *   search is running, path() offers the route to the expanded node
+ *   closest to the goal, which a unit can follow in the meantime.
+ *
+ *   Costs, movement and heuristics follow Pathfinding::aStar with the same
+ *   SearchOptions (weight, diagonal moves, landmarks and terrain costs).
+ *   If passability or terrain costs change between slices, the search
+ *   restarts on the next resume().
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Map.h"
+#include "Pathfinding.h"
+#include "SearchContext.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ResumableSearch
+ *
+ * @brief Time-sliced A* query between one start and one goal.
+ *
+ * A search owns a full-size SearchContext; keep a few and reuse them via
+ * start() rather than creating one per query.
+ */
+class ResumableSearch {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Status {
+        Idle,     ///< start() was not called yet
+        Running,  ///< Budget ran out; call resume() again
+        Found,    ///< path() leads to the goal
+        NoPath    ///< The goal is unreachable
+    };
+
+    /**
+     * @brief Begins a new query; no node is expanded yet.
+     *
+     * @param map      Map to search; must outlive the search.
+     * @param options  Weight, diagonal moves and landmarks (the budget and
+     *                 bidirectional fields are ignored).
+     */
+    void start(const Map& map, int startRow, int startCol,
+               int goalRow, int goalCol, const SearchOptions& options);
+
+    /**
+     * @brief Expands nodes until the search ends or a budget runs out.
+     *
+     * The clock is read every few dozen expansions, so a slice may overrun
+     * the deadline slightly; it always makes some progress.
+     *
+     * @param maxExpansions Expansions allowed in this slice; 0 = no limit.
+     * @param deadline      Time at which to suspend; Clock::time_point::max()
+     *                      for none.
+     * @return              The status after the slice.
+     */
+    Status resume(size_t maxExpansions, Clock::time_point deadline);
+
+    /**
+     * @return The current status.
+     */
+    Status getStatus() const { return status; }
+
+    /**
+     * @return Start to goal once Found; while Running, start to the expanded
+     *         node closest to the goal (just the start before the first
+     *         slice). Empty if Idle or NoPath.
+     */
+    std::vector<std::pair<int, int>> path() const;
+
+    /**
+     * @return Expansions since the query (or its last restart) began.
+     */
+    size_t getExpansions() const { return expansions; }
+
+    /**
+     * @return Expansions, pushes and peak open-list size since the query
+     *         (or its last restart) began.
+     */
+    SearchStats getStats() const;
+
+    int getStartRow() const { return startRow; }
+    int getStartCol() const { return startCol; }
+    int getGoalRow() const { return goalRow; }
+    int getGoalCol() const { return goalCol; }
+
+private:
+    // Resets the frontier to the start node for the map's current version
+    void restart();
+
+    // Weighted estimate from a padded cell to the goal
+    double estimate(int idx) const;
+
+    // Ends the query; with RTS_WITH_STATS, reports it to Statistics
+    Status finish(Status result, Clock::time_point sliceStart);
+
+    const Map* map = nullptr;
+    SearchContext context;
+    SearchOptions options;
+    const LandmarkTable* landmarks = nullptr;  // options.landmarks if usable
+    int startRow = 0, startCol = 0;
+    int goalRow = 0, goalCol = 0;
+    uint64_t mapVersion = 0;     // Map version the frontier was built for
+    Status status = Status::Idle;
+    size_t expansions = 0;
+    size_t pushes = 0;
+    size_t peakOpenSize = 0;
+    Clock::duration searchTime{};  // Slices so far (RTS_WITH_STATS only)
+    int closestIndex = -1;       // Expanded node with the lowest heuristic
+    double closestH = 0.0;
+};
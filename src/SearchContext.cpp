@@ -0,0 +1,45 @@
+/******************************************************************************
+ * File:    SearchContext.cpp
+ *
+ * Overview:
+ *   Implementation of the SearchContext class. Only reset() lives here; the
+ *   per-cell accessors are inlined in the header because they sit on the
+ *   search inner loop.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "SearchContext.h"
+#include <algorithm>
+
+/**
+ * @brief Prepares the context for a new search over cellCount cells.
+ *
+ * Bumping the generation invalidates every per-cell entry at once. The stamp
+ * array is only cleared when the buffers grow or the generation wraps around.
+ *
+ * @param cellCount Number of cells addressed by the search.
+ */
+void SearchContext::reset(int cellCount)
+{
+    size_t count = static_cast<size_t>(cellCount);
+    if (stamps.size() < count) {
+        stamps.resize(count, 0);
+        marks.resize(count, 0);
+        gCosts.resize(count);
+        parents.resize(count);
+    }
+
+    // Generation 0 is reserved for "never written"
+    if (++generation == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        std::fill(marks.begin(), marks.end(), 0);
+        generation = 1;
+    }
+
+    open.clear();
+    reverseOpen.clear();
+    bucketOpen.clear();
+    packedOpen.clear();
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+/******************************************************************************
+ * File:    SearchContext.h
+ *
+ * Overview:
+ *   This header declares the SearchContext class, which owns the scratch
+ *   buffers used by Pathfinding::aStar (g-costs, parent links and the open
+ *   list). Keeping one context alive between searches avoids reallocating
+ *   width*height arrays on every query.
+ *
+ *   Highlights:
+ *   - Per-cell data is generation-stamped: a cell whose stamp differs from the
+ *     current generation is treated as unvisited, so reset() is O(1).
+ *   - Parent links live in a dense array instead of a hash map.
+ *   - The open list is a plain vector used as a binary heap, so its capacity
+ *     is kept between searches as well. The compact open lists of the
+ *     integer-cost search (see OpenList.h) are kept the same way.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "OpenList.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @class SearchContext
+ *
+ * @brief Reusable per-search state for grid searches.
+ *
+ * A context is not thread-safe; use one context per thread.
+ */
+class SearchContext {
+public:
+    /**
+     * @brief Entry stored in the open list.
+     */
+    struct Node {
+        int row, col;
+        double gCost;  // Cost from the start node to this node
+        double hCost;  // Heuristic estimate from this node to the goal
+
+        // fCost is simply gCost + hCost
+        double fCost() const {
+            return gCost + hCost;
+        }
+    };
+
+    /**
+     * @brief Comparator making the open list a min-heap on fCost.
+     */
+    struct NodeComparator {
+        bool operator()(const Node& a, const Node& b) const {
+            return a.fCost() > b.fCost();
+        }
+    };
+
+    /**
+     * @brief Prepares the context for a new search over cellCount cells.
+     *
+     * Buffers only grow; when they are already large enough this is O(1).
+     *
+     * @param cellCount Number of cells addressed by the search.
+     */
+    void reset(int cellCount);
+
+    /**
+     * @return True if the cell was reached during the current search.
+     */
+    bool isVisited(int idx) const { return stamps[idx] == generation; }
+
+    /**
+     * @return The best known cost to the cell, or infinity if unvisited.
+     */
+    double gCost(int idx) const {
+        return isVisited(idx) ? gCosts[idx]
+                              : std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @return The predecessor of the cell, or -1 if it has none.
+     */
+    int parent(int idx) const {
+        return isVisited(idx) ? parents[idx] : -1;
+    }
+
+    /**
+     * @brief Records a (better) cost and predecessor for a cell.
+     *
+     * @param idx       Cell index.
+     * @param cost      Cost from the start node to the cell.
+     * @param parentIdx Predecessor index, or -1 for the start cell.
+     */
+    void update(int idx, double cost, int parentIdx) {
+        stamps[idx] = generation;
+        gCosts[idx] = cost;
+        parents[idx] = parentIdx;
+    }
+
+    /**
+     * @brief Flags a cell for the current search (e.g. as a target).
+     */
+    void mark(int idx) { marks[idx] = generation; }
+
+    /**
+     * @return True if the cell was flagged with mark() since the last reset().
+     */
+    bool isMarked(int idx) const { return marks[idx] == generation; }
+
+    /**
+     * @brief Clears the flag set by mark().
+     */
+    void unmark(int idx) { marks[idx] = 0; }
+
+    /**
+     * @return The open list storage. It is emptied by reset().
+     */
+    std::vector<Node>& openList() { return open; }
+
+    /**
+     * @return A second open list for bidirectional searches, which keep the
+     *         backward direction's cells after the forward ones (reset with
+     *         twice the cell count). It is emptied by reset().
+     */
+    std::vector<Node>& reverseOpenList() { return reverseOpen; }
+
+    /**
+     * @return The packed open list of the given type (BucketOpenList or
+     *         PackedHeapOpenList). It is emptied by reset().
+     */
+    template <class OpenList>
+    OpenList& packedOpenList();
+
+private:
+    uint32_t generation = 0;       ///< Stamp identifying the current search
+    std::vector<uint32_t> stamps;  ///< Generation in which each cell was last written
+    std::vector<double> gCosts;    ///< Cost from start, valid when stamped
+    std::vector<int> parents;      ///< Predecessor index, valid when stamped
+    std::vector<uint32_t> marks;   ///< Generation in which each cell was marked
+    std::vector<Node> open;        ///< Binary heap of frontier nodes
+    std::vector<Node> reverseOpen; ///< Backward frontier of bidirectional searches
+    BucketOpenList bucketOpen;     ///< Integer-cost frontier, bucket queue
+    PackedHeapOpenList packedOpen; ///< Integer-cost frontier, binary heap
+};
+
+template <>
+inline BucketOpenList& SearchContext::packedOpenList<BucketOpenList>() { return bucketOpen; }
+
+template <>
+inline PackedHeapOpenList& SearchContext::packedOpenList<PackedHeapOpenList>() { return packedOpen; }
@@ -0,0 +1,126 @@
+#pragma once
+
+/******************************************************************************
+ * File:    SimdScan.h
+ *
+ * Overview:
+ *   Helpers that locate the delimiters of a numeric JSON array ("," and "]")
+ *   a block of 32 bytes at a time. delimiterMask() returns one bit per byte
+ *   of the block, so a tokenizer can walk the set bits instead of testing
+ *   every character.
+ *
+ *   The widest instruction set enabled at compile time is used:
+ *   - AVX2  (one 32-byte compare per block, build with -mavx2)
+ *   - SSE2  (two 16-byte compares; always available on x86-64)
+ *   - NEON  (two 16-byte compares on ARM64)
+ *   - a scalar loop otherwise.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RTS_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RTS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace SimdScan {
+
+/// Bytes covered by one delimiterMask() call
+constexpr size_t BLOCK = 32;
+
+/**
+ * @brief Index of the lowest set bit; mask must not be 0.
+ */
+inline int lowestBit(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * @brief Delimiter bits for the bytes [p, p + count), count < BLOCK.
+ */
+inline uint32_t delimiterMaskScalar(const char* p, size_t count)
+{
+    uint32_t mask = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (p[i] == ',' || p[i] == ']') {
+            mask |= uint32_t(1) << i;
+        }
+    }
+    return mask;
+}
+
+#if defined(RTS_SIMD_NEON)
+// 16 comparison bytes (0x00 / 0xFF) -> 16-bit mask
+inline uint32_t neonMask16(uint8x16_t eq)
+{
+    static const uint8_t WEIGHTS[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                        1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(eq, vld1q_u8(WEIGHTS));
+    uint32_t low  = vaddv_u8(vget_low_u8(bits));
+    uint32_t high = vaddv_u8(vget_high_u8(bits));
+    return low | (high << 8);
+}
+#endif
+
+/**
+ * @brief Delimiter bits for the full block [p, p + BLOCK).
+ *
+ * Bit i is set if p[i] is ',' or ']'.
+ */
+inline uint32_t delimiterMask(const char* p)
+{
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')),
+                                  _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']')));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+#elif defined(RTS_SIMD_SSE2)
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i close = _mm_set1_epi8(']');
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    uint32_t loMask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(lo, comma), _mm_cmpeq_epi8(lo, close))));
+    uint32_t hiMask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(hi, comma), _mm_cmpeq_epi8(hi, close))));
+    return loMask | (hiMask << 16);
+#elif defined(RTS_SIMD_NEON)
+    const uint8x16_t comma = vdupq_n_u8(',');
+    const uint8x16_t close = vdupq_n_u8(']');
+    uint8x16_t lo = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t hi = vld1q_u8(reinterpret_cast<const uint8_t*>(p + 16));
+    uint32_t loMask = neonMask16(vorrq_u8(vceqq_u8(lo, comma), vceqq_u8(lo, close)));
+    uint32_t hiMask = neonMask16(vorrq_u8(vceqq_u8(hi, comma), vceqq_u8(hi, close)));
+    return loMask | (hiMask << 16);
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < BLOCK; ++i) {
+        if (p[i] == ',' || p[i] == ']') {
+            mask |= uint32_t(1) << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+} // namespace SimdScan
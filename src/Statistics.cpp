@@ -0,0 +1,255 @@
+/******************************************************************************
+ * File:    Statistics.cpp
+ *
+ * Overview:
+ *   Implementation of the Statistics class. Each thread's counters live in
+ *   a thread_local block registered with a global list, which counters()
+ *   sums; a block leaving with its thread folds into the retired totals.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "Statistics.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+/**
+ * Counters of one thread. Only the owner writes them, so a relaxed load
+ * and store replace a locked read-modify-write; other threads may read
+ * them at any time.
+ */
+struct ThreadCounters {
+    std::atomic<uint64_t> searches{0};
+    std::atomic<uint64_t> expansions{0};
+    std::atomic<uint64_t> pushes{0};
+    std::atomic<uint64_t> peakOpenSize{0};
+    std::atomic<uint64_t> searchNanoseconds{0};
+    std::atomic<uint64_t> maxSearchNanoseconds{0};
+
+    ThreadCounters();
+    ~ThreadCounters();
+};
+
+void add(std::atomic<uint64_t>& counter, uint64_t amount)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void raise(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    if (value > counter.load(std::memory_order_relaxed)) {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+void accumulate(SearchCounters& total, const ThreadCounters& counters)
+{
+    total.searches += counters.searches.load(std::memory_order_relaxed);
+    total.expansions += counters.expansions.load(std::memory_order_relaxed);
+    total.pushes += counters.pushes.load(std::memory_order_relaxed);
+    total.peakOpenSize = std::max<uint64_t>(total.peakOpenSize,
+                                            counters.peakOpenSize.load(std::memory_order_relaxed));
+    total.searchNanoseconds += counters.searchNanoseconds.load(std::memory_order_relaxed);
+    total.maxSearchNanoseconds =
+        std::max<uint64_t>(total.maxSearchNanoseconds,
+                           counters.maxSearchNanoseconds.load(std::memory_order_relaxed));
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadCounters*> live;
+    SearchCounters retired;  // Counters of threads that have exited
+    std::vector<std::pair<std::string, double>> phases;
+};
+
+// Never destroyed, so threads exiting during shutdown can still unregister
+Registry& registry()
+{
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+ThreadCounters::ThreadCounters()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.live.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    accumulate(r.retired, *this);
+    r.live.erase(std::remove(r.live.begin(), r.live.end(), this), r.live.end());
+}
+
+ThreadCounters& localCounters()
+{
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+struct ReportValue {
+    const char* section;
+    const char* name;
+    double value;
+};
+
+} // namespace
+
+/**
+ * @brief Adds one query to the calling thread's counters.
+ */
+void Statistics::recordSearch(const SearchStats& stats, uint64_t nanoseconds)
+{
+    ThreadCounters& counters = localCounters();
+    add(counters.searches, 1);
+    add(counters.expansions, stats.expansions);
+    add(counters.pushes, stats.pushes);
+    raise(counters.peakOpenSize, stats.peakOpenSize);
+    add(counters.searchNanoseconds, nanoseconds);
+    raise(counters.maxSearchNanoseconds, nanoseconds);
+}
+
+/**
+ * @return The counters of all threads, including finished ones.
+ */
+SearchCounters Statistics::counters()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    SearchCounters total = r.retired;
+    for (const ThreadCounters* counters : r.live) {
+        accumulate(total, *counters);
+    }
+    return total;
+}
+
+/**
+ * @brief Records the duration of a phase; repeated phases add up.
+ */
+void Statistics::recordPhase(const std::string& name, double milliseconds)
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& phase : r.phases) {
+        if (phase.first == name) {
+            phase.second += milliseconds;
+            return;
+        }
+    }
+    r.phases.emplace_back(name, milliseconds);
+}
+
+/**
+ * @return Phase names and milliseconds, in first-recorded order.
+ */
+std::vector<std::pair<std::string, double>> Statistics::phases()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.phases;
+}
+
+/**
+ * @brief Clears the counters and phases. Meant for quiet moments: a search
+ *        finishing concurrently may keep part of its counts.
+ */
+void Statistics::reset()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = SearchCounters();
+    r.phases.clear();
+    for (ThreadCounters* counters : r.live) {
+        for (std::atomic<uint64_t>* counter :
+             { &counters->searches, &counters->expansions, &counters->pushes,
+               &counters->peakOpenSize, &counters->searchNanoseconds,
+               &counters->maxSearchNanoseconds }) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Writes phases, counters and cache statistics as JSON or CSV.
+ */
+bool Statistics::writeReport(const std::string& filePath, const PathCache::Stats* cache)
+{
+    const std::vector<std::pair<std::string, double>> phaseTimes = phases();
+    const SearchCounters search = counters();
+
+    std::vector<ReportValue> values;
+    if (COUNTERS_ENABLED) {
+        double searches = static_cast<double>(search.searches);
+        values.push_back({ "search", "searches", searches });
+        values.push_back({ "search", "expansions", static_cast<double>(search.expansions) });
+        values.push_back({ "search", "pushes", static_cast<double>(search.pushes) });
+        values.push_back({ "search", "peakOpenSize", static_cast<double>(search.peakOpenSize) });
+        values.push_back({ "search", "totalMs", search.searchNanoseconds / 1e6 });
+        values.push_back({ "search", "meanUs",
+                           searches > 0 ? search.searchNanoseconds / 1e3 / searches : 0.0 });
+        values.push_back({ "search", "maxUs", search.maxSearchNanoseconds / 1e3 });
+    }
+    if (cache) {
+        double lookups = static_cast<double>(cache->hits + cache->suffixHits + cache->misses);
+        values.push_back({ "pathCache", "hits", static_cast<double>(cache->hits) });
+        values.push_back({ "pathCache", "suffixHits", static_cast<double>(cache->suffixHits) });
+        values.push_back({ "pathCache", "misses", static_cast<double>(cache->misses) });
+        values.push_back({ "pathCache", "hitRate",
+                           lookups > 0 ? (cache->hits + cache->suffixHits) / lookups : 0.0 });
+        values.push_back({ "pathCache", "invalidations",
+                           static_cast<double>(cache->invalidations) });
+        values.push_back({ "pathCache", "evictions", static_cast<double>(cache->evictions) });
+    }
+
+    std::ofstream out(filePath);
+    if (!out) {
+        std::cerr << "Could not open file for writing: " << filePath << "\n";
+        return false;
+    }
+    out << std::setprecision(10);
+
+    const bool csv = filePath.size() >= 4 && filePath.compare(filePath.size() - 4, 4, ".csv") == 0;
+    if (csv) {
+        out << "section,name,value\n";
+        for (const auto& phase : phaseTimes) {
+            out << "phaseMs," << phase.first << "," << phase.second << "\n";
+        }
+        for (const ReportValue& v : values) {
+            out << v.section << "," << v.name << "," << v.value << "\n";
+        }
+    } else {
+        out << "{\n  \"searchCounters\": " << (COUNTERS_ENABLED ? "true" : "false")
+            << ",\n  \"phaseMs\": {";
+        for (size_t i = 0; i < phaseTimes.size(); ++i) {
+            out << (i ? ", " : "") << "\"" << phaseTimes[i].first << "\": " << phaseTimes[i].second;
+        }
+        out << "}";
+        const char* section = nullptr;
+        for (const ReportValue& v : values) {
+            if (!section || std::string(section) != v.section) {
+                out << (section ? "}" : "") << ",\n  \"" << v.section << "\": {";
+                section = v.section;
+            } else {
+                out << ", ";
+            }
+            out << "\"" << v.name << "\": " << v.value;
+        }
+        out << (section ? "}" : "") << "\n}\n";
+    }
+
+    if (!out) {
+        std::cerr << "Failed to write statistics: " << filePath << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+/******************************************************************************
+ * File:    Statistics.h
+ *
+ * Overview:
+ *   This header declares the Statistics class, the process-wide surface for
+ *   search and phase measurements:
+ *   - Search counters: every Pathfinding::aStar query adds its SearchStats
+ *     (expansions, pushes, peak open-list size) and its duration to
+ *     counters of the calling thread. Each thread only writes its own
+ *     counters (relaxed atomic stores, no locked instructions), and
+ *     counters() sums them. The counters are compiled in only with
+ *     -DRTS_WITH_STATS; otherwise SearchRecord is empty and queries pay
+ *     nothing.
+ *   - Phase timers: ScopedTimer records how long a named phase (load,
+ *     plan, write, ...) took. They are always available, as a phase costs
+ *     two clock reads.
+ *   - writeReport(): both, plus optional path cache hit rates, as JSON or
+ *     CSV for scripts and dashboards.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "PathCache.h"
+#include "Pathfinding.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct SearchCounters
+ * @brief Search counters summed over threads.
+ */
+struct SearchCounters {
+    uint64_t searches = 0;             ///< aStar queries
+    uint64_t expansions = 0;           ///< Nodes expanded
+    uint64_t pushes = 0;               ///< Open-list pushes
+    uint64_t peakOpenSize = 0;         ///< Largest open list of any query
+    uint64_t searchNanoseconds = 0;    ///< Total query time
+    uint64_t maxSearchNanoseconds = 0; ///< Slowest query
+};
+
+/**
+ * @class Statistics
+ * @brief Static access to the search counters and phase timings.
+ */
+class Statistics {
+public:
+#ifdef RTS_WITH_STATS
+    static constexpr bool COUNTERS_ENABLED = true;
+#else
+    static constexpr bool COUNTERS_ENABLED = false;
+#endif
+
+    /**
+     * @brief Adds one query to the calling thread's counters.
+     */
+    static void recordSearch(const SearchStats& stats, uint64_t nanoseconds);
+
+    /**
+     * @return The counters of all threads, including finished ones. All
+     *         zero unless COUNTERS_ENABLED.
+     */
+    static SearchCounters counters();
+
+    /**
+     * @brief Records the duration of a phase; repeated phases add up.
+     */
+    static void recordPhase(const std::string& name, double milliseconds);
+
+    /**
+     * @return Phase names and milliseconds, in first-recorded order.
+     */
+    static std::vector<std::pair<std::string, double>> phases();
+
+    /**
+     * @brief Clears the counters and phases.
+     */
+    static void reset();
+
+    /**
+     * @brief Writes phases, counters and, if given, cache statistics.
+     *
+     * @param filePath Destination; CSV ("section,name,value" rows) if it
+     *                 ends in ".csv", else JSON.
+     * @param cache    Statistics of the path cache, or nullptr.
+     * @return         True on success; errors are reported on std::cerr.
+     */
+    static bool writeReport(const std::string& filePath, const PathCache::Stats* cache);
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Records the lifetime of the object as a phase of Statistics.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(std::string phase)
+        : name(std::move(phase)), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        Statistics::recordPhase(name, elapsed.count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @class SearchRecord
+ * @brief Times one search and adds its SearchStats to the counters when
+ *        it goes out of scope.
+ *
+ * Created first thing in a search entry point. If the caller passed no
+ * SearchStats, the record points stats at its own, so the search fills
+ * it either way. Compiles to nothing without RTS_WITH_STATS.
+ */
+#ifdef RTS_WITH_STATS
+class SearchRecord {
+public:
+    explicit SearchRecord(SearchStats*& stats)
+        : start(std::chrono::steady_clock::now()) {
+        if (!stats) {
+            stats = &local;
+        }
+        target = stats;
+    }
+    ~SearchRecord() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Statistics::recordSearch(*target, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    SearchRecord(const SearchRecord&) = delete;
+    SearchRecord& operator=(const SearchRecord&) = delete;
+
+private:
+    SearchStats local;
+    SearchStats* target;
+    std::chrono::steady_clock::time_point start;
+};
+#else
+class SearchRecord {
+public:
+    explicit SearchRecord(SearchStats*&) {}
+};
+#endif
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * File:    ThreadPool.cpp
+ *
+ * Overview:
+ *   Implementation of the ThreadPool class.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include "ThreadPool.h"
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param threadCount Number of workers; 0 means hardware concurrency.
+ */
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+    threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Stops and joins all workers.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+/**
+ * @return Hardware concurrency, or 1 if it cannot be determined.
+ */
+unsigned ThreadPool::defaultThreadCount()
+{
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+/**
+ * @brief Runs body(index, worker) for every index in [0, count) and waits.
+ *
+ * @param count Number of work items.
+ * @param body  Function invoked for each item.
+ */
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t, unsigned)>& body)
+{
+    if (count == 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    job = &body;
+    jobCount = count;
+    nextIndex.store(0, std::memory_order_relaxed);
+    busyWorkers = size();
+    ++jobGeneration;
+    wake.notify_all();
+
+    finished.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+/**
+ * @brief Main loop of each worker: wait for a job, drain it, report idle.
+ *
+ * @param worker Index of this worker.
+ */
+void ThreadPool::workerLoop(unsigned worker)
+{
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        const std::function<void(size_t, unsigned)>* body;
+        size_t count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = jobGeneration;
+            body = job;
+            count = jobCount;
+        }
+
+        // Claim items one at a time until the job is drained
+        for (size_t i = nextIndex.fetch_add(1, std::memory_order_relaxed);
+             i < count;
+             i = nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+            (*body)(i, worker);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            finished.notify_one();
+        }
+    }
+}
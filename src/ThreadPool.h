@@ -0,0 +1,85 @@
+#pragma once
+
+/******************************************************************************
+ * File:    ThreadPool.h
+ *
+ * Overview:
+ *   This header declares the ThreadPool class, a fixed set of worker threads
+ *   that run data-parallel loops. Work items are handed out dynamically
+ *   through an atomic counter, so uneven items (short and long searches)
+ *   still balance across workers.
+ *
+ * Author:  Tarun Trilokesh
+ * Date:    2026-10-14
+ ******************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ *
+ * @brief Fixed-size pool running one parallelFor() at a time.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threadCount Number of workers; 0 means hardware concurrency.
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    /**
+     * @brief Stops and joins all workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @return Number of worker threads.
+     */
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+    /**
+     * @brief Runs body(index, worker) for every index in [0, count) and waits
+     *        for completion.
+     *
+     * Each index is processed exactly once. The worker argument is in
+     * [0, size()) and identifies the calling thread, so per-worker scratch
+     * data can be indexed by it without locking.
+     *
+     * @param count Number of work items.
+     * @param body  Function invoked for each item.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t, unsigned)>& body);
+
+    /**
+     * @return Hardware concurrency, or 1 if it cannot be determined.
+     */
+    static unsigned defaultThreadCount();
+
+private:
+    // Main loop of each worker thread
+    void workerLoop(unsigned worker);
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;      // Signals a new job or shutdown
+    std::condition_variable finished;  // Signals that all workers went idle
+
+    const std::function<void(size_t, unsigned)>* job = nullptr;
+    size_t jobCount = 0;
+    std::atomic<size_t> nextIndex{0};
+    uint64_t jobGeneration = 0;  // Incremented for every parallelFor()
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+};
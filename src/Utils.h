@@ -6,6 +6,7 @@
  * Overview:
  *   This header file provides utility functions for:
  *     1) Generating a JSON string based on the updated Map data (generateJsonOutput).
+ *        The formatting itself lives in JsonWriter.
  *
  * Author:  Tarun Trilokesh
  * Date:    2025-06-04
@@ -14,6 +15,7 @@
 #include <string>
 #include <vector>
 #include "Map.h"
+#include "JsonWriter.h"
 
 
 /**
@@ -21,61 +23,20 @@
  * 
  * This function constructs a JSON-like string that represents the map's
  * grid data. The output format is similar to what Tiled uses, with a
- * "layers" array and a "tilesets" section.
+ * "layers" array and a "tilesets" section. To write a file, prefer
+ * writeMapJson(map, path), which streams with constant memory.
  * 
  * @param map   Reference to the Map object.
  * @param originalJson  Path to the original JSON file (not used in this function).
+ * @param format How tile values are printed.
  * @return A string containing the generated JSON output.
  */
 inline std::string generateJsonOutput(const Map& map, 
-                                      const std::string& /*originalJson*/) 
+                                      const std::string& /*originalJson*/,
+                                      TileNumberFormat format = TileNumberFormat::Fixed) 
 {
-    // Get width and height of the map
-    int w = map.getWidth();
-    int h = map.getHeight();
-
-    // Rebuild the data array as a comma-separated list
-    // Reserve space to optimize string appends
-    std::string dataArray;
-    dataArray.reserve((w * h * 2) + 100); 
-    for (int i = 0; i < w * h; ++i) {
-        dataArray += std::to_string(map.getCell(i / w, i % w));
-        if (i < (w * h - 1)) {
-            dataArray += ", ";
-        }
-    }
-
-    // Construct the output in a simple Tiled-like JSON format
-    std::string out = R"({
-  "layers": [
-    {
-      "name": "world",
-      "tileset": "MapEditor Tileset_woodland.png",
-      "data": [
-)";
-
-    // Insert our generated data array into the JSON
-    out += dataArray;
-    out += R"(
-      ]
-    }
-  ],
-  "tilesets": [
-    {
-      "name": "MapEditor Tileset_woodland.png",
-      "image": "MapEditor Tileset_woodland.png",
-      "imagewidth": 512,
-      "imageheight": 512,
-      "tilewidth": 32,
-      "tileheight": 32
-    }
-  ],
-  "canvas": {
-    "width": 1024,
-    "height": 1024
-  }
-}
-)";
-
+    std::string out;
+    JsonWriter writer(out);
+    writeMapJson(map, writer, format);
     return out;
 }
@@ -3,52 +3,126 @@
  *
  * Overview:
  *   This file is the entry point for the RTS Pathfinding Project.
- *   1) Load a map from JSON.
+ *   1) Load a map from JSON (or from a binary ".rtsmap" file, with its
+ *      landmark tables if it has any).
  *   2) Detect agents (start values 0.5, 0.6, 0.9) and goals (8.1, 8.4, 8.13).
  *   3) Each agent chooses its nearest goal. Multiple agents can share a goal.
- *   4) Plan A* paths for each agent (if no path is found, that agent remains idle).
+ *   4) Queue a path request per agent and run the simulation tick by tick:
+ *      each tick spends a fixed planning budget on time-sliced A* searches
+ *      (--budget-us N, --budget-expansions N), then moves every agent one
+ *      cell, waiting where another agent is in the way (--smooth walks
+ *      line-of-sight waypoints instead of the raw cells). Other engines plan
+ *      all paths up front. Agents without a path remain idle.
  *   5) Mark each agent's path in the map using the agent's start value.
- *   6) Step the agents in a collision-free manner, if desired.
+ *
+ *   Progress goes through the Logger (--log-level error|warning|info|debug,
+ *   --async-log to print from a background thread). --stats FILE writes the
+ *   phase timings and search counters (see Statistics) as JSON or CSV.
  *
  * Author:  Tarun Trilokesh
  * Date:    2025-06-04
  ******************************************************************************/
 
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
-#include <fstream>
+#include <string>
+#include <vector>
 #include "Map.h"
+#include "BinaryMap.h"
+#include "LandmarkTable.h"
 #include "Pathfinding.h"
-#include "Utils.h"
+#include "Pathfinder.h"
+#include "JsonWriter.h"
 #include "MultiUnitCoordinator.h"
+#include "Logger.h"
+#include "Statistics.h"
 
 int main(int argc, char* argv[]) {
-    std::cout << "RTS Pathfinding\n";
-
     // Parse Command-Line Arguments
     std::string inputFile  = "./data/single_unit_single_goal_test.json";   // default input
     std::string outputFile = "data/output_map.json";   // default output
+    PathfinderType engine  = PathfinderType::AStar;    // default search engine
+    TileNumberFormat tileFormat = TileNumberFormat::Fixed;  // "3.000000" like std::to_string
+    double budgetMicroseconds = 2000.0;                      // planning time per tick
+    size_t budgetExpansions = 0;                             // 0 = no expansion limit
+    bool smoothPaths = false;                                // store line-of-sight waypoints
+    std::string statsFile;                                   // empty = no statistics report
+    bool asyncLog = false;                                   // log from a background thread
+
+    // Flags may appear anywhere; the rest are positional
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--integer-tiles") {
+            tileFormat = TileNumberFormat::Integral;
+        } else if (arg == "--smooth") {
+            smoothPaths = true;
+        } else if (arg == "--async-log") {
+            asyncLog = true;
+        } else if (arg == "--stats" && i + 1 < argc) {
+            statsFile = argv[++i];
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            LogLevel level;
+            if (!Logger::parseLevel(argv[++i], level)) {
+                std::cerr << "Unknown log level: " << argv[i]
+                          << " (expected error, warning, info or debug)\n";
+                return 1;
+            }
+            Logger::setLevel(level);
+        } else if ((arg == "--budget-us" || arg == "--budget-expansions") && i + 1 < argc) {
+            double value = std::atof(argv[++i]);
+            if (value < 0) {
+                std::cerr << "Invalid " << arg << " value: " << argv[i] << "\n";
+                return 1;
+            }
+            if (arg == "--budget-us") {
+                budgetMicroseconds = value;
+            } else {
+                budgetExpansions = static_cast<size_t>(value);
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
 
-    if (argc > 1) {
-        inputFile = argv[1];
+    Logger::setAsync(asyncLog);
+    RTS_LOG(Info) << "RTS Pathfinding\n";
+
+    if (args.size() > 0) {
+        inputFile = args[0];
     }
-    if (argc > 2) {
-        outputFile = argv[2];
+    if (args.size() > 1) {
+        outputFile = args[1];
+    }
+    if (args.size() > 2 && !parsePathfinderType(args[2], engine)) {
+        std::cerr << "Unknown search engine: " << args[2]
+                  << " (expected astar, jps or hpa)\n";
+        return 1;
     }
 
     // Create a Map object and attempt to load JSON data from sample_map.json
+    // Binary maps may carry precomputed landmark tables for the A* heuristic
     Map map;
-    if (!map.loadFromJson(inputFile)) {
+    LandmarkTable landmarks;
+    bool loaded = false;
+    {
+        ScopedTimer timer("load");
+        loaded = BinaryMap::isBinaryMapPath(inputFile)
+                     ? BinaryMap::load(map, inputFile, &landmarks)
+                     : map.loadFromJson(inputFile);
+    }
+    if (!loaded) {
         std::cerr << "Failed to load map from file.\n";
         return 1;
     }
 
     // Print basic map information to confirm it loaded correctly
-    std::cout << "Map loaded successfully! "
-              << "Width = " << map.getWidth()
-              << ", Height = " << map.getHeight() << "\n";
+    RTS_LOG(Info) << "Map loaded successfully! "
+                  << "Width = " << map.getWidth()
+                  << ", Height = " << map.getHeight() << "\n";
 
-    std::cout << "Map data loaded successfully!\n";
+    RTS_LOG(Info) << "Map data loaded successfully!\n";
 
     /////////////////////// Search for a specific value (example: 0.5)
     // double searchValue = 0.5;
@@ -75,42 +149,70 @@ int main(int argc, char* argv[]) {
 
     // Create the multi-unit coordinator
     MultiUnitCoordinator coordinator(map);
+    coordinator.setPathfinder(engine);
+    coordinator.setPathSmoothing(smoothPaths);
+    if (landmarks.getCount() > 0) {
+        RTS_LOG(Info) << "Using " << landmarks.getCount() << " landmark table(s).\n";
+        coordinator.setLandmarks(&landmarks);
+    }
 
-    // Detect agent start positions and possible goals
-    coordinator.findStartsAndGoals();
-
-    // Assign each agent to its nearest goal (multiple agents can share)
-    coordinator.assignGoals();
+    // Detect agent start positions and possible goals, and assign each
+    // agent to its nearest goal (multiple agents can share)
+    {
+        ScopedTimer timer("assign");
+        coordinator.findStartsAndGoals();
+        coordinator.assignGoals();
+    }
 
-    // Compute A* paths for each agent
-    coordinator.planPaths();
+    // Request A* paths for each agent; they are searched during the ticks.
+    // Other engines plan everything at once
+    // Run the simulation until nothing moves or is being planned any more
+    // (searches of path requests run inside the ticks, so one phase)
+    const int MAX_TICKS = 100000;
+    int ticks = 0;
+    {
+        ScopedTimer timer("plan");
+        coordinator.setPlanningBudget(budgetMicroseconds, budgetExpansions);
+        if (engine == PathfinderType::AStar) {
+            coordinator.requestAllPaths();
+        } else {
+            coordinator.planPaths();
+        }
+        while (ticks < MAX_TICKS && coordinator.tick()) {
+            ++ticks;
+        }
+    }
+    RTS_LOG(Info) << "Simulated " << ticks << " tick(s); "
+                  << (coordinator.allArrived() ? "all agents arrived.\n"
+                                               : "some agents are still waiting.\n");
 
     // Mark each agent's path on the map using its start value
     // Agents with no path found won't mark anything.
     coordinator.markPathsOnMap();
 
     //Export or print the updated map if you want to see the markings
-    std::string updatedJson = generateJsonOutput(map, inputFile);
-    std::ofstream out(outputFile);
-    out << updatedJson;
-    out.close();
-    std::cout << "Wrote updated map with paths to data folder.\n";
-    
-
-    // Step the agents for a demonstration of collision-free movement
-    // const int MAX_STEPS = 50;
-    // for (int step = 0; step < MAX_STEPS; ++step) {
-    //     std::cout << "Step " << step << ":\n";
-    //     coordinator.printAgents();
-
-    //     coordinator.step(); // each agent attempts to move 1 step
-
-    //     if (coordinator.allArrived()) {
-    //         std::cout << "All agents that found paths have arrived.\n";
-    //         break;
-    //     }
-    // }
+    bool written = false;
+    {
+        ScopedTimer timer("write");
+        written = writeMapJson(map, outputFile, tileFormat);
+    }
+    if (!written) {
+        return 1;
+    }
+    RTS_LOG(Info) << "Wrote updated map with paths to data folder.\n";
+
+    if (!statsFile.empty()) {
+        const PathCache* cache = coordinator.getPathCache();
+        PathCache::Stats cacheStats;
+        if (cache) {
+            cacheStats = cache->getStats();
+        }
+        if (!Statistics::writeReport(statsFile, cache ? &cacheStats : nullptr)) {
+            return 1;
+        }
+    }
 
+    Logger::setAsync(false);
     return 0;
 }
  
\ No newline at end of file